@@ -1,9 +1,65 @@
 #include "InstanceProxyModel.h"
 #include "MultiMC.h"
 #include <BaseInstance.h>
+#include <settings/Setting.h>
 
 InstanceProxyModel::InstanceProxyModel(QObject *parent) : GroupedProxyModel(parent)
 {
+	auto setting = MMC->settings()->getSetting("InstSortMode");
+	m_sortByLastLaunch = setting->get().toString() == "LastLaunch";
+	connect(setting.get(), &Setting::SettingChanged, this, &InstanceProxyModel::sortModeChanged);
+}
+
+void InstanceProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+	if (this->sourceModel())
+	{
+		disconnect(this->sourceModel(), 0, this, 0);
+	}
+	forgetAll();
+	// connected before the base class connects, so changed keys are dropped before it re-sorts
+	if (sourceModel)
+	{
+		connect(sourceModel, &QAbstractItemModel::dataChanged, this, &InstanceProxyModel::sourceDataChanged);
+		connect(sourceModel, &QAbstractItemModel::rowsAboutToBeRemoved, this, &InstanceProxyModel::forgetRows);
+		connect(sourceModel, &QAbstractItemModel::modelAboutToBeReset, this, &InstanceProxyModel::forgetAll);
+	}
+	GroupedProxyModel::setSourceModel(sourceModel);
+}
+
+void InstanceProxyModel::sortModeChanged(const Setting &, QVariant value)
+{
+	m_sortByLastLaunch = value.toString() == "LastLaunch";
+}
+
+void InstanceProxyModel::forgetRows(const QModelIndex &parent, int first, int last)
+{
+	for (int row = first; row <= last; row++)
+	{
+		auto index = sourceModel()->index(row, 0, parent);
+		m_keys.erase(static_cast<BaseInstance *>(index.internalPointer()));
+	}
+}
+
+void InstanceProxyModel::sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+	forgetRows(topLeft.parent(), topLeft.row(), bottomRight.row());
+}
+
+void InstanceProxyModel::forgetAll()
+{
+	m_keys.clear();
+}
+
+const InstanceProxyModel::SortKey &InstanceProxyModel::sortKey(BaseInstance *instance) const
+{
+	auto iter = m_keys.find(instance);
+	if (iter == m_keys.end())
+	{
+		SortKey key{m_collator.sortKey(instance->name()), instance->lastLaunch()};
+		iter = m_keys.emplace(instance, key).first;
+	}
+	return iter->second;
 }
 
 bool InstanceProxyModel::subSortLessThan(const QModelIndex &left,
@@ -11,13 +67,14 @@ bool InstanceProxyModel::subSortLessThan(const QModelIndex &left,
 {
 	BaseInstance *pdataLeft = static_cast<BaseInstance *>(left.internalPointer());
 	BaseInstance *pdataRight = static_cast<BaseInstance *>(right.internalPointer());
-	QString sortMode = MMC->settings()->get("InstSortMode").toString();
-	if (sortMode == "LastLaunch")
+	auto &keyLeft = sortKey(pdataLeft);
+	auto &keyRight = sortKey(pdataRight);
+	if (m_sortByLastLaunch)
 	{
-		return pdataLeft->lastLaunch() > pdataRight->lastLaunch();
+		return keyLeft.lastLaunch > keyRight.lastLaunch;
 	}
 	else
 	{
-		return QString::localeAwareCompare(pdataLeft->name(), pdataRight->name()) < 0;
+		return keyLeft.name.compare(keyRight.name) < 0;
 	}
 }
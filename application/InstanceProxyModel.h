@@ -2,14 +2,40 @@
 
 #include "groupview/GroupedProxyModel.h"
 
+class BaseInstance;
+class Setting;
+
 /**
  * A proxy model that is responsible for sorting instances into groups
+ *
+ * Sort keys are computed once per instance and kept until the instance changes.
  */
 class InstanceProxyModel : public GroupedProxyModel
 {
+	Q_OBJECT
 public:
 	explicit InstanceProxyModel(QObject *parent = 0);
 
+	virtual void setSourceModel(QAbstractItemModel *sourceModel) override;
+
 protected:
 	virtual bool subSortLessThan(const QModelIndex &left, const QModelIndex &right) const;
+
+private slots:
+	void sortModeChanged(const Setting &setting, QVariant value);
+	void forgetRows(const QModelIndex &parent, int first, int last);
+	void sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+	void forgetAll();
+
+private:
+	struct SortKey
+	{
+		QCollatorSortKey name;
+		qint64 lastLaunch;
+	};
+	const SortKey &sortKey(BaseInstance *instance) const;
+
+private:
+	bool m_sortByLastLaunch = false;
+	mutable std::map<const BaseInstance *, SortKey> m_keys;
 };
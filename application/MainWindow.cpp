@@ -67,6 +67,7 @@
 #include <updater/DownloadTask.h>
 #include <updater/UpdateChecker.h>
 #include <DesktopServices.h>
+#include <StartupScheduler.h>
 
 #include "InstancePageProvider.h"
 #include "InstanceProxyModel.h"
@@ -472,6 +473,14 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new MainWindow
 
 	// model reset -> selection is invalid. All the instance pointers are wrong.
 	connect(MMC->instances().get(), &InstanceList::dataIsInvalid, this, &MainWindow::selectionBad);
+	// the last selected instance may only show up once the background discovery is done
+	connect(MMC->instances().get(), &InstanceList::discoveryFinished, this, [this]()
+	{
+		if (!m_selectedInstance)
+		{
+			setSelectedInstanceById(MMC->settings()->get("SelectedInstance").toString());
+		}
+	});
 
 	m_statusLeft = new QLabel(tr("No instance selected"), this);
 	m_statusRight = new ServerStatus(this);
@@ -518,54 +527,26 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new MainWindow
 	// Show initial account
 	activeAccountChanged();
 
-	auto accounts = MMC->accounts();
-
-	QList<CacheDownloadPtr> skin_dls;
-	for (int i = 0; i < accounts->count(); i++)
-	{
-		auto account = accounts->at(i);
-		if (!account)
-		{
-			qWarning() << "Null account at index" << i;
-			continue;
-		}
-		for (auto profile : account->profiles())
-		{
-			auto meta = Env::getInstance().metacache()->resolveEntry("skins", profile.id + ".png");
-			auto action = CacheDownload::make(QUrl("https://" + URLConstants::SKINS_BASE + profile.id + ".png"), meta);
-			skin_dls.append(action);
-			meta->stale = true;
-		}
-	}
-	if (!skin_dls.isEmpty())
-	{
-		auto job = new NetJob("Startup player skins download");
-		connect(job, &NetJob::succeeded, this, &MainWindow::skinJobFinished);
-		connect(job, &NetJob::failed, this, &MainWindow::skinJobFinished);
-		for (auto action : skin_dls)
-		{
-			job->addNetAction(action);
-		}
-		skin_download_job.reset(job);
-		job->start();
-	}
-
-	// run the things that load and download other things... FIXME: this is NOT the place
+	// run the things that load and download other things once the window is up
 	// FIXME: invisible actions in the background = NOPE.
+	auto startup = MMC->startup();
+	startup->defer("player skins download", StartupScheduler::High, this, [this]()
+	{
+		downloadSkins();
+	});
+	startup->defer("Minecraft version list", StartupScheduler::High, this, [this]()
 	{
 		if (!MMC->minecraftlist()->isLoaded())
 		{
 			m_versionLoadTask = MMC->minecraftlist()->getLoadTask();
 			startTask(m_versionLoadTask);
 		}
-		if (!MMC->lwjgllist()->isLoaded())
-		{
-			MMC->lwjgllist()->loadList();
-		}
-
+	});
+	startup->defer("news", StartupScheduler::Normal, this, [this]()
+	{
 		m_newsChecker->reloadNews();
 		updateNewsLabel();
-	}
+	});
 
 	if(BuildConfig.UPDATER_ENABLED)
 	{
@@ -576,7 +557,10 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new MainWindow
 		// if automatic update checks are allowed, start one.
 		if (MMC->settings()->get("AutoUpdate").toBool())
 		{
-			updater->checkForUpdate(MMC->settings()->get("UpdateChannel").toString(), false);
+			startup->defer("update check", StartupScheduler::Normal, this, [updater]()
+			{
+				updater->checkForUpdate(MMC->settings()->get("UpdateChannel").toString(), false);
+			});
 		}
 	}
 
@@ -588,9 +572,20 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new MainWindow
 		checker->setApplicationFullVersion(BuildConfig.FULL_VERSION_STR);
 		m_notificationChecker.reset(checker);
 		connect(m_notificationChecker.get(), &NotificationChecker::notificationCheckFinished, this, &MainWindow::notificationsChanged);
-		checker->checkForNotifications();
+		startup->defer("notifications", StartupScheduler::Normal, this, [checker]()
+		{
+			checker->checkForNotifications();
+		});
 	}
 
+	startup->defer("LWJGL version list", StartupScheduler::Low, this, []()
+	{
+		if (!MMC->lwjgllist()->isLoaded())
+		{
+			MMC->lwjgllist()->loadList();
+		}
+	});
+
 	setSelectedInstanceById(MMC->settings()->get("SelectedInstance").toString());
 
 	// removing this looks stupid
@@ -601,8 +596,49 @@ MainWindow::~MainWindow()
 {
 }
 
+void MainWindow::downloadSkins()
+{
+	auto accounts = MMC->accounts();
+
+	QList<CacheDownloadPtr> skin_dls;
+	for (int i = 0; i < accounts->count(); i++)
+	{
+		auto account = accounts->at(i);
+		if (!account)
+		{
+			qWarning() << "Null account at index" << i;
+			continue;
+		}
+		for (auto profile : account->profiles())
+		{
+			auto meta = Env::getInstance().metacache()->resolveEntry("skins", profile.id + ".png");
+			// recently confirmed skins are trusted, the rest is revalidated with the server
+			if (!meta->stale && !meta->isOlderThan(SkinUtils::revalidateInterval))
+			{
+				continue;
+			}
+			auto action = CacheDownload::make(QUrl("https://" + URLConstants::SKINS_BASE + profile.id + ".png"), meta);
+			skin_dls.append(action);
+			meta->stale = true;
+		}
+	}
+	if (!skin_dls.isEmpty())
+	{
+		auto job = new NetJob("Startup player skins download");
+		connect(job, &NetJob::succeeded, this, &MainWindow::skinJobFinished);
+		connect(job, &NetJob::failed, this, &MainWindow::skinJobFinished);
+		for (auto action : skin_dls)
+		{
+			job->addNetAction(action);
+		}
+		skin_download_job.reset(job);
+		job->start();
+	}
+}
+
 void MainWindow::skinJobFinished()
 {
+	SkinUtils::invalidateFaces();
 	activeAccountChanged();
 	skin_download_job.reset();
 }
@@ -822,6 +858,14 @@ bool MainWindow::eventFilter(QObject *obj, QEvent *ev)
 {
 	if (obj == view)
 	{
+		// the instance list is what the user waits for. It is painted right after this, and
+		// deferred work only starts once the event loop is idle again.
+		if (ev->type() == QEvent::Paint && !MMC->startup()->isCriticalPathDone())
+		{
+			auto startup = MMC->startup();
+			startup->phaseDone("main window");
+			startup->criticalPathDone();
+		}
 		if (ev->type() == QEvent::KeyPress)
 		{
 			QKeyEvent *keyEvent = static_cast<QKeyEvent *>(ev);
@@ -126,6 +126,8 @@ private slots:
 
 	void updateToolsMenu();
 
+	void downloadSkins();
+
 	void skinJobFinished();
 
 	void instanceActivated(QModelIndex);
@@ -192,5 +194,5 @@ private:
 	QString m_currentInstIcon;
 
 	// managed by the application object
-	Task *m_versionLoadTask;
+	Task *m_versionLoadTask = nullptr;
 };
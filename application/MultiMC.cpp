@@ -18,6 +18,7 @@
 #include <QMessageBox>
 #include <QStringList>
 #include <QDebug>
+#include <QLoggingCategory>
 
 #include "InstanceList.h"
 #include <minecraft/auth/MojangAccountList.h>
@@ -31,6 +32,8 @@
 #include "net/HttpMetaCache.h"
 #include "net/URLConstants.h"
 #include "Env.h"
+#include "AsyncLogWriter.h"
+#include "StartupScheduler.h"
 
 #include "java/JavaUtils.h"
 
@@ -50,6 +53,8 @@
 #include "handlers/WebResourceHandler.h"
 
 #include "minecraft/ftb/FTBPlugin.h"
+#include "minecraft/ModStore.h"
+#include "Trash.h"
 
 #include <Commandline.h>
 #include <FileSystem.h>
@@ -63,6 +68,8 @@ MultiMC::MultiMC(int &argc, char **argv, bool test_mode) : QApplication(argc, ar
 	setApplicationName("MultiMC5");
 
 	startTime = QDateTime::currentDateTime();
+	m_startup.reset(new StartupScheduler());
+	m_startup->setMaxHoldBack(maxStartupHoldBack);
 
 	setAttribute(Qt::AA_UseHighDpiPixmaps);
 	// Don't quit on hiding the last window
@@ -190,12 +197,16 @@ MultiMC::MultiMC(int &argc, char **argv, bool test_mode) : QApplication(argc, ar
 	}
 	qDebug() << "Binary path                : " << binPath;
 	qDebug() << "Application root path      : " << rootPath;
+	m_startup->phaseDone("paths and logging");
 
 	// load settings
 	initGlobalSettings(test_mode);
+	applyLogSettings();
+	m_startup->phaseDone("settings");
 
 	// load translations
 	initTranslations();
+	m_startup->phaseDone("translations");
 
 	// initialize the updater
 	if(BuildConfig.UPDATER_ENABLED)
@@ -207,6 +218,7 @@ MultiMC::MultiMC(int &argc, char **argv, bool test_mode) : QApplication(argc, ar
 
 	// load icons
 	initIcons();
+	m_startup->phaseDone("icons");
 
 	// and instances
 	auto InstDirSetting = m_settings->getSetting("InstanceDir");
@@ -224,15 +236,24 @@ MultiMC::MultiMC(int &argc, char **argv, bool test_mode) : QApplication(argc, ar
 	m_instances->loadList();
 	connect(InstDirSetting.get(), SIGNAL(SettingChanged(const Setting &, QVariant)),
 			m_instances.get(), SLOT(on_InstFolderChanged(const Setting &, QVariant)));
+	m_startup->phaseDone(QString("instances (%1)").arg(m_instances->count()));
 
 	// and accounts
 	m_accounts.reset(new MojangAccountList(this));
 	qDebug() << "Loading accounts...";
 	m_accounts->setListFilePath("accounts.json", true);
 	m_accounts->loadList();
+	m_startup->phaseDone("accounts");
 
-	// init the http meta cache
+	// init the http meta cache and the java probe cache
 	ENV.initHttpMetaCache();
+	ENV.initJavaProbeCache();
+
+	// share mod files between instances, if asked to
+	if (m_settings->get("UseModStore").toBool())
+	{
+		ENV.initModStore("modstore");
+	}
 
 	// create the global network manager
 	ENV.m_qnam.reset(new QNetworkAccessManager(this));
@@ -248,8 +269,50 @@ MultiMC::MultiMC(int &argc, char **argv, bool test_mode) : QApplication(argc, ar
 	}
 
 	initSSL();
+	m_startup->phaseDone("network");
 
-	m_translationChecker->downloadTranslations();
+	// instances deleted while the last run was still cleaning up. FTB instances have their trash in the FTB folder
+	QStringList trashFolders = {instDir};
+	auto ftbRoot = m_settings->get("FTBRoot").toString();
+	if (m_settings->get("TrackFTBInstances").toBool() && !ftbRoot.isEmpty())
+	{
+		trashFolders.append(ftbRoot);
+	}
+	m_startup->defer("trash cleanup", StartupScheduler::Low, this, [trashFolders]()
+	{
+		for (auto &folder : trashFolders)
+		{
+			Trash::resume(folder);
+		}
+	});
+
+	// link the mods of existing instances into the store and drop what nothing uses
+	if (auto store = ENV.modStore())
+	{
+		auto instances = m_instances;
+		m_startup->defer("mod store upkeep", StartupScheduler::Low, this, [store, instances]()
+		{
+			QStringList roots;
+			for (int i = 0; i < instances->count(); i++)
+			{
+				roots.append(instances->at(i)->instanceRoot());
+			}
+			ModStore::maintainInBackground(store, roots);
+		});
+	}
+
+	// keep the access tokens fresh, so launching doesn't wait for the auth server
+	auto accounts = m_accounts;
+	m_startup->defer("account token refresh", StartupScheduler::Normal, this, [accounts]()
+	{
+		accounts->setAutoRefresh(true);
+	});
+
+	auto translationChecker = m_translationChecker;
+	m_startup->defer("translations download", StartupScheduler::Low, this, [translationChecker]()
+	{
+		translationChecker->downloadTranslations();
+	});
 
 	//FIXME: what to do with these?
 	m_profilers.insert("jprofiler",
@@ -269,6 +332,7 @@ MultiMC::MultiMC(int &argc, char **argv, bool test_mode) : QApplication(argc, ar
 	}
 
 	connect(this, SIGNAL(aboutToQuit()), SLOT(onExit()));
+	m_startup->phaseDone("tools");
 	m_status = MultiMC::Initialized;
 }
 
@@ -373,22 +437,17 @@ void moveFile(const QString &oldName, const QString &newName)
 
 void appDebugOutput(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
-	const char *levels = "DWCF";
-	const QString format("%1 %2 %3\n");
-
-	qint64 msecstotal = MMC->timeSinceStart();
-	qint64 seconds = msecstotal / 1000;
-	qint64 msecs = msecstotal % 1000;
-	QString foo;
-	char buf[1025] = {0};
-	::snprintf(buf, 1024, "%5lld.%03lld", seconds, msecs);
-
-	QString out = format.arg(buf).arg(levels[type]).arg(msg);
-
-	MMC->logFile->write(out.toUtf8());
-	MMC->logFile->flush();
-	QTextStream(stderr) << out.toLocal8Bit();
-	fflush(stderr);
+	auto logger = MMC->logger;
+	if(!logger->accepts(type))
+	{
+		return;
+	}
+	logger->post(type, MMC->timeSinceStart(), msg);
+	if(type == QtFatalMsg)
+	{
+		// we're about to abort, nothing may stay in the queue
+		logger->flush();
+	}
 }
 
 void MultiMC::initLogger()
@@ -400,10 +459,25 @@ void MultiMC::initLogger()
 	moveFile(logBase.arg(1), logBase.arg(2));
 	moveFile(logBase.arg(0), logBase.arg(1));
 
-	qInstallMessageHandler(appDebugOutput);
-
 	logFile = std::make_shared<QFile>(logBase.arg(0));
 	logFile->open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate);
+
+	logger = std::make_shared<AsyncLogWriter>(logFile, true);
+	logger->start(QThread::LowPriority);
+
+	qInstallMessageHandler(appDebugOutput);
+}
+
+void MultiMC::applyLogSettings()
+{
+	auto level = AsyncLogWriter::levelFromString(m_settings->get("LogMinimumLevel").toString(), QtDebugMsg);
+	logger->setMinimumLevel(level);
+	// same syntax as QT_LOGGING_RULES, with ';' separating the rules
+	auto rules = m_settings->get("LogFilterRules").toString();
+	if(!rules.isEmpty())
+	{
+		QLoggingCategory::setFilterRules(rules.replace(';', '\n'));
+	}
 }
 
 void MultiMC::initGlobalSettings(bool test_mode)
@@ -453,6 +527,10 @@ void MultiMC::initGlobalSettings(bool test_mode)
 	m_settings->registerSetting("ConsoleMaxLines", 100000);
 	m_settings->registerSetting("ConsoleOverflowStop", true);
 
+	// Logging
+	m_settings->registerSetting("LogMinimumLevel", QString("debug"));
+	m_settings->registerSetting("LogFilterRules", QString());
+
 	FTBPlugin::initialize(m_settings);
 
 	// Folders
@@ -472,6 +550,7 @@ void MultiMC::initGlobalSettings(bool test_mode)
 	m_settings->registerSetting("RaiseConsole", true);
 	m_settings->registerSetting("AutoCloseConsole", true);
 	m_settings->registerSetting("LogPrePostOutput", true);
+	m_settings->registerSetting("SaveLaunchTrace", false);
 
 	// Console Colors
 	//	m_settings->registerSetting("SysMessageColor", QColor(Qt::blue));
@@ -502,6 +581,10 @@ void MultiMC::initGlobalSettings(bool test_mode)
 	m_settings->registerSetting("LastHostname", "");
 	m_settings->registerSetting("JavaDetectionHack", "");
 	m_settings->registerSetting("JvmArgs", "");
+	m_settings->registerSetting("JavaClassDataSharing", false);
+
+	// Keep one copy of each mod, shared by all instances
+	m_settings->registerSetting("UseModStore", false);
 
 	// Wrapper command for launch
 	m_settings->registerSetting("WrapperCommand", "");
@@ -926,7 +1009,17 @@ void MultiMC::onExit()
 	{
 		m_instances->saveGroupList();
 	}
+	// background jobs hold up the exit until they return
+	if(auto store = ENV.modStore())
+	{
+		store->stopMaintenance();
+	}
+	Trash::stop();
 	ENV.destroy();
+	if(logger)
+	{
+		logger->stop();
+	}
 	if(logFile)
 	{
 		logFile->flush();
@@ -25,6 +25,8 @@ class UpdateChecker;
 class BaseProfilerFactory;
 class BaseDetachedToolFactory;
 class TranslationDownloader;
+class AsyncLogWriter;
+class StartupScheduler;
 
 #if defined(MMC)
 #undef MMC
@@ -81,6 +83,12 @@ public:
 	std::shared_ptr<LiteLoaderVersionList> liteloaderlist();
 	std::shared_ptr<JavaInstallList> javalist();
 
+	// APPLICATION ONLY
+	std::shared_ptr<StartupScheduler> startup()
+	{
+		return m_startup;
+	}
+
 	// APPLICATION ONLY
 	std::shared_ptr<InstanceList> instances()
 	{
@@ -139,6 +147,7 @@ private slots:
 
 private:
 	void initLogger();
+	void applyLogSettings();
 	void initIcons();
 	void initGlobalSettings(bool test_mode);
 	void initTranslations();
@@ -149,6 +158,9 @@ private:
 	friend class DownloadTaskTest;
 
 	QDateTime startTime;
+	/// milliseconds from start after which deferred work starts, even if the main window isn't painted yet
+	static const int maxStartupHoldBack = 5000;
+	std::shared_ptr<StartupScheduler> m_startup;
 
 	std::shared_ptr<QTranslator> m_qt_translator;
 	std::shared_ptr<QTranslator> m_mmc_translator;
@@ -173,4 +185,5 @@ private:
 public:
 	QString launchId;
 	std::shared_ptr<QFile> logFile;
+	std::shared_ptr<AsyncLogWriter> logger;
 };
@@ -13,54 +13,133 @@ public:
 		m_parent = parent;
 	}
 
-	bool filterAcceptsRow(int source_row, const QModelIndex &source_parent) const
+	void setSourceModel(QAbstractItemModel *model) override
+	{
+		for (auto &connection: m_sourceConnections)
+		{
+			disconnect(connection);
+		}
+		m_sourceConnections.clear();
+		clearCache();
+		// connect before QSortFilterProxyModel does, so the cache is cleared before it refilters
+		if(model)
+		{
+			m_sourceConnections
+				<< connect(model, &QAbstractItemModel::modelAboutToBeReset, this, &VersionFilterModel::clearCache)
+				<< connect(model, &QAbstractItemModel::rowsAboutToBeInserted, this, &VersionFilterModel::clearCache)
+				<< connect(model, &QAbstractItemModel::rowsAboutToBeRemoved, this, &VersionFilterModel::clearCache)
+				<< connect(model, &QAbstractItemModel::layoutAboutToBeChanged, this, &VersionFilterModel::clearCache)
+				<< connect(model, &QAbstractItemModel::dataChanged, this, &VersionFilterModel::clearCache);
+		}
+		QSortFilterProxyModel::setSourceModel(model);
+	}
+
+	/// Compile the filters of the parent model and refilter
+	void compileFilters()
 	{
+		m_compiled.clear();
 		const auto &filters = m_parent->filters();
 		for (auto it = filters.begin(); it != filters.end(); ++it)
 		{
-			auto role = it.key();
-			auto idx = sourceModel()->index(source_row, 0, source_parent);
-			auto data = sourceModel()->data(idx, role);
-
-			switch(role)
+			CompiledFilter compiled;
+			compiled.role = it.key();
+			compiled.exact = it.value().exact;
+			compiled.string = it.value().string;
+			switch(compiled.role)
 			{
 				case BaseVersionList::ParentGameVersionRole:
+					compiled.keyRole = BaseVersionList::ParentGameVersionKeyRole;
+					break;
 				case BaseVersionList::VersionIdRole:
+					compiled.keyRole = BaseVersionList::VersionKeyRole;
+					break;
+				default:
+					break;
+			}
+			if(!compiled.exact && compiled.keyRole != -1)
+			{
+				compiled.interval = VersionInterval(compiled.string);
+			}
+			m_compiled.append(compiled);
+		}
+		clearCache();
+		invalidateFilter();
+	}
+
+	bool filterAcceptsRow(int source_row, const QModelIndex &source_parent) const
+	{
+		if(source_parent.isValid())
+		{
+			return evaluate(source_row, source_parent);
+		}
+		if(m_acceptCache.size() != sourceModel()->rowCount(source_parent))
+		{
+			m_acceptCache.fill(Unknown, sourceModel()->rowCount(source_parent));
+		}
+		auto &cached = m_acceptCache[source_row];
+		if(cached == Unknown)
+		{
+			cached = evaluate(source_row, source_parent) ? Accepted : Rejected;
+		}
+		return cached == Accepted;
+	}
+
+private slots:
+	void clearCache()
+	{
+		m_acceptCache.clear();
+	}
+
+private:
+	struct CompiledFilter
+	{
+		int role = -1;
+		// role providing the pre-parsed version for interval matching, -1 if not a version role
+		int keyRole = -1;
+		bool exact = false;
+		QString string;
+		VersionInterval interval;
+	};
+	enum CacheState : char
+	{
+		Unknown,
+		Accepted,
+		Rejected
+	};
+
+	bool evaluate(int source_row, const QModelIndex &source_parent) const
+	{
+		auto idx = sourceModel()->index(source_row, 0, source_parent);
+		for (const auto &filter: m_compiled)
+		{
+			if(filter.exact)
+			{
+				if (sourceModel()->data(idx, filter.role).toString() != filter.string)
 				{
-					auto versionString = data.toString();
-					if(it.value().exact)
-					{
-						if (versionString != it.value().string)
-						{
-							return false;
-						}
-					}
-					else if (!versionIsInInterval(versionString, it.value().string))
-					{
-						return false;
-					}
+					return false;
 				}
-				default:
+			}
+			else if(filter.keyRole != -1)
+			{
+				auto key = sourceModel()->data(idx, filter.keyRole).value<Version>();
+				if (!filter.interval.contains(key))
 				{
-					auto match = data.toString();
-					if(it.value().exact)
-					{
-						if (match != it.value().string)
-						{
-							return false;
-						}
-					}
-					else if (match.contains(it.value().string))
-					{
-						return false;
-					}
+					return false;
 				}
 			}
+			else if (!sourceModel()->data(idx, filter.role).toString().contains(filter.string))
+			{
+				return false;
+			}
 		}
 		return true;
 	}
-private:
+
 	VersionProxyModel *m_parent;
+	QList<QMetaObject::Connection> m_sourceConnections;
+	QList<CompiledFilter> m_compiled;
+	// filter results by source row, valid until the filters or the source rows change
+	mutable QVector<CacheState> m_acceptCache;
 };
 
 VersionProxyModel::VersionProxyModel(QObject *parent) : QAbstractProxyModel(parent)
@@ -383,7 +462,7 @@ QModelIndex VersionProxyModel::getRecommended() const
 void VersionProxyModel::clearFilters()
 {
 	m_filters.clear();
-	filterModel->invalidate();
+	filterModel->compileFilters();
 }
 
 void VersionProxyModel::setFilter(const BaseVersionList::ModelRoles column, const QString &filter, const bool exact)
@@ -392,7 +471,7 @@ void VersionProxyModel::setFilter(const BaseVersionList::ModelRoles column, cons
 	f.string = filter;
 	f.exact = exact;
 	m_filters[column] = f;
-	filterModel->invalidate();
+	filterModel->compileFilters();
 }
 
 const VersionProxyModel::FilterMap &VersionProxyModel::filters() const
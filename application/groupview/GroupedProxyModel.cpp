@@ -7,6 +7,16 @@ GroupedProxyModel::GroupedProxyModel(QObject *parent) : QSortFilterProxyModel(pa
 {
 }
 
+const QCollatorSortKey &GroupedProxyModel::groupKey(const QString &group) const
+{
+	auto iter = m_groupKeys.find(group);
+	if (iter == m_groupKeys.end())
+	{
+		iter = m_groupKeys.emplace(group, m_collator.sortKey(group)).first;
+	}
+	return iter->second;
+}
+
 bool GroupedProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
 {
 	const QString leftCategory = left.data(GroupViewRoles::GroupRole).toString();
@@ -18,7 +28,7 @@ bool GroupedProxyModel::lessThan(const QModelIndex &left, const QModelIndex &rig
 	else
 	{
 		// FIXME: real group sorting happens in GroupView::updateGeometries(), see LocaleString
-		auto result = leftCategory.localeAwareCompare(rightCategory);
+		auto result = groupKey(leftCategory).compare(groupKey(rightCategory));
 		if(result == 0)
 		{
 			return subSortLessThan(left, right);
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <QSortFilterProxyModel>
+#include <QCollator>
+#include <map>
 
 class GroupedProxyModel : public QSortFilterProxyModel
 {
@@ -12,4 +14,12 @@ public:
 protected:
 	virtual bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
 	virtual bool subSortLessThan(const QModelIndex &left, const QModelIndex &right) const;
+
+	/// collator shared by the sort keys of this and derived models
+	QCollator m_collator;
+
+private:
+	/// collation keys of the group names seen so far. QCollatorSortKey has no default constructor.
+	mutable std::map<QString, QCollatorSortKey> m_groupKeys;
+	const QCollatorSortKey &groupKey(const QString &group) const;
 };
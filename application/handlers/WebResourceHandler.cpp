@@ -6,6 +6,9 @@
 #include "FileSystem.h"
 #include "Env.h"
 
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
+
 //FIXME: wrong. needs to be done elsewhere.
 QMap<QString, NetJob *> WebResourceHandler::m_activeDownloads;
 
@@ -57,12 +60,31 @@ void WebResourceHandler::progress(qint64 current, qint64 total)
 
 void WebResourceHandler::setResultFromFile(const QString &file)
 {
-	try
+	// reading happens on the thread pool, so that views with lots of web resources don't block on disk access
+	using ReadResult = QPair<QByteArray, QString>;
+	auto watcher = new QFutureWatcher<ReadResult>(this);
+	connect(watcher, &QFutureWatcher<ReadResult>::finished, this, [this, watcher]()
 	{
-		setResult(FS::read(file));
-	}
-	catch (Exception &e)
+		const ReadResult result = watcher->result();
+		watcher->deleteLater();
+		if (result.second.isNull())
+		{
+			setResult(result.first);
+		}
+		else
+		{
+			setFailure(result.second);
+		}
+	});
+	watcher->setFuture(QtConcurrent::run([file]() -> ReadResult
 	{
-		setFailure(e.cause());
-	}
+		try
+		{
+			return qMakePair(FS::read(file), QString());
+		}
+		catch (Exception &e)
+		{
+			return qMakePair(QByteArray(), e.cause());
+		}
+	}));
 }
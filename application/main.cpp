@@ -2,6 +2,7 @@
 #include "MainWindow.h"
 #include "LaunchInteraction.h"
 #include <InstanceList.h>
+#include <StartupScheduler.h>
 #include <QDebug>
 
 int launchMainWindow(MultiMC &app)
@@ -18,6 +19,8 @@ int launchMainWindow(MultiMC &app)
 int launchInstance(MultiMC &app, InstancePtr inst)
 {
 	app.minecraftlist();
+	// there is no main window to wait for
+	app.startup()->criticalPathDone();
 	LaunchController launchController;
 	launchController.setInstance(inst);
 	launchController.setOnline(true);
@@ -34,6 +37,12 @@ int main_gui(MultiMC &app)
 	app.setIconTheme(MMC->settings()->get("IconTheme").toString());
 	// show main window
 	auto inst = app.instances()->getInstanceById(app.launchId);
+	if(!inst && !app.launchId.isEmpty())
+	{
+		// it may be one of the instances that are still being looked for
+		app.instances()->waitForDiscovery();
+		inst = app.instances()->getInstanceById(app.launchId);
+	}
 	if(inst)
 	{
 		return launchInstance(app, inst);
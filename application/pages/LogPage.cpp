@@ -11,6 +11,7 @@
 #include <settings/Setting.h>
 #include "GuiUtil.h"
 #include <ColorCache.h>
+#include "widgets/ProcessGraph.h"
 
 LogPage::LogPage(std::shared_ptr<LaunchTask> proc, QWidget *parent)
 	: QWidget(parent), ui(new Ui::LogPage), m_process(proc)
@@ -20,6 +21,12 @@ LogPage::LogPage(std::shared_ptr<LaunchTask> proc, QWidget *parent)
 	connect(m_process.get(), SIGNAL(log(QString, MessageLevel::Enum)), this,
 			SLOT(write(QString, MessageLevel::Enum)));
 
+	// resource usage of the game, next to the 'Keep updating' checkbox
+	if(ProcessSampler::isSupported())
+	{
+		ui->horizontalLayout->insertWidget(1, new ProcessGraph(&m_process->sampler(), this));
+	}
+
 	// create the format and set its font
 	defaultFormat = new QTextCharFormat(ui->text->currentCharFormat());
 	QString fontFamily = MMC->settings()->get("ConsoleFont").toString();
@@ -20,21 +20,48 @@
 
 #include "GuiUtil.h"
 #include "RecursiveFileSystemWatcher.h"
-#include <GZip.h>
+#include "IndexedLogFile.h"
+#include "LogFileModel.h"
+#include "LogSearch.h"
 #include <FileSystem.h>
+#include <QListWidgetItem>
+#include <QTimer>
+#include <algorithm>
+
+namespace
+{
+/// uploading more than this is pointless
+const qint64 maxPasteSize = 1024ll * 1024ll * 12ll;
+/// copying more than this into the clipboard is not going to end well
+const qint64 maxCopySize = 50000000ll;
+}
 
 OtherLogsPage::OtherLogsPage(QString path, IPathMatcher::Ptr fileFilter, QWidget *parent)
 	: QWidget(parent), ui(new Ui::OtherLogsPage), m_path(path), m_fileFilter(fileFilter),
-	  m_watcher(new RecursiveFileSystemWatcher(this))
+	  m_watcher(new RecursiveFileSystemWatcher(this)), m_model(new LogFileModel(this)),
+	  m_searchDelay(new QTimer(this))
 {
 	ui->setupUi(this);
 	ui->tabWidget->tabBar()->hide();
+	ui->logView->setModel(m_model);
+	bool conversionOk = false;
+	int fontSize = MMC->settings()->get("ConsoleFontSize").toInt(&conversionOk);
+	if(!conversionOk)
+	{
+		fontSize = 11;
+	}
+	ui->logView->setFont(QFont(MMC->settings()->get("ConsoleFont").toString(), fontSize));
+	ui->searchResults->setVisible(false);
 
 	m_watcher->setMatcher(fileFilter);
 	m_watcher->setRootDir(QDir::current().absoluteFilePath(m_path));
 
 	connect(m_watcher, &RecursiveFileSystemWatcher::filesChanged, this, &OtherLogsPage::populateSelectLogBox);
 	populateSelectLogBox();
+
+	m_searchDelay->setSingleShot(true);
+	m_searchDelay->setInterval(250);
+	connect(m_searchDelay, &QTimer::timeout, this, &OtherLogsPage::searchAsYouType);
 }
 
 OtherLogsPage::~OtherLogsPage()
@@ -53,26 +80,18 @@ void OtherLogsPage::closed()
 
 void OtherLogsPage::populateSelectLogBox()
 {
+	// keep showing the current file if it is still there, without loading it again
+	const auto current = m_currentFile;
+	ui->selectLogBox->blockSignals(true);
 	ui->selectLogBox->clear();
 	ui->selectLogBox->addItems(m_watcher->files());
-	if (m_currentFile.isEmpty())
-	{
-		setControlsEnabled(false);
-		ui->selectLogBox->setCurrentIndex(-1);
-	}
-	else
+	ui->selectLogBox->setCurrentIndex(current.isEmpty() ? -1 : ui->selectLogBox->findText(current));
+	ui->selectLogBox->blockSignals(false);
+	if (!current.isEmpty() && ui->selectLogBox->currentIndex() == -1)
 	{
-		const int index = ui->selectLogBox->findText(m_currentFile);
-		if (index != -1)
-		{
-			ui->selectLogBox->setCurrentIndex(index);
-			setControlsEnabled(true);
-		}
-		else
-		{
-			setControlsEnabled(false);
-		}
+		on_selectLogBox_currentIndexChanged(-1);
 	}
+	setControlsEnabled(!m_currentFile.isEmpty());
 }
 
 void OtherLogsPage::on_selectLogBox_currentIndexChanged(const int index)
@@ -86,7 +105,7 @@ void OtherLogsPage::on_selectLogBox_currentIndexChanged(const int index)
 	if (file.isEmpty() || !QFile::exists(FS::PathCombine(m_path, file)))
 	{
 		m_currentFile = QString();
-		ui->text->clear();
+		releaseFile();
 		setControlsEnabled(false);
 	}
 	else
@@ -104,61 +123,246 @@ void OtherLogsPage::on_btnReload_clicked()
 		setControlsEnabled(false);
 		return;
 	}
-	QFile file(FS::PathCombine(m_path, m_currentFile));
-	if (!file.open(QFile::ReadOnly))
+	auto file = std::make_shared<IndexedLogFile>(FS::PathCombine(m_path, m_currentFile));
+	m_model->setFile(file);
+	// after the model, so it already has the rows when we get to them
+	connect(file.get(), &IndexedLogFile::linesAdded, this, &OtherLogsPage::logLinesAdded);
+	connect(file.get(), &IndexedLogFile::finished, this, &OtherLogsPage::logFinished);
+	file->start();
+}
+
+void OtherLogsPage::logLinesAdded(int, int last)
+{
+	if (m_pendingLine != -1 && m_pendingLine <= last)
+	{
+		jumpToLine(m_pendingLine);
+	}
+}
+
+void OtherLogsPage::logFinished()
+{
+	auto file = m_model->file();
+	if (!file || file.get() != sender())
+	{
+		return;
+	}
+	const auto error = file->errorString();
+	if (!error.isEmpty())
 	{
+		const auto name = m_currentFile;
+		releaseFile();
 		setControlsEnabled(false);
 		ui->btnReload->setEnabled(true); // allow reload
-		m_currentFile = QString();
-		QMessageBox::critical(this, tr("Error"), tr("Unable to open %1 for reading: %2")
-													 .arg(m_currentFile, file.errorString()));
+		QMessageBox::critical(this, tr("Error"), tr("Unable to open %1 for reading: %2").arg(name, error));
 	}
-	else
+}
+
+void OtherLogsPage::releaseFile()
+{
+	m_pendingLine = -1;
+	m_model->setFile(nullptr);
+}
+
+void OtherLogsPage::jumpToLine(int line)
+{
+	if (line >= m_model->rowCount())
 	{
-		auto showTooBig = [&]()
-		{
-			ui->text->setPlainText(
-				tr("The file (%1) is too big. You may want to open it in a viewer optimized "
-				   "for large files.").arg(file.fileName()));
-		};
-		if(file.size() > (1024ll * 1024ll * 12ll))
-		{
-			showTooBig();
-			return;
-		}
-		QString content;
-		if(file.fileName().endsWith(".gz"))
-		{
-			QByteArray temp;
-			if(!GZip::unzip(file.readAll(), temp))
-			{
-				ui->text->setPlainText(
-					tr("The file (%1) is not readable.").arg(file.fileName()));
-				return;
-			}
-			content = QString::fromUtf8(temp);
-		}
-		else
-		{
-			content = QString::fromUtf8(file.readAll());
-		}
-		if (content.size() >= 50000000ll)
-		{
-			showTooBig();
-			return;
-		}
-		ui->text->setPlainText(content);
+		// not indexed yet, logLinesAdded will get back to it
+		m_pendingLine = line;
+		return;
 	}
+	m_pendingLine = -1;
+	auto index = m_model->index(line);
+	ui->logView->setCurrentIndex(index);
+	ui->logView->scrollTo(index, QAbstractItemView::PositionAtCenter);
+}
+
+QString OtherLogsPage::contentForExport(qint64 limit)
+{
+	auto file = m_model->file();
+	if (!file)
+	{
+		return QString();
+	}
+	if (!file->isFinished())
+	{
+		QMessageBox::information(this, tr("Please wait"), tr("The file (%1) is still being loaded.").arg(m_currentFile));
+		return QString();
+	}
+	if (file->size() > limit)
+	{
+		QMessageBox::information(
+			this, tr("Too big"),
+			tr("The file (%1) is too big. You may want to open it in a viewer optimized "
+			   "for large files.").arg(m_currentFile));
+		return QString();
+	}
+	return QString::fromUtf8(file->content());
 }
 
 void OtherLogsPage::on_btnPaste_clicked()
 {
-	GuiUtil::uploadPaste(ui->text->toPlainText(), this);
+	auto content = contentForExport(maxPasteSize);
+	if (!content.isEmpty())
+	{
+		GuiUtil::uploadPaste(content, this);
+	}
 }
 
 void OtherLogsPage::on_btnCopy_clicked()
 {
-	GuiUtil::setClipboardText(ui->text->toPlainText());
+	// copy the selected lines, or everything if nothing is selected
+	auto selected = ui->logView->selectionModel()->selectedRows();
+	if (selected.size() > 1)
+	{
+		std::sort(selected.begin(), selected.end());
+		QStringList lines;
+		for (const auto &index : selected)
+		{
+			lines.append(m_model->file()->line(index.row()));
+		}
+		GuiUtil::setClipboardText(lines.join('\n'));
+		return;
+	}
+	auto content = contentForExport(maxCopySize);
+	if (!content.isEmpty())
+	{
+		GuiUtil::setClipboardText(content);
+	}
+}
+
+void OtherLogsPage::on_searchBar_textEdited(const QString &)
+{
+	// both searches go through whole files, so not for every key
+	m_searchDelay->start();
+}
+
+void OtherLogsPage::searchAsYouType()
+{
+	// search as you type, starting where we are
+	findInCurrentFile(qMax(ui->logView->currentIndex().row(), 0));
+	if (ui->searchAllLogs->isChecked())
+	{
+		startSearchAllLogs();
+	}
+}
+
+void OtherLogsPage::on_searchBar_returnPressed()
+{
+	if (m_searchDelay->isActive())
+	{
+		m_searchDelay->stop();
+		searchAsYouType();
+		return;
+	}
+	on_btnFindNext_clicked();
+}
+
+void OtherLogsPage::on_btnFindNext_clicked()
+{
+	findInCurrentFile(ui->logView->currentIndex().row() + 1);
+}
+
+void OtherLogsPage::findInCurrentFile(int fromLine)
+{
+	auto file = m_model->file();
+	const auto needle = ui->searchBar->text();
+	if (!file || needle.isEmpty())
+	{
+		return;
+	}
+	const int line = file->find(needle, fromLine, Qt::CaseInsensitive);
+	if (line != -1)
+	{
+		jumpToLine(line);
+	}
+}
+
+void OtherLogsPage::on_searchAllLogs_toggled(bool checked)
+{
+	ui->searchResults->setVisible(checked);
+	if (checked)
+	{
+		startSearchAllLogs();
+	}
+	else
+	{
+		m_search.reset();
+		ui->searchResults->clear();
+	}
+}
+
+void OtherLogsPage::startSearchAllLogs()
+{
+	m_search.reset();
+	ui->searchResults->clear();
+	const auto needle = ui->searchBar->text();
+	if (needle.isEmpty())
+	{
+		return;
+	}
+	QStringList files;
+	for (const auto &file : m_watcher->files())
+	{
+		files.append(FS::PathCombine(m_path, file));
+	}
+	m_search.reset(new LogSearch(files, needle, Qt::CaseInsensitive));
+	connect(m_search.get(), &LogSearch::found, this, &OtherLogsPage::searchFound);
+	connect(m_search.get(), &LogSearch::finished, this, &OtherLogsPage::searchFinished);
+	m_search->start();
+}
+
+void OtherLogsPage::searchFound(const QString &file, int line, const QString &text)
+{
+	if (sender() != m_search.get())
+	{
+		return;
+	}
+	const auto relative = QDir(m_path).relativeFilePath(file);
+	auto item = new QListWidgetItem(QString("%1:%2: %3").arg(relative).arg(line + 1).arg(text.left(500)));
+	item->setData(Qt::UserRole, relative);
+	item->setData(Qt::UserRole + 1, line);
+	ui->searchResults->addItem(item);
+}
+
+void OtherLogsPage::searchFinished(int results)
+{
+	if (sender() != m_search.get())
+	{
+		return;
+	}
+	if (results >= LogSearch::maxResults)
+	{
+		auto item = new QListWidgetItem(tr("Only the first %1 results are shown.").arg(results));
+		item->setFlags(Qt::NoItemFlags);
+		ui->searchResults->addItem(item);
+	}
+	else if (results == 0)
+	{
+		auto item = new QListWidgetItem(tr("Nothing found."));
+		item->setFlags(Qt::NoItemFlags);
+		ui->searchResults->addItem(item);
+	}
+}
+
+void OtherLogsPage::on_searchResults_itemActivated(QListWidgetItem *item)
+{
+	const auto file = item->data(Qt::UserRole).toString();
+	const int line = item->data(Qt::UserRole + 1).toInt();
+	if (file.isEmpty())
+	{
+		return;
+	}
+	if (file != m_currentFile)
+	{
+		const int index = ui->selectLogBox->findText(file);
+		if (index == -1)
+		{
+			return;
+		}
+		ui->selectLogBox->setCurrentIndex(index);
+	}
+	jumpToLine(line);
 }
 
 void OtherLogsPage::on_btnDelete_clicked()
@@ -174,11 +378,14 @@ void OtherLogsPage::on_btnDelete_clicked()
 	{
 		return;
 	}
+	// the file is mapped into memory, which would keep it from being deleted on some systems
+	releaseFile();
 	QFile file(FS::PathCombine(m_path, m_currentFile));
 	if (!file.remove())
 	{
 		QMessageBox::critical(this, tr("Error"), tr("Unable to delete %1: %2")
 													 .arg(m_currentFile, file.errorString()));
+		on_btnReload_clicked();
 	}
 }
 
@@ -212,6 +419,7 @@ void OtherLogsPage::on_btnClean_clicked()
 	{
 		return;
 	}
+	releaseFile();
 	QStringList failed;
 	for(auto item: toDelete)
 	{
@@ -221,6 +429,10 @@ void OtherLogsPage::on_btnClean_clicked()
 			failed.push_back(item);
 		}
 	}
+	if (failed.contains(m_currentFile))
+	{
+		on_btnReload_clicked();
+	}
 	if(!failed.empty())
 	{
 		QMessageBox *messageBox = new QMessageBox(this);
@@ -250,6 +462,8 @@ void OtherLogsPage::setControlsEnabled(const bool enabled)
 	ui->btnDelete->setEnabled(enabled);
 	ui->btnCopy->setEnabled(enabled);
 	ui->btnPaste->setEnabled(enabled);
-	ui->text->setEnabled(enabled);
+	ui->logView->setEnabled(enabled);
+	ui->searchBar->setEnabled(enabled);
+	ui->btnFindNext->setEnabled(enabled);
 	ui->btnClean->setEnabled(enabled);
 }
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <QWidget>
+#include <memory>
 
 #include "BasePage.h"
 #include <MultiMC.h>
@@ -27,6 +28,10 @@ class OtherLogsPage;
 }
 
 class RecursiveFileSystemWatcher;
+class LogFileModel;
+class LogSearch;
+class QListWidgetItem;
+class QTimer;
 
 class OtherLogsPage : public QWidget, public BasePage
 {
@@ -63,9 +68,26 @@ private slots:
 	void on_btnCopy_clicked();
 	void on_btnDelete_clicked();
 	void on_btnClean_clicked();
+	void on_searchBar_textEdited(const QString &text);
+	void on_searchBar_returnPressed();
+	void on_btnFindNext_clicked();
+	void on_searchAllLogs_toggled(bool checked);
+	void on_searchResults_itemActivated(QListWidgetItem *item);
+	void logLinesAdded(int first, int last);
+	void logFinished();
+	void searchFound(const QString &file, int line, const QString &text);
+	void searchFinished(int results);
+	void searchAsYouType();
 
 private:
 	void setControlsEnabled(const bool enabled);
+	/// close the current file, so it can be deleted
+	void releaseFile();
+	/// the whole current file as text, or an empty string (with an explanation shown) if it is too big
+	QString contentForExport(qint64 limit);
+	void findInCurrentFile(int fromLine);
+	void jumpToLine(int line);
+	void startSearchAllLogs();
 
 private:
 	Ui::OtherLogsPage *ui;
@@ -73,4 +95,10 @@ private:
 	QString m_currentFile;
 	IPathMatcher::Ptr m_fileFilter;
 	RecursiveFileSystemWatcher *m_watcher;
+	LogFileModel *m_model;
+	std::unique_ptr<LogSearch> m_search;
+	/// typing restarts it, the search runs once the typing pauses
+	QTimer *m_searchDelay;
+	/// line to show once it has been indexed, -1 if none
+	int m_pendingLine = -1;
 };
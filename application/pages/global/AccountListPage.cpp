@@ -30,6 +30,7 @@
 #include "dialogs/CustomMessageBox.h"
 #include "tasks/Task.h"
 #include "minecraft/auth/YggdrasilTask.h"
+#include "minecraft/SkinUtils.h"
 
 #include "MultiMC.h"
 
@@ -135,6 +136,10 @@ void AccountListPage::addAccount(const QString &errMsg)
 			job->addNetAction(action);
 			meta->stale = true;
 		}
+		connect(job, &NetJob::succeeded, []()
+		{
+			SkinUtils::invalidateFaces();
+		});
 
 		job->start();
 	}
@@ -20,7 +20,9 @@
 #include <QDir>
 
 #include "settings/SettingsObject.h"
+#include "minecraft/ModStore.h"
 #include "MultiMC.h"
+#include "Env.h"
 
 MinecraftPage::MinecraftPage(QWidget *parent) : QWidget(parent), ui(new Ui::MinecraftPage)
 {
@@ -28,6 +30,7 @@ MinecraftPage::MinecraftPage(QWidget *parent) : QWidget(parent), ui(new Ui::Mine
 	ui->tabWidget->tabBar()->hide();
 	loadSettings();
 	updateCheckboxStuff();
+	updateModStoreLabel();
 }
 
 MinecraftPage::~MinecraftPage()
@@ -53,6 +56,36 @@ void MinecraftPage::on_maximizedCheckBox_clicked(bool checked)
 	updateCheckboxStuff();
 }
 
+void MinecraftPage::on_modStoreCheckBox_clicked(bool checked)
+{
+	Q_UNUSED(checked);
+	updateModStoreLabel();
+}
+
+void MinecraftPage::updateModStoreLabel()
+{
+	// the store is set up while starting, so a change only shows after a restart
+	auto store = ENV.modStore();
+	if (ui->modStoreCheckBox->isChecked() != bool(store))
+	{
+		ui->modStoreLabel->setText(tr("This takes effect the next time MultiMC starts."));
+		return;
+	}
+	ModStore::Report report;
+	if (!store)
+	{
+		ui->modStoreLabel->clear();
+	}
+	else if (store->lastReport(&report))
+	{
+		ui->modStoreLabel->setText(tr("Checked since starting: %1").arg(report.toString()));
+	}
+	else
+	{
+		ui->modStoreLabel->setText(tr("The mod files are being checked in the background."));
+	}
+}
+
 
 void MinecraftPage::applySettings()
 {
@@ -62,6 +95,9 @@ void MinecraftPage::applySettings()
 	s->set("LaunchMaximized", ui->maximizedCheckBox->isChecked());
 	s->set("MinecraftWinWidth", ui->windowWidthSpinBox->value());
 	s->set("MinecraftWinHeight", ui->windowHeightSpinBox->value());
+
+	// Mod Storage
+	s->set("UseModStore", ui->modStoreCheckBox->isChecked());
 }
 
 void MinecraftPage::loadSettings()
@@ -72,4 +108,7 @@ void MinecraftPage::loadSettings()
 	ui->maximizedCheckBox->setChecked(s->get("LaunchMaximized").toBool());
 	ui->windowWidthSpinBox->setValue(s->get("MinecraftWinWidth").toInt());
 	ui->windowHeightSpinBox->setValue(s->get("MinecraftWinHeight").toInt());
+
+	// Mod Storage
+	ui->modStoreCheckBox->setChecked(s->get("UseModStore").toBool());
 }
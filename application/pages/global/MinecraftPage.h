@@ -57,12 +57,14 @@ public:
 
 private:
 	void updateCheckboxStuff();
+	void updateModStoreLabel();
 	void applySettings();
 	void loadSettings();
 
 private
 slots:
 	void on_maximizedCheckBox_clicked(bool checked);
+	void on_modStoreCheckBox_clicked(bool checked);
 
 private:
 	Ui::MinecraftPage *ui;
@@ -0,0 +1,76 @@
+#include "ProcessGraph.h"
+
+#include <QPainter>
+#include <QPainterPath>
+
+ProcessGraph::ProcessGraph(ProcessSampler *sampler, QWidget *parent)
+	: QWidget(parent), m_sampler(sampler)
+{
+	setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Preferred);
+	setToolTip(tr("Resource usage of the game: memory in blue, CPU in red."));
+	connect(m_sampler, &ProcessSampler::sampled, this, &ProcessGraph::sampled);
+}
+
+QSize ProcessGraph::sizeHint() const
+{
+	return QSize(150, 24);
+}
+
+void ProcessGraph::sampled(const ProcessSampler::Sample &sample)
+{
+	setToolTip(tr("Memory: %1 MiB\nCPU: %2%\nThreads: %3\nRead: %4 MiB, written: %5 MiB")
+				   .arg(sample.rssBytes / (1024 * 1024))
+				   .arg(sample.cpuPercent, 0, 'f', 0)
+				   .arg(sample.threads)
+				   .arg(sample.readBytes / (1024 * 1024))
+				   .arg(sample.writeBytes / (1024 * 1024)));
+	update();
+}
+
+void ProcessGraph::paintEvent(QPaintEvent *)
+{
+	QPainter p(this);
+	p.setRenderHint(QPainter::Antialiasing);
+	p.fillRect(rect(), palette().base());
+	p.setPen(palette().mid().color());
+	p.drawRect(rect().adjusted(0, 0, -1, -1));
+
+	auto samples = m_sampler->samples();
+	if (samples.size() < 2)
+	{
+		return;
+	}
+	// show the last minute or so, one pixel per sample
+	const int count = qMin(samples.size(), width() - 2);
+	const int first = samples.size() - count;
+	qint64 maxRss = 1;
+	double maxCpu = 100.0;
+	for (int i = first; i < samples.size(); i++)
+	{
+		maxRss = qMax(maxRss, samples[i].rssBytes);
+		maxCpu = qMax(maxCpu, samples[i].cpuPercent);
+	}
+	const double h = height() - 3;
+	QPainterPath memory, cpu;
+	for (int i = 0; i < count; i++)
+	{
+		auto &sample = samples[first + i];
+		const double x = width() - 2 - (count - 1 - i);
+		const double memoryY = 1 + h - h * double(sample.rssBytes) / maxRss;
+		const double cpuY = 1 + h - h * sample.cpuPercent / maxCpu;
+		if (i == 0)
+		{
+			memory.moveTo(x, memoryY);
+			cpu.moveTo(x, cpuY);
+		}
+		else
+		{
+			memory.lineTo(x, memoryY);
+			cpu.lineTo(x, cpuY);
+		}
+	}
+	p.setPen(QColor(Qt::blue));
+	p.drawPath(memory);
+	p.setPen(QColor(Qt::red));
+	p.drawPath(cpu);
+}
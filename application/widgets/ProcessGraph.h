@@ -0,0 +1,22 @@
+#pragma once
+#include <QWidget>
+#include <launch/ProcessSampler.h>
+
+/**
+ * A small graph of the memory and CPU usage of a running game.
+ */
+class ProcessGraph : public QWidget
+{
+	Q_OBJECT
+
+public:
+	explicit ProcessGraph(ProcessSampler *sampler, QWidget *parent = 0);
+	QSize sizeHint() const;
+	void paintEvent(QPaintEvent *);
+
+private slots:
+	void sampled(const ProcessSampler::Sample &sample);
+
+private:
+	ProcessSampler *m_sampler;
+};
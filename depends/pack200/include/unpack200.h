@@ -25,6 +25,30 @@
 
 #pragma once
 #include <string>
+#include <functional>
+#include <cstdio>
+#include <cstdint>
+
+/**
+ * Pulls packed input. Fills at most maxlen bytes of buf and returns how many were written there.
+ * Returning 0 means the input has ended.
+ */
+typedef std::function<int64_t(void *buf, int64_t maxlen)> unpack_200_reader;
+
+/**
+ * Receives the unpacked jar, in order. Returns false if the data could not be stored.
+ */
+typedef std::function<bool(const void *buf, size_t len)> unpack_200_writer;
+
+/**
+ * @brief Unpack a PACK200 stream
+ *
+ * @param input Source of the PACK200 data. Gzip compressed input is detected and handled.
+ * @param output Sink for the resulting jar file.
+ * @param parallel_deflate Compress the jar entries on all available cores. The output is identical.
+ * @throw std::runtime_error for any error encountered
+ */
+void unpack_200(unpack_200_reader input, unpack_200_writer output, bool parallel_deflate = false);
 
 /**
  * @brief Unpack a PACK200 file
@@ -42,28 +42,21 @@
 #include "unpack.h"
 #include "zip.h"
 
-// Callback for fetching data, Unix style.
-static int64_t read_input_via_stdio(unpacker *u, void *buf, int64_t minlen, int64_t maxlen)
+#include <thread>
+
+// Callback for fetching data from an unpack_200_reader
+static int64_t read_input_via_callback(unpacker *u, void *buf, int64_t minlen, int64_t maxlen)
 {
-	assert(u->infileptr != nullptr);
+	assert(u->read_input_state != nullptr);
 	assert(minlen <= maxlen); // don't talk nonsense
+	auto &reader = *(unpack_200_reader *)u->read_input_state;
 	int64_t numread = 0;
 	char *bufptr = (char *)buf;
 	while (numread < minlen)
 	{
-		// read available input, up to buf.length or maxlen
-		int readlen = (1 << 16);
-		if (readlen > (maxlen - numread))
-			readlen = (int)(maxlen - numread);
-		int nr = 0;
-
-		nr = (int)fread(bufptr, 1, readlen, u->infileptr);
+		int64_t nr = reader(bufptr, maxlen - numread);
 		if (nr <= 0)
-		{
-			if (errno != EINTR)
-				break;
-			nr = 0;
-		}
+			break;
 		numread += nr;
 		bufptr += nr;
 		assert(numread <= maxlen);
@@ -94,69 +87,104 @@ static int read_magic(unpacker *u, char peek[], int peeklen)
 	return magic;
 }
 
-void unpack_200(FILE *input, FILE *output)
+void unpack_200(unpack_200_reader input, unpack_200_writer output, bool parallel_deflate)
 {
 	unpacker u;
-	u.init(read_input_via_stdio);
+	u.init(read_input_via_callback);
 
 	// initialize jar output
-	// the output takes ownership of the file handle
 	jar jarout;
 	jarout.init(&u);
-	jarout.jarfp = output;
-
-	// the input doesn't
-	u.infileptr = input;
-
-	// read the magic!
-	char peek[4];
-	int magic;
-	magic = read_magic(&u, peek, (int)sizeof(peek));
-
-	// if it is a gzip encoded file, we need an extra gzip input filter
-	if ((magic & GZIP_MAGIC_MASK) == GZIP_MAGIC)
-	{
-		gunzip *gzin = NEW(gunzip, 1);
-		gzin->init(&u);
-		// FIXME: why the side effects? WHY?
-		u.gzin->start(magic);
-		u.start();
-	}
-	else
+	jarout.sink = &output;
+	if (parallel_deflate)
 	{
-		// otherwise, feed the bytes to the unpacker directly
-		u.start(peek, sizeof(peek));
+		jarout.start_parallel_deflate(std::thread::hardware_concurrency());
 	}
 
-	// Note:  The checks to u.aborting() are necessary to gracefully
-	// terminate processing when the first segment throws an error.
-	for (;;)
+	u.read_input_state = &input;
+
+	try
 	{
-		// Each trip through this loop unpacks one segment
-		// and then resets the unpacker.
-		for (unpacker::file *filep; (filep = u.get_next_file()) != nullptr;)
+		// read the magic!
+		char peek[4];
+		int magic;
+		magic = read_magic(&u, peek, (int)sizeof(peek));
+
+		// if it is a gzip encoded file, we need an extra gzip input filter
+		if ((magic & GZIP_MAGIC_MASK) == GZIP_MAGIC)
 		{
-			u.write_file_to_jar(filep);
+			gunzip *gzin = NEW(gunzip, 1);
+			gzin->init(&u);
+			// FIXME: why the side effects? WHY?
+			u.gzin->start(magic);
+			u.start();
 		}
-
-		// Peek ahead for more data.
-		magic = read_magic(&u, peek, (int)sizeof(peek));
-		if (magic != (int)JAVA_PACKAGE_MAGIC)
+		else
 		{
-			// we do not feel strongly about this kind of thing...
-			/*
-			if (magic != EOF_MAGIC)
-				unpack_abort("garbage after end of pack archive");
-			*/
-			break; // all done
+			// otherwise, feed the bytes to the unpacker directly
+			u.start(peek, sizeof(peek));
 		}
 
-		// Release all storage from parsing the old segment.
-		u.reset();
-		// Restart, beginning with the peek-ahead.
-		u.start(peek, sizeof(peek));
+		// Note:  The checks to u.aborting() are necessary to gracefully
+		// terminate processing when the first segment throws an error.
+		for (;;)
+		{
+			// Each trip through this loop unpacks one segment
+			// and then resets the unpacker.
+			for (unpacker::file *filep; (filep = u.get_next_file()) != nullptr;)
+			{
+				u.write_file_to_jar(filep);
+			}
+
+			// Peek ahead for more data.
+			magic = read_magic(&u, peek, (int)sizeof(peek));
+			if (magic != (int)JAVA_PACKAGE_MAGIC)
+			{
+				// we do not feel strongly about this kind of thing...
+				/*
+				if (magic != EOF_MAGIC)
+					unpack_abort("garbage after end of pack archive");
+				*/
+				break; // all done
+			}
+
+			// Release all storage from parsing the old segment.
+			u.reset();
+			// Restart, beginning with the peek-ahead.
+			u.start(peek, sizeof(peek));
+		}
+		u.finish();
+	}
+	catch (...)
+	{
+		// the worker threads must not outlive the data they are working on
+		jarout.stop_parallel_deflate();
+		throw;
 	}
-	u.finish();
 	u.free(); // tidy up malloc blocks
+}
+
+void unpack_200(FILE *input, FILE *output)
+{
+	auto reader = [input](void *buf, int64_t maxlen) -> int64_t
+	{
+		int readlen = (1 << 16);
+		if (readlen > maxlen)
+			readlen = (int)maxlen;
+		while (true)
+		{
+			int nr = (int)fread(buf, 1, readlen, input);
+			if (nr > 0 || !ferror(input) || errno != EINTR)
+				return nr;
+			clearerr(input);
+		}
+	};
+	auto writer = [output](const void *buf, size_t len)
+	{
+		return fwrite(buf, 1, len, output) == len;
+	};
+	unpack_200(reader, writer, false);
+	// the output is ours to close, like the input
+	fclose(output);
 	fclose(input);
 }
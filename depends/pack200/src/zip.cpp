@@ -47,9 +47,18 @@
 #include "unpack.h"
 
 #include "zip.h"
+#include "unpack200.h"
 
 #include "zlib.h"
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 inline uint32_t jar::get_crc32(uint32_t c, uchar *ptr, uint32_t len)
 {
 	return crc32(c, ptr, len);
@@ -66,6 +75,124 @@ inline uint32_t jar::get_crc32(uint32_t c, uchar *ptr, uint32_t len)
 
 #define GET_INT_HI(a) SWAP_BYTES((a >> 16) & 0xFFFF);
 
+static size_t deflate_into(uchar *out, size_t outlen, bytes &head, bytes &tail);
+
+/* Parallel deflate
+ *
+ * Entries are copied out of the unpacker (its buffers get reused for the next
+ * file), compressed and checksummed on worker threads and written by the
+ * unpacker thread in the order they were added. At most 'window' entries are
+ * in flight, which bounds the extra memory used.
+ */
+struct jar_deflater
+{
+	struct entry
+	{
+		std::string name;
+		int modtime = 0;
+		bool deflate_hint = false;
+		std::vector<uchar> data;
+		// results, valid once done is set
+		uint32_t crc = 0;
+		std::vector<uchar> deflated;
+		bool done = false;
+	};
+
+	std::mutex lock;
+	std::condition_variable work_available;
+	std::condition_variable work_done;
+	// not picked up by a worker yet
+	std::deque<std::shared_ptr<entry>> todo;
+	// everything not written yet, in output order
+	std::deque<std::shared_ptr<entry>> pending;
+	std::vector<std::thread> workers;
+	size_t window = 0;
+	bool stopping = false;
+
+	explicit jar_deflater(unsigned threads)
+	{
+		window = threads * 4;
+		for (unsigned i = 0; i < threads; i++)
+		{
+			workers.emplace_back([this]() { work(); });
+		}
+	}
+
+	~jar_deflater()
+	{
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			stopping = true;
+			todo.clear();
+		}
+		work_available.notify_all();
+		for (auto &worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	void work()
+	{
+		while (true)
+		{
+			std::shared_ptr<entry> e;
+			{
+				std::unique_lock<std::mutex> guard(lock);
+				work_available.wait(guard, [this]() { return stopping || !todo.empty(); });
+				if (stopping)
+					return;
+				e = todo.front();
+				todo.pop_front();
+			}
+			int len = (int)e->data.size();
+			e->crc = jar::get_crc32(jar::get_crc32(0, Z_NULL, 0), e->data.data(), len);
+			if (e->deflate_hint && len > 0)
+			{
+				bytes head, tail;
+				head.set((int8_t *)e->data.data(), len);
+				tail.set(nullptr, 0);
+				e->deflated.resize(len + (len / 2));
+				e->deflated.resize(deflate_into(e->deflated.data(), e->deflated.size(), head, tail));
+			}
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				e->done = true;
+			}
+			work_done.notify_all();
+		}
+	}
+
+	void add(const char *fname, bool deflate_hint, int modtime, bytes &head, bytes &tail)
+	{
+		auto e = std::make_shared<entry>();
+		e->name = fname;
+		e->modtime = modtime;
+		e->deflate_hint = deflate_hint;
+		e->data.resize(head.len + tail.len);
+		if (head.len)
+			memcpy(e->data.data(), head.ptr, head.len);
+		if (tail.len)
+			memcpy(e->data.data() + head.len, tail.ptr, tail.len);
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			pending.push_back(e);
+			todo.push_back(e);
+		}
+		work_available.notify_one();
+	}
+
+	// the oldest entry, once it is finished
+	std::shared_ptr<entry> take()
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		auto e = pending.front();
+		work_done.wait(guard, [&e]() { return e->done; });
+		pending.pop_front();
+		return e;
+	}
+};
+
 void jar::init(unpacker *u_)
 {
 	BYTES_OF(*this).clear();
@@ -76,6 +203,15 @@ void jar::init(unpacker *u_)
 // Write data to the ZIP output stream.
 void jar::write_data(void *buff, int len)
 {
+	if (sink)
+	{
+		if (len > 0 && !(*(unpack_200_writer *)sink)(buff, (size_t)len))
+		{
+			unpack_abort("write on output failed");
+		}
+		output_file_offset += len;
+		return;
+	}
 	while (len > 0)
 	{
 		int rc = (int)fwrite(buff, 1, len, jarfp);
@@ -259,6 +395,17 @@ void jar::openJarFile(const char *fname)
 void jar::addJarEntry(const char *fname, bool deflate_hint, int modtime, bytes &head,
 					  bytes &tail)
 {
+	if (deflater)
+	{
+		deflater->add(fname, deflate_hint, modtime, head, tail);
+		// pending is only ever changed from this thread
+		while (deflater->pending.size() > deflater->window)
+		{
+			write_next_deflated();
+		}
+		return;
+	}
+
 	int len = (int)(head.len + tail.len);
 	int clen = 0;
 
@@ -278,24 +425,33 @@ void jar::addJarEntry(const char *fname, bool deflate_hint, int modtime, bytes &
 		}
 	}
 	clen = (int)((deflate) ? deflated.size() : len);
-	add_to_jar_directory(fname, !deflate, modtime, len, clen, crc);
-	write_jar_header(fname, !deflate, modtime, len, clen, crc);
-
 	if (deflate)
 	{
-		write_data(deflated.b);
+		bytes none;
+		none.set(nullptr, 0);
+		write_entry(fname, !deflate, modtime, len, clen, crc, deflated.b, none);
 	}
 	else
 	{
-		write_data(head);
-		write_data(tail);
+		write_entry(fname, !deflate, modtime, len, clen, crc, head, tail);
 	}
 }
 
+// Record an entry in the central directory and write its header and data
+void jar::write_entry(const char *fname, bool store, int modtime, int len, int clen,
+					  uint32_t crc, bytes &head, bytes &tail)
+{
+	add_to_jar_directory(fname, store, modtime, len, clen, crc);
+	write_jar_header(fname, store, modtime, len, clen, crc);
+	write_data(head);
+	write_data(tail);
+}
+
 // Add a ZIP entry for a directory name no data
 void jar::addDirectoryToJarFile(const char *dir_name)
 {
 	bool store = true;
+	flush_deflater();
 	add_to_jar_directory((const char *)dir_name, store, default_modtime, 0, 0, 0);
 	write_jar_header((const char *)dir_name, store, default_modtime, 0, 0, 0);
 }
@@ -303,7 +459,15 @@ void jar::addDirectoryToJarFile(const char *dir_name)
 // Write out the central directory and close the jar file.
 void jar::closeJarFile(bool central)
 {
-	if (jarfp)
+	flush_deflater();
+	stop_parallel_deflate();
+	if (sink)
+	{
+		// the owner of the sink takes care of closing it
+		if (central)
+			write_central_directory();
+	}
+	else if (jarfp)
 	{
 		fflush(jarfp);
 		if (central)
@@ -352,11 +516,12 @@ uint32_t jar::get_dostime(int modtime)
 	return dostime_cache;
 }
 
-/* Returns true on success, and will set the clen to the compressed
-   length, the caller should verify if true and clen less than the
-   input data
+/* Deflates head followed by tail into out, which has room for outlen bytes.
+   Returns the compressed length, or 0 if deflating failed or did not
+   make the data any smaller. Touches no shared state, so it is safe to
+   call from the parallel deflate workers.
 */
-bool jar::deflate_bytes(bytes &head, bytes &tail)
+static size_t deflate_into(uchar *out, size_t outlen, bytes &head, bytes &tail)
 {
 	int len = (int)(head.len + tail.len);
 
@@ -370,28 +535,11 @@ bool jar::deflate_bytes(bytes &head, bytes &tail)
 		deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
 	if (error != Z_OK)
 	{
-		/*
-		switch (error)
-		{
-		case Z_MEM_ERROR:
-			PRINTCR((2, "Error: deflate error : Out of memory \n"));
-			break;
-		case Z_STREAM_ERROR:
-			PRINTCR((2, "Error: deflate error : Invalid compression level \n"));
-			break;
-		case Z_VERSION_ERROR:
-			PRINTCR((2, "Error: deflate error : Invalid version\n"));
-			break;
-		default:
-			PRINTCR((2, "Error: Internal deflate error error = %d\n", error));
-		}
-		*/
-		return false;
+		return 0;
 	}
 
-	deflated.empty();
-	zs.next_out = (uchar *)deflated.grow(len + (len / 2));
-	zs.avail_out = (int)deflated.size();
+	zs.next_out = out;
+	zs.avail_out = (int)outlen;
 
 	zs.next_in = (uchar *)head.ptr;
 	zs.avail_in = (int)head.len;
@@ -420,20 +568,71 @@ bool jar::deflate_bytes(bytes &head, bytes &tail)
 		zs.avail_in = (int)last->len;
 		error = deflate(&zs, Z_FINISH);
 	}
-	if (error == Z_STREAM_END)
+	size_t clen = 0;
+	if (error == Z_STREAM_END && len > (int)zs.total_out)
+	{
+		clen = zs.total_out;
+	}
+	deflateEnd(&zs);
+	return clen;
+}
+
+/* Returns true on success, and will set the clen to the compressed
+   length, the caller should verify if true and clen less than the
+   input data
+*/
+bool jar::deflate_bytes(bytes &head, bytes &tail)
+{
+	int len = (int)(head.len + tail.len);
+
+	deflated.empty();
+	uchar *out = (uchar *)deflated.grow(len + (len / 2));
+	size_t clen = deflate_into(out, deflated.size(), head, tail);
+	if (clen == 0)
 	{
-		if (len > (int)zs.total_out)
-		{
-			deflated.b.len = zs.total_out;
-			deflateEnd(&zs);
-			return true;
-		}
-		deflateEnd(&zs);
 		return false;
 	}
+	deflated.b.len = clen;
+	return true;
+}
 
-	deflateEnd(&zs);
-	return false;
+void jar::start_parallel_deflate(unsigned threads)
+{
+	stop_parallel_deflate();
+	if (threads > 1)
+		deflater = new jar_deflater(threads);
+}
+
+void jar::stop_parallel_deflate()
+{
+	delete deflater;
+	deflater = nullptr;
+}
+
+// Write out the oldest entry handed to the parallel deflater.
+void jar::write_next_deflated()
+{
+	auto e = deflater->take();
+	int len = (int)e->data.size();
+	bool deflate = !e->deflated.empty();
+	bytes data, none;
+	none.set(nullptr, 0);
+	if (deflate)
+		data.set((int8_t *)e->deflated.data(), e->deflated.size());
+	else
+		data.set((int8_t *)e->data.data(), e->data.size());
+	write_entry(e->name.c_str(), !deflate, e->modtime, len, (int)data.len, e->crc, data, none);
+}
+
+// Write out everything handed to the parallel deflater so far.
+void jar::flush_deflater()
+{
+	if (!deflater)
+		return;
+	while (!deflater->pending.empty())
+	{
+		write_next_deflated();
+	}
 }
 
 // Callback for fetching data from a GZIP input stream
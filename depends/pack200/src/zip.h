@@ -28,11 +28,16 @@ typedef unsigned int uint32_t;
 typedef unsigned char uchar;
 
 struct unpacker;
+struct jar_deflater;
 
 struct jar
 {
 	// JAR file writer
 	FILE *jarfp;
+	// if set, output goes here instead of jarfp (points at an unpack_200_writer)
+	void *sink;
+	// if set, entries are deflated on worker threads (see start_parallel_deflate)
+	jar_deflater *deflater;
 	int default_modtime;
 
 	// Used by unix2dostime:
@@ -55,6 +60,11 @@ struct jar
 	void addDirectoryToJarFile(const char *dir_name);
 	void closeJarFile(bool central);
 
+	// Deflate entries on this many threads from now on. Output stays byte for byte the same.
+	void start_parallel_deflate(unsigned threads);
+	// Drop the worker threads and anything they have not written yet.
+	void stop_parallel_deflate();
+
 	void init(unpacker *u_);
 
 	void free()
@@ -80,6 +90,10 @@ struct jar
 	void write_jar_header(const char *fname, bool store, int modtime, int len, int clen,
 						  unsigned int crc);
 	void write_central_directory();
+	void write_entry(const char *fname, bool store, int modtime, int len, int clen,
+					 uint32_t crc, bytes &head, bytes &tail);
+	void write_next_deflated();
+	void flush_deflater();
 	uint32_t dostime(int y, int n, int d, int h, int m, int s);
 	uint32_t get_dostime(int modtime);
 
@@ -0,0 +1,198 @@
+#include "AsyncLogWriter.h"
+
+#include <QMutexLocker>
+#include <QFileDevice>
+#include <cstdio>
+
+namespace
+{
+// QtMsgType values are not ordered by severity (QtInfoMsg came last)
+int severity(QtMsgType type)
+{
+	switch (type)
+	{
+	case QtDebugMsg:
+		return 0;
+	case QtWarningMsg:
+		return 2;
+	case QtCriticalMsg:
+		return 3;
+	case QtFatalMsg:
+		return 4;
+	default:
+		// info
+		return 1;
+	}
+}
+
+char levelLetter(QtMsgType type)
+{
+	switch (type)
+	{
+	case QtDebugMsg:
+		return 'D';
+	case QtWarningMsg:
+		return 'W';
+	case QtCriticalMsg:
+		return 'C';
+	case QtFatalMsg:
+		return 'F';
+	default:
+		return 'I';
+	}
+}
+}
+
+AsyncLogWriter::AsyncLogWriter(std::shared_ptr<QIODevice> output, bool echoToStderr)
+	: m_output(output), m_echoToStderr(echoToStderr), m_head(nullptr), m_minimumSeverity(0),
+	  m_stopped(false), m_writeLock(QMutex::Recursive)
+{
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+	stop();
+	// anything that raced with stop()
+	drain();
+}
+
+void AsyncLogWriter::setMinimumLevel(QtMsgType level)
+{
+	m_minimumSeverity = severity(level);
+}
+
+bool AsyncLogWriter::accepts(QtMsgType type) const
+{
+	return type == QtFatalMsg || severity(type) >= m_minimumSeverity.load(std::memory_order_relaxed);
+}
+
+QtMsgType AsyncLogWriter::levelFromString(const QString &name, QtMsgType fallback)
+{
+	const auto lower = name.trimmed().toLower();
+	if (lower == "debug")
+		return QtDebugMsg;
+	if (lower == "warning")
+		return QtWarningMsg;
+	if (lower == "critical")
+		return QtCriticalMsg;
+	if (lower == "fatal")
+		return QtFatalMsg;
+	if (lower == "info")
+		return QtMsgType(4);
+	return fallback;
+}
+
+QByteArray AsyncLogWriter::formatLine(QtMsgType type, qint64 timestamp, const QString &message)
+{
+	char buf[64] = {0};
+	::snprintf(buf, sizeof(buf), "%5lld.%03lld %c ", (long long)(timestamp / 1000),
+			   (long long)(timestamp % 1000), levelLetter(type));
+	QByteArray line(buf);
+	line.append(message.toUtf8());
+	line.append('\n');
+	return line;
+}
+
+void AsyncLogWriter::post(QtMsgType type, qint64 timestamp, const QString &message)
+{
+	if (!accepts(type))
+	{
+		return;
+	}
+	if (m_stopped.load())
+	{
+		// nobody is going to write the queue anymore
+		auto line = formatLine(type, timestamp, message);
+		fwrite(line.constData(), 1, line.size(), stderr);
+		fflush(stderr);
+		return;
+	}
+	auto entry = new Entry{type, timestamp, message, nullptr};
+	Entry *old = m_head.load(std::memory_order_relaxed);
+	do
+	{
+		entry->next = old;
+	} while (!m_head.compare_exchange_weak(old, entry, std::memory_order_release,
+										   std::memory_order_relaxed));
+	// only wake the writer when it may be sleeping on an empty queue
+	if (!old)
+	{
+		m_wakeup.release();
+	}
+}
+
+void AsyncLogWriter::drain()
+{
+	QMutexLocker locker(&m_writeLock);
+	Entry *entry = m_head.exchange(nullptr, std::memory_order_acquire);
+	if (!entry)
+	{
+		return;
+	}
+	// the queue is newest first, reverse it
+	Entry *ordered = nullptr;
+	while (entry)
+	{
+		auto next = entry->next;
+		entry->next = ordered;
+		ordered = entry;
+		entry = next;
+	}
+	QByteArray batch;
+	while (ordered)
+	{
+		batch.append(formatLine(ordered->type, ordered->timestamp, ordered->message));
+		auto next = ordered->next;
+		delete ordered;
+		ordered = next;
+	}
+	if (m_output && m_output->isOpen())
+	{
+		m_output->write(batch);
+		// QFileDevice buffers writes, make sure they hit the disk
+		auto file = dynamic_cast<QFileDevice *>(m_output.get());
+		if (file)
+		{
+			file->flush();
+		}
+	}
+	if (m_echoToStderr)
+	{
+		fwrite(batch.constData(), 1, batch.size(), stderr);
+		fflush(stderr);
+	}
+}
+
+void AsyncLogWriter::flush()
+{
+	drain();
+}
+
+void AsyncLogWriter::stop()
+{
+	if (m_stopped.exchange(true))
+	{
+		return;
+	}
+	if (isRunning())
+	{
+		m_wakeup.release();
+		wait();
+	}
+	drain();
+}
+
+void AsyncLogWriter::run()
+{
+	while (true)
+	{
+		m_wakeup.acquire();
+		// coalesce wakeups that happened while we were writing
+		m_wakeup.tryAcquire(m_wakeup.available());
+		drain();
+		if (m_stopped.load())
+		{
+			return;
+		}
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QThread>
+#include <QSemaphore>
+#include <QMutex>
+#include <QString>
+#include <QIODevice>
+#include <atomic>
+#include <memory>
+
+#include "multimc_logic_export.h"
+
+/**
+ * Writes log messages on a background thread.
+ *
+ * Messages are pushed onto a lock-free queue by whatever thread logs them and written out
+ * in batches by the writer thread, so logging never waits for disk or terminal I/O.
+ */
+class MULTIMC_LOGIC_EXPORT AsyncLogWriter : public QThread
+{
+public:
+	/// output is written to from the writer thread only. echoToStderr copies everything to stderr.
+	AsyncLogWriter(std::shared_ptr<QIODevice> output, bool echoToStderr);
+	virtual ~AsyncLogWriter();
+
+	/// messages less severe than level are dropped. Fatal messages are never dropped.
+	void setMinimumLevel(QtMsgType level);
+
+	/// true if a message of this type would be written
+	bool accepts(QtMsgType type) const;
+
+	/**
+	 * Queue a message for writing. Safe to call from any thread, does not block on I/O.
+	 * timestamp is in milliseconds since application start.
+	 */
+	void post(QtMsgType type, qint64 timestamp, const QString &message);
+
+	/// write out everything queued so far from the calling thread. Use when the process is about to die.
+	void flush();
+
+	/// stop the writer thread after writing out everything queued. Messages posted afterwards go to stderr.
+	void stop();
+
+	/// parse a level name (debug, info, warning, critical, fatal)
+	static QtMsgType levelFromString(const QString &name, QtMsgType fallback);
+
+	/// format a single log line the way the writer does
+	static QByteArray formatLine(QtMsgType type, qint64 timestamp, const QString &message);
+
+protected:
+	void run() override;
+
+private:
+	struct Entry
+	{
+		QtMsgType type;
+		qint64 timestamp;
+		QString message;
+		Entry *next;
+	};
+	/// take everything queued so far and write it out
+	void drain();
+
+private:
+	std::shared_ptr<QIODevice> m_output;
+	bool m_echoToStderr;
+	/// newest first, producers only ever push onto it
+	std::atomic<Entry *> m_head;
+	std::atomic<int> m_minimumSeverity;
+	std::atomic<bool> m_stopped;
+	/// released when the queue goes from empty to not empty
+	QSemaphore m_wakeup;
+	/// serializes writing between the writer thread and flush(). Recursive, because writing may log.
+	QMutex m_writeLock;
+};
@@ -25,6 +25,7 @@
 #include "minecraft/MinecraftVersionList.h"
 #include "icons/IconList.h"
 #include "FileSystem.h"
+#include "Trash.h"
 #include "Commandline.h"
 
 BaseInstance::BaseInstance(SettingsObjectPtr globalSettings, SettingsObjectPtr settings, const QString &rootDir)
@@ -51,6 +52,7 @@ BaseInstance::BaseInstance(SettingsObjectPtr globalSettings, SettingsObjectPtr s
 	m_settings->registerOverride(globalSettings->getSetting("ShowConsole"), consoleSetting);
 	m_settings->registerOverride(globalSettings->getSetting("AutoCloseConsole"), consoleSetting);
 	m_settings->registerOverride(globalSettings->getSetting("LogPrePostOutput"), consoleSetting);
+	m_settings->registerOverride(globalSettings->getSetting("SaveLaunchTrace"), consoleSetting);
 }
 
 QString BaseInstance::getPreLaunchCommand()
@@ -78,7 +80,11 @@ void BaseInstance::iconUpdated(QString key)
 
 void BaseInstance::nuke()
 {
-	FS::deletePath(instanceRoot());
+	// gone from the list right away, the files follow in the background
+	if (!Trash::move(instanceRoot()))
+	{
+		FS::deletePath(instanceRoot());
+	}
 	emit nuked(this);
 }
 
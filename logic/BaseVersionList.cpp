@@ -22,12 +22,47 @@ BaseVersionList::BaseVersionList(QObject *parent) : QAbstractListModel(parent)
 
 BaseVersionPtr BaseVersionList::findVersion(const QString &descriptor)
 {
-	for (int i = 0; i < count(); i++)
+	int row = findVersionRow(descriptor);
+	if (row < 0)
+		return BaseVersionPtr();
+	return at(row);
+}
+
+int BaseVersionList::findVersionRow(const QString &descriptor)
+{
+	if (m_indexedCount != count())
 	{
-		if (at(i)->descriptor() == descriptor)
-			return at(i);
+		rebuildIndex();
 	}
-	return BaseVersionPtr();
+	return m_descriptorIndex.value(descriptor, -1);
+}
+
+void BaseVersionList::rebuildIndex()
+{
+	const int size = count();
+	const bool hasParent = providesRoles().contains(ParentGameVersionRole);
+
+	m_descriptorIndex.clear();
+	m_descriptorIndex.reserve(size);
+	m_versionKeys.clear();
+	m_versionKeys.reserve(size);
+	m_parentVersionKeys.clear();
+	m_parentVersionKeys.reserve(size);
+
+	for (int i = 0; i < size; i++)
+	{
+		const QString descriptor = at(i)->descriptor();
+		if (!m_descriptorIndex.contains(descriptor))
+		{
+			m_descriptorIndex.insert(descriptor, i);
+		}
+		m_versionKeys.append(Version(descriptor));
+		if (hasParent)
+		{
+			m_parentVersionKeys.append(Version(data(index(i), ParentGameVersionRole).toString()));
+		}
+	}
+	m_indexedCount = size;
 }
 
 BaseVersionPtr BaseVersionList::getLatestStable() const
@@ -67,6 +102,16 @@ QVariant BaseVersionList::data(const QModelIndex &index, int role) const
 	case TypeRole:
 		return version->typeString();
 
+	case VersionKeyRole:
+		if (m_indexedCount == count() && index.row() < m_versionKeys.size())
+			return QVariant::fromValue(m_versionKeys[index.row()]);
+		return QVariant::fromValue(Version(version->descriptor()));
+
+	case ParentGameVersionKeyRole:
+		if (m_indexedCount == count() && index.row() < m_parentVersionKeys.size())
+			return QVariant::fromValue(m_parentVersionKeys[index.row()]);
+		return QVariant::fromValue(Version(data(index, ParentGameVersionRole).toString()));
+
 	default:
 		return QVariant();
 	}
@@ -18,8 +18,11 @@
 #include <QObject>
 #include <QVariant>
 #include <QAbstractListModel>
+#include <QHash>
+#include <QVector>
 
 #include "BaseVersion.h"
+#include "Version.h"
 #include "tasks/Task.h"
 #include "multimc_logic_export.h"
 
@@ -50,7 +53,9 @@ public:
 		TypeRole,
 		BranchRole,
 		PathRole,
-		ArchitectureRole
+		ArchitectureRole,
+		VersionKeyRole,
+		ParentGameVersionKeyRole
 	};
 	typedef QList<ModelRoles> RoleList;
 
@@ -90,6 +95,12 @@ public:
 	 */
 	virtual BaseVersionPtr findVersion(const QString &descriptor);
 
+	/*!
+	 * \brief Finds the row of a version by its descriptor.
+	 * \return The row of the version with the given descriptor, or -1 if it doesn't exist.
+	 */
+	int findVersionRow(const QString &descriptor);
+
 	/*!
 	 * \brief Gets the latest stable version from this list
 	 */
@@ -121,4 +132,21 @@ slots:
 	 * \param versions List of versions whose parents should be set.
 	 */
 	virtual void updateListData(QList<BaseVersionPtr> versions) = 0;
+
+protected:
+	/*!
+	 * Rebuilds the descriptor index and the parsed version keys.
+	 * Call this whenever the contents or the order of the list change (updateListData, sortVersions).
+	 * Lists that don't call it still work, the index is rebuilt on demand when the count doesn't match.
+	 */
+	void rebuildIndex();
+
+private:
+	/// descriptor -> row. If multiple versions share a descriptor, the first one wins.
+	QHash<QString, int> m_descriptorIndex;
+	/// parsed descriptors and parent game versions, by row
+	QVector<Version> m_versionKeys;
+	QVector<Version> m_parentVersionKeys;
+	/// number of rows the index was built for, -1 if it was never built
+	int m_indexedCount = -1;
 };
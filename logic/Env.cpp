@@ -1,5 +1,7 @@
 #include "Env.h"
 #include "net/HttpMetaCache.h"
+#include "java/JavaProbeCache.h"
+#include "minecraft/ModStore.h"
 #include "icons/IconList.h"
 #include "BaseVersion.h"
 #include "BaseVersionList.h"
@@ -22,6 +24,8 @@ Env::Env()
 void Env::destroy()
 {
 	m_metacache.reset();
+	m_javaProbeCache.reset();
+	m_modStore.reset();
 	m_qnam.reset();
 	m_icons.reset();
 	m_versionLists.clear();
@@ -39,6 +43,16 @@ std::shared_ptr< HttpMetaCache > Env::metacache()
 	return m_metacache;
 }
 
+std::shared_ptr<JavaProbeCache> Env::javaProbeCache()
+{
+	return m_javaProbeCache;
+}
+
+std::shared_ptr<ModStore> Env::modStore()
+{
+	return m_modStore;
+}
+
 std::shared_ptr< QNetworkAccessManager > Env::qnam()
 {
 	return m_qnam;
@@ -152,6 +166,16 @@ void Env::initHttpMetaCache()
 	m_metacache->Load();
 }
 
+void Env::initJavaProbeCache()
+{
+	m_javaProbeCache.reset(new JavaProbeCache("javacache"));
+}
+
+void Env::initModStore(const QString &root)
+{
+	m_modStore.reset(new ModStore(root));
+}
+
 void Env::updateProxySettings(QString proxyTypeStr, QString addr, int port, QString user, QString password)
 {
 	// Set the application proxy settings.
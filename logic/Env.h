@@ -9,8 +9,10 @@
 class IconList;
 class QNetworkAccessManager;
 class HttpMetaCache;
+class JavaProbeCache;
 class BaseVersionList;
 class BaseVersion;
+class ModStore;
 
 #if defined(ENV)
 	#undef ENV
@@ -34,9 +36,21 @@ public:
 
 	std::shared_ptr<IconList> icons();
 
+	/// may be null if initJavaProbeCache wasn't called
+	std::shared_ptr<JavaProbeCache> javaProbeCache();
+
 	/// init the cache. FIXME: possible future hook point
 	void initHttpMetaCache();
 
+	/// init the persistent cache of java probe results
+	void initJavaProbeCache();
+
+	/// null if mods are not shared between instances
+	std::shared_ptr<ModStore> modStore();
+
+	/// share mods between instances through a store at root
+	void initModStore(const QString &root);
+
 	/// Updates the application proxy settings from the settings object.
 	void updateProxySettings(QString proxyTypeStr, QString addr, int port, QString user, QString password);
 
@@ -51,5 +65,7 @@ protected:
 	std::shared_ptr<QNetworkAccessManager> m_qnam;
 	std::shared_ptr<HttpMetaCache> m_metacache;
 	std::shared_ptr<IconList> m_icons;
+	std::shared_ptr<JavaProbeCache> m_javaProbeCache;
+	std::shared_ptr<ModStore> m_modStore;
 	QMap<QString, std::shared_ptr<BaseVersionList>> m_versionLists;
 };
@@ -4,6 +4,7 @@
 
 #include <QDir>
 #include <QSaveFile>
+#include <QTemporaryFile>
 #include <QFileInfo>
 #include <QDebug>
 #include <QUrl>
@@ -192,7 +193,7 @@ bool deletePath(QString path)
 		}
 		else if (info.isFile())
 		{
-			OK &= QFile::remove(info.absoluteFilePath());
+			OK &= removeFile(info.absoluteFilePath());
 		}
 		else
 		{
@@ -204,6 +205,89 @@ bool deletePath(QString path)
 	return OK;
 }
 
+bool removeFile(const QString &path)
+{
+	if (QFile::remove(path))
+	{
+		return true;
+	}
+	auto permissions = QFile::permissions(path);
+	if (permissions & QFile::WriteOwner)
+	{
+		return false;
+	}
+	return QFile::setPermissions(path, permissions | QFile::WriteOwner) && QFile::remove(path);
+}
+
+#if !defined Q_OS_WIN32
+#include <cstdio>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+bool createHardLink(const QString &target, const QString &link)
+{
+#if defined Q_OS_WIN32
+	auto wTarget = QDir::toNativeSeparators(target).toStdWString();
+	auto wLink = QDir::toNativeSeparators(link).toStdWString();
+	return CreateHardLinkW(wLink.c_str(), wTarget.c_str(), nullptr) != 0;
+#else
+	return ::link(QFile::encodeName(target).constData(), QFile::encodeName(link).constData()) == 0;
+#endif
+}
+
+bool canHardLink(const QString &from, const QString &to)
+{
+	QTemporaryFile probe(PathCombine(from, ".mmc-link-probe-XXXXXX"));
+	if (!probe.open())
+	{
+		return false;
+	}
+	// closed, so the link can be removed again on Windows
+	probe.close();
+	auto link = PathCombine(to, QFileInfo(probe.fileName()).fileName());
+	if (!createHardLink(probe.fileName(), link))
+	{
+		return false;
+	}
+	QFile::remove(link);
+	return true;
+}
+
+int hardLinkCount(const QString &path)
+{
+#if defined Q_OS_WIN32
+	auto wPath = QDir::toNativeSeparators(path).toStdWString();
+	HANDLE handle = CreateFileW(wPath.c_str(), FILE_READ_ATTRIBUTES,
+								FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+								OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle == INVALID_HANDLE_VALUE)
+	{
+		return -1;
+	}
+	BY_HANDLE_FILE_INFORMATION info;
+	bool ok = GetFileInformationByHandle(handle, &info);
+	CloseHandle(handle);
+	return ok ? int(info.nNumberOfLinks) : -1;
+#else
+	struct stat info;
+	if (::stat(QFile::encodeName(path).constData(), &info) != 0)
+	{
+		return -1;
+	}
+	return int(info.st_nlink);
+#endif
+}
+
+bool replaceFile(const QString &from, const QString &to)
+{
+#if defined Q_OS_WIN32
+	auto wFrom = QDir::toNativeSeparators(from).toStdWString();
+	auto wTo = QDir::toNativeSeparators(to).toStdWString();
+	return MoveFileExW(wFrom.c_str(), wTo.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	return ::rename(QFile::encodeName(from).constData(), QFile::encodeName(to).constData()) == 0;
+#endif
+}
 
 QString PathCombine(QString path1, QString path2)
 {
@@ -79,6 +79,35 @@ private:
  */
 MULTIMC_LOGIC_EXPORT bool deletePath(QString path);
 
+/**
+ * Remove a file. Read-only files are made writable first if they can't be removed as they are,
+ * as Windows won't delete them otherwise.
+ */
+MULTIMC_LOGIC_EXPORT bool removeFile(const QString &path);
+
+/**
+ * Create a hard link at link, pointing to the same file as target
+ * Fails if link already exists or the file system can't do it (different volumes, FAT, ...)
+ */
+MULTIMC_LOGIC_EXPORT bool createHardLink(const QString &target, const QString &link);
+
+/**
+ * Whether a file in the folder from can get a hard link in the folder to, found out by trying.
+ * Both folders have to exist.
+ */
+MULTIMC_LOGIC_EXPORT bool canHardLink(const QString &from, const QString &to);
+
+/**
+ * Number of names the file at path has, counting path itself. -1 if it can't be found out.
+ */
+MULTIMC_LOGIC_EXPORT int hardLinkCount(const QString &path);
+
+/**
+ * Rename from to to, replacing to if it exists. There is no moment where to doesn't exist.
+ * If it fails, both files stay as they were.
+ */
+MULTIMC_LOGIC_EXPORT bool replaceFile(const QString &from, const QString &to);
+
 MULTIMC_LOGIC_EXPORT QString PathCombine(QString path1, QString path2);
 MULTIMC_LOGIC_EXPORT QString PathCombine(QString path1, QString path2, QString path3);
 
@@ -1,6 +1,7 @@
 #include "GZip.h"
 #include <zlib.h>
 #include <QByteArray>
+#include <QIODevice>
 
 bool GZip::unzip(const QByteArray &compressedBytes, QByteArray &uncompressedBytes)
 {
@@ -59,6 +60,54 @@ bool GZip::unzip(const QByteArray &compressedBytes, QByteArray &uncompressedByte
 	return true;
 }
 
+bool GZip::unzip(QIODevice &input, const std::function<bool(const char *, qint64)> &sink)
+{
+	z_stream strm;
+	memset(&strm, 0, sizeof(strm));
+	if (inflateInit2(&strm, (16 + MAX_WBITS)) != Z_OK)
+	{
+		return false;
+	}
+
+	const int chunkSize = 64 * 1024;
+	QByteArray in(chunkSize, Qt::Uninitialized);
+	QByteArray out(chunkSize, Qt::Uninitialized);
+	int err = Z_OK;
+	bool stopped = false;
+	bool outputFull = false;
+	while (err != Z_STREAM_END && !stopped)
+	{
+		// a full output buffer means zlib may still hold output for the input it already has
+		if (strm.avail_in == 0 && !outputFull)
+		{
+			auto got = input.read(in.data(), chunkSize);
+			if (got <= 0)
+			{
+				// truncated
+				break;
+			}
+			strm.next_in = (Bytef *)in.data();
+			strm.avail_in = got;
+		}
+		strm.next_out = (Bytef *)out.data();
+		strm.avail_out = chunkSize;
+		err = inflate(&strm, Z_NO_FLUSH);
+		// Z_BUF_ERROR only says nothing could be done without more input
+		if (err != Z_OK && err != Z_STREAM_END && err != Z_BUF_ERROR)
+		{
+			break;
+		}
+		outputFull = strm.avail_out == 0;
+		const qint64 produced = chunkSize - strm.avail_out;
+		if (produced && !sink(out.constData(), produced))
+		{
+			stopped = true;
+		}
+	}
+	inflateEnd(&strm);
+	return err == Z_STREAM_END || stopped;
+}
+
 bool GZip::zip(const QByteArray &uncompressedBytes, QByteArray &compressedBytes)
 {
 	if (uncompressedBytes.size() == 0)
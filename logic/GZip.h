@@ -1,5 +1,8 @@
 #pragma once
 #include <QByteArray>
+#include <functional>
+
+class QIODevice;
 
 #include "multimc_logic_export.h"
 
@@ -7,6 +10,8 @@ class MULTIMC_LOGIC_EXPORT GZip
 {
 public:
 	static bool unzip(const QByteArray &compressedBytes, QByteArray &uncompressedBytes);
+	/// decompress a stream in chunks, handing them to sink as they come. sink returns false to stop early.
+	static bool unzip(QIODevice &input, const std::function<bool(const char *, qint64)> &sink);
 	static bool zip(const QByteArray &uncompressedBytes, QByteArray &compressedBytes);
 };
 
@@ -0,0 +1,281 @@
+#include "IndexedLogFile.h"
+
+#include <QByteArrayMatcher>
+#include <QtConcurrentRun>
+#include <QMutexLocker>
+#include <algorithm>
+#include <cstring>
+
+#include "GZip.h"
+
+namespace
+{
+/// index this much at a time, so the first lines show up quickly
+const qint64 indexChunkSize = 4 * 1024 * 1024;
+/// search this much at a time, so case folding does not need a copy of the whole file
+const qint64 searchChunkSize = 16 * 1024 * 1024;
+
+void appendLineEnds(const char *base, qint64 from, qint64 to, QVector<qint64> &ends)
+{
+	const char *ptr = base + from;
+	const char *end = base + to;
+	while (ptr < end && (ptr = (const char *)memchr(ptr, '\n', end - ptr)))
+	{
+		ends.append(ptr - base);
+		ptr++;
+	}
+}
+}
+
+IndexedLogFile::IndexedLogFile(const QString &path, QObject *parent)
+	: QObject(parent), m_path(path), m_cancel(false), m_finished(false)
+{
+}
+
+IndexedLogFile::~IndexedLogFile()
+{
+	m_cancel = true;
+	m_future.waitForFinished();
+}
+
+void IndexedLogFile::start()
+{
+	if (m_future.isRunning() || m_finished)
+	{
+		return;
+	}
+	if (m_path.endsWith(".gz"))
+	{
+		m_decompressed.reset(new QTemporaryFile());
+	}
+	m_future = QtConcurrent::run([this]() { run(); });
+}
+
+bool IndexedLogFile::isFinished() const
+{
+	return m_finished;
+}
+
+QString IndexedLogFile::errorString() const
+{
+	QMutexLocker locker(&m_lock);
+	return m_error;
+}
+
+int IndexedLogFile::lineCount() const
+{
+	QMutexLocker locker(&m_lock);
+	return m_lineEnds.size();
+}
+
+qint64 IndexedLogFile::size() const
+{
+	QMutexLocker locker(&m_lock);
+	return m_size;
+}
+
+QByteArray IndexedLogFile::content() const
+{
+	QMutexLocker locker(&m_lock);
+	return QByteArray::fromRawData(m_data, m_size);
+}
+
+qint64 IndexedLogFile::lineStart(int index) const
+{
+	return index == 0 ? 0 : m_lineEnds[index - 1] + 1;
+}
+
+int IndexedLogFile::lineAt(qint64 offset) const
+{
+	QMutexLocker locker(&m_lock);
+	auto iter = std::lower_bound(m_lineEnds.begin(), m_lineEnds.end(), offset);
+	return iter - m_lineEnds.begin();
+}
+
+QString IndexedLogFile::line(int index) const
+{
+	qint64 start, end;
+	{
+		QMutexLocker locker(&m_lock);
+		if (index < 0 || index >= m_lineEnds.size())
+		{
+			return QString();
+		}
+		start = lineStart(index);
+		end = m_lineEnds[index];
+	}
+	if (end > start && m_data[end - 1] == '\r')
+	{
+		end--;
+	}
+	return QString::fromUtf8(m_data + start, end - start);
+}
+
+QVector<qint64> IndexedLogFile::indexLines(const char *data, qint64 size)
+{
+	QVector<qint64> ends;
+	appendLineEnds(data, 0, size, ends);
+	// the last line does not need a terminator
+	if (size > 0 && data[size - 1] != '\n')
+	{
+		ends.append(size);
+	}
+	return ends;
+}
+
+int IndexedLogFile::find(const QString &needle, int fromLine, Qt::CaseSensitivity cs) const
+{
+	if (needle.isEmpty())
+	{
+		return -1;
+	}
+	// byte-wise case folding only covers ASCII, but that is what logs mostly are
+	QByteArray pattern = needle.toUtf8();
+	if (cs == Qt::CaseInsensitive)
+	{
+		pattern = pattern.toLower();
+	}
+	qint64 indexedEnd;
+	int count;
+	{
+		QMutexLocker locker(&m_lock);
+		count = m_lineEnds.size();
+		if (count == 0)
+		{
+			return -1;
+		}
+		indexedEnd = m_lineEnds.last();
+		fromLine = qBound(0, fromLine, count - 1);
+	}
+	QByteArrayMatcher matcher(pattern);
+	auto search = [&](qint64 from, qint64 to) -> qint64
+	{
+		for (qint64 pos = from; pos < to; pos += searchChunkSize)
+		{
+			// overlap the chunks so matches across chunk boundaries are not missed
+			const qint64 length = qMin(searchChunkSize + pattern.size() - 1, to - pos);
+			if (length < pattern.size())
+			{
+				break;
+			}
+			int hit;
+			if (cs == Qt::CaseInsensitive)
+			{
+				hit = matcher.indexIn(QByteArray(m_data + pos, length).toLower());
+			}
+			else
+			{
+				hit = matcher.indexIn(m_data + pos, length);
+			}
+			if (hit != -1)
+			{
+				return pos + hit;
+			}
+		}
+		return -1;
+	};
+	qint64 start;
+	{
+		QMutexLocker locker(&m_lock);
+		start = lineStart(fromLine);
+	}
+	qint64 found = search(start, indexedEnd);
+	if (found == -1)
+	{
+		found = search(0, qMin(start + pattern.size() - 1, indexedEnd));
+	}
+	if (found == -1)
+	{
+		return -1;
+	}
+	return lineAt(found);
+}
+
+bool IndexedLogFile::mapContent()
+{
+	auto fail = [this](const QString &error)
+	{
+		QMutexLocker locker(&m_lock);
+		m_error = error;
+		return false;
+	};
+	QFile *source = &m_file;
+	if (m_decompressed)
+	{
+		QFile compressed(m_path);
+		if (!compressed.open(QIODevice::ReadOnly))
+		{
+			return fail(compressed.errorString());
+		}
+		if (!m_decompressed->open())
+		{
+			return fail(m_decompressed->errorString());
+		}
+		auto sink = [this](const char *data, qint64 length)
+		{
+			return !m_cancel && m_decompressed->write(data, length) == length;
+		};
+		if (!GZip::unzip(compressed, sink) || m_cancel)
+		{
+			return fail(tr("The file is not readable."));
+		}
+		m_decompressed->flush();
+		source = m_decompressed.get();
+	}
+	else
+	{
+		m_file.setFileName(m_path);
+		if (!m_file.open(QIODevice::ReadOnly))
+		{
+			return fail(m_file.errorString());
+		}
+	}
+	const qint64 size = source->size();
+	if (size == 0)
+	{
+		return true;
+	}
+	auto data = source->map(0, size);
+	if (!data)
+	{
+		return fail(source->errorString());
+	}
+	QMutexLocker locker(&m_lock);
+	m_data = (const char *)data;
+	m_size = size;
+	return true;
+}
+
+void IndexedLogFile::run()
+{
+	if (!mapContent())
+	{
+		m_finished = true;
+		emit finished();
+		return;
+	}
+	for (qint64 pos = 0; pos < m_size && !m_cancel; pos += indexChunkSize)
+	{
+		const qint64 end = qMin(pos + indexChunkSize, m_size);
+		QVector<qint64> ends;
+		appendLineEnds(m_data, pos, end, ends);
+		if (end == m_size && m_data[m_size - 1] != '\n')
+		{
+			ends.append(m_size);
+		}
+		if (ends.isEmpty())
+		{
+			continue;
+		}
+		int first, last;
+		{
+			QMutexLocker locker(&m_lock);
+			first = m_lineEnds.size();
+			m_lineEnds += ends;
+			last = m_lineEnds.size() - 1;
+		}
+		emit linesAdded(first, last);
+	}
+	m_finished = true;
+	emit finished();
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <QObject>
+#include <QFile>
+#include <QFuture>
+#include <QMutex>
+#include <QVector>
+#include <QTemporaryFile>
+#include <atomic>
+#include <memory>
+
+#include "multimc_logic_export.h"
+
+/**
+ * Read-only access to a possibly huge log file, line by line.
+ *
+ * The file is memory mapped instead of being read into memory. Gzipped logs are first
+ * decompressed into a temporary file, which is then mapped the same way. The line index is
+ * built in the background and grows while it is being built, see linesAdded().
+ */
+class MULTIMC_LOGIC_EXPORT IndexedLogFile : public QObject
+{
+	Q_OBJECT
+public:
+	explicit IndexedLogFile(const QString &path, QObject *parent = 0);
+	virtual ~IndexedLogFile();
+
+	QString path() const
+	{
+		return m_path;
+	}
+
+	/// decompress (if needed) and index the file in the background
+	void start();
+
+	/// true once the whole file is indexed
+	bool isFinished() const;
+
+	/// why the file could not be loaded, if it could not
+	QString errorString() const;
+
+	/// number of lines indexed so far
+	int lineCount() const;
+
+	/// a single line, without the line terminator
+	QString line(int index) const;
+
+	/// size of the (decompressed) content, in bytes
+	qint64 size() const;
+
+	/// the whole (decompressed) content. Does not copy, valid as long as this object lives.
+	QByteArray content() const;
+
+	/**
+	 * Find the next line at or after fromLine that contains needle. Wraps around.
+	 * Only looks at lines indexed so far. Returns -1 if there is no such line.
+	 */
+	int find(const QString &needle, int fromLine, Qt::CaseSensitivity cs) const;
+
+	/// split a buffer into lines the way the index does
+	static QVector<qint64> indexLines(const char *data, qint64 size);
+
+signals:
+	/// lines [first, last] were added to the index
+	void linesAdded(int first, int last);
+	/// indexing is done, or failed. See errorString()
+	void finished();
+
+private:
+	void run();
+	bool mapContent();
+	/// offset of the first byte of a line
+	qint64 lineStart(int index) const;
+	int lineAt(qint64 offset) const;
+
+private:
+	QString m_path;
+	QFile m_file;
+	std::unique_ptr<QTemporaryFile> m_decompressed;
+	const char *m_data = nullptr;
+	qint64 m_size = 0;
+
+	/// offset of the terminating newline (or end of content) of every indexed line
+	QVector<qint64> m_lineEnds;
+	mutable QMutex m_lock;
+	QString m_error;
+
+	QFuture<void> m_future;
+	std::atomic<bool> m_cancel;
+	std::atomic<bool> m_finished;
+};
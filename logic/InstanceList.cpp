@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include <QCoreApplication>
 #include <QDir>
 #include <QSet>
 #include <QFile>
@@ -34,11 +35,16 @@
 #include "minecraft/onesix/OneSixInstance.h"
 #include "minecraft/legacy/LegacyInstance.h"
 #include "minecraft/ftb/FTBPlugin.h"
+#include "minecraft/ftb/FTBDiscovery.h"
 #include "minecraft/MinecraftVersion.h"
 #include "settings/INISettingsObject.h"
 #include "NullInstance.h"
 #include "FileSystem.h"
 #include "pathmatcher/RegexpMatcher.h"
+#include "pathmatcher/CompiledMatcher.h"
+#include "pathmatcher/MultiMatcher.h"
+#include "minecraft/ModStore.h"
+#include "Env.h"
 
 const static int GROUP_FILE_FORMAT_VERSION = 1;
 
@@ -282,6 +288,9 @@ void InstanceList::loadGroupList(QMap<QString, QString> &groupMap)
 
 InstanceList::InstListError InstanceList::loadList()
 {
+	// anything still coming from a previous load is stale
+	m_ftbDiscovery.reset();
+
 	// load the instance groups
 	QMap<QString, QString> groupMap;
 	loadGroupList(groupMap);
@@ -304,9 +313,6 @@ InstanceList::InstListError InstanceList::loadList()
 		}
 	}
 
-	// FIXME: generalize
-	FTBPlugin::loadInstances(m_globalSettings, groupMap, tempList);
-
 	beginResetModel();
 	m_instances.clear();
 	for(auto inst: tempList)
@@ -321,6 +327,57 @@ InstanceList::InstListError InstanceList::loadList()
 	}
 	endResetModel();
 	emit dataIsInvalid();
+
+	// FIXME: generalize
+	m_ftbDiscovery.reset(FTBPlugin::createDiscovery(m_globalSettings));
+	if (m_ftbDiscovery)
+	{
+		auto ftbGroupMap = std::make_shared<QMap<QString, QString>>(groupMap);
+		// what the last run found is there right away, for selecting and launching by id
+		// keyed by instance folder, with the record each instance was made from
+		auto fromCache = std::make_shared<QMap<QString, QPair<FTBRecord, InstancePtr>>>();
+		for (auto &record : m_ftbDiscovery->cachedRecords())
+		{
+			auto inst = FTBPlugin::instanceFromRecord(m_globalSettings, *ftbGroupMap, record);
+			if (inst)
+			{
+				fromCache->insert(record.instanceDir, qMakePair(record, inst));
+				add(inst);
+			}
+		}
+		// queued through the discovery object, so nothing arrives once it is gone
+		connect(m_ftbDiscovery.get(), &FTBDiscovery::found, m_ftbDiscovery.get(),
+				[this, ftbGroupMap, fromCache](const FTBRecord &record)
+		{
+			auto cached = fromCache->take(record.instanceDir);
+			if (cached.second && cached.first == record)
+			{
+				return;
+			}
+			// new, or the modpack changed since the cache was written
+			auto inst = FTBPlugin::instanceFromRecord(m_globalSettings, *ftbGroupMap, record);
+			if (cached.second)
+			{
+				replace(cached.second.get(), inst);
+			}
+			else if (inst)
+			{
+				add(inst);
+			}
+		});
+		connect(m_ftbDiscovery.get(), &FTBDiscovery::finished, m_ftbDiscovery.get(),
+				[this, fromCache](int)
+		{
+			// cached, but not there anymore
+			for (auto &cached : *fromCache)
+			{
+				instanceNuked(cached.second.get());
+			}
+			fromCache->clear();
+			emit discoveryFinished();
+		});
+		m_ftbDiscovery->start();
+	}
 	return NoError;
 }
 
@@ -354,6 +411,43 @@ int InstanceList::add(InstancePtr t)
 	return count() - 1;
 }
 
+void InstanceList::replace(BaseInstance *old, InstancePtr t)
+{
+	int i = getInstIndex(old);
+	if (i == -1)
+	{
+		if (t)
+		{
+			add(t);
+		}
+		return;
+	}
+	if (!t)
+	{
+		instanceNuked(old);
+		return;
+	}
+	disconnect(old, 0, this, 0);
+	t->setParent(this);
+	connect(t.get(), SIGNAL(propertiesChanged(BaseInstance *)), this,
+			SLOT(propertiesChanged(BaseInstance *)));
+	connect(t.get(), SIGNAL(groupChanged()), this, SLOT(groupChanged()));
+	connect(t.get(), SIGNAL(nuked(BaseInstance *)), this, SLOT(instanceNuked(BaseInstance *)));
+	m_instances[i] = t;
+	emit dataChanged(index(i), index(i));
+}
+
+void InstanceList::waitForDiscovery()
+{
+	if (!m_ftbDiscovery)
+	{
+		return;
+	}
+	m_ftbDiscovery->waitForFinished();
+	// the results are queued to the discovery object, hand them over now
+	QCoreApplication::sendPostedEvents(m_ftbDiscovery.get(), QEvent::MetaCall);
+}
+
 InstancePtr InstanceList::getInstanceById(QString instId) const
 {
 	if(instId.isEmpty())
@@ -487,13 +581,22 @@ InstanceList::InstCreateError
 InstanceList::copyInstance(InstancePtr &newInstance, InstancePtr &oldInstance, const QString &instDir, bool copySaves)
 {
 	QDir rootDir(instDir);
-	std::unique_ptr<IPathMatcher> matcher;
+	auto blacklist = std::make_shared<MultiMatcher>();
 	if(!copySaves)
 	{
-		auto matcherReal = new RegexpMatcher("[.]?minecraft/saves");
+		auto matcherReal = std::make_shared<RegexpMatcher>("[.]?minecraft/saves");
 		matcherReal->caseSensitive(false);
-		matcher.reset(matcherReal);
+		blacklist->add(matcherReal);
 	}
+	// with the mod store, mod folders are linked instead of copied
+	auto store = ENV.modStore();
+	const auto modFolders = ModStore::instanceModFolders();
+	if(store)
+	{
+		blacklist->add(std::make_shared<RegexpMatcher>(
+			"^(" + modFolders.join('|').replace(".", "[.]") + ")(/|$)"));
+	}
+	auto matcher = CompiledMatcher::compile(blacklist);
 
 	qDebug() << instDir.toUtf8();
 	FS::copy folderCopy(oldInstance->instanceRoot(), instDir);
@@ -503,6 +606,20 @@ InstanceList::copyInstance(InstancePtr &newInstance, InstancePtr &oldInstance, c
 		FS::deletePath(instDir);
 		return InstanceList::CantCreateDir;
 	}
+	if(store)
+	{
+		for(auto &folder: modFolders)
+		{
+			auto source = FS::PathCombine(oldInstance->instanceRoot(), folder);
+			if(!QFileInfo(source).isDir())
+				continue;
+			if(!store->linkTree(source, FS::PathCombine(instDir, folder)))
+			{
+				FS::deletePath(instDir);
+				return InstanceList::CantCreateDir;
+			}
+		}
+	}
 
 	INISettingsObject settings_obj(FS::PathCombine(instDir, "instance.cfg"));
 	settings_obj.registerSetting("InstanceType", "Legacy");
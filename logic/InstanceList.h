@@ -23,6 +23,8 @@
 
 #include "multimc_logic_export.h"
 
+class FTBDiscovery;
+
 class BaseInstance;
 class QDir;
 
@@ -152,8 +154,16 @@ public:
 	 */
 	InstLoadError loadInstance(InstancePtr &inst, const QString &instDir);
 
+	/**
+	 * Wait for the instances that are found in the background and add them, without the event loop.
+	 * For when an instance is needed by id before the event loop runs.
+	 */
+	void waitForDiscovery();
+
 signals:
 	void dataIsInvalid();
+	/// all the instances found in the background have been added
+	void discoveryFinished();
 
 public
 slots:
@@ -172,6 +182,8 @@ slots:
 
 private:
 	int getInstIndex(BaseInstance *inst) const;
+	/// Swap an instance for a reloaded one, in place. Removes it if there is no replacement.
+	void replace(BaseInstance *old, InstancePtr t);
 
 public:
 	static bool continueProcessInstance(InstancePtr instPtr, const int error, const QDir &dir,
@@ -182,4 +194,6 @@ protected:
 	QList<InstancePtr> m_instances;
 	QSet<QString> m_groups;
 	SettingsObjectPtr m_globalSettings;
+	/// FTB instances are added by this as they are found
+	std::unique_ptr<FTBDiscovery> m_ftbDiscovery;
 };
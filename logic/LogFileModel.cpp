@@ -0,0 +1,65 @@
+#include "LogFileModel.h"
+#include "IndexedLogFile.h"
+
+LogFileModel::LogFileModel(QObject *parent) : QAbstractListModel(parent)
+{
+}
+
+LogFileModel::~LogFileModel()
+{
+}
+
+void LogFileModel::setFile(std::shared_ptr<IndexedLogFile> file)
+{
+	beginResetModel();
+	if (m_file)
+	{
+		disconnect(m_file.get(), &IndexedLogFile::linesAdded, this, &LogFileModel::linesAdded);
+	}
+	m_file = file;
+	m_rows = 0;
+	if (m_file)
+	{
+		// lines indexed before we got here show up right away
+		m_rows = m_file->lineCount();
+		connect(m_file.get(), &IndexedLogFile::linesAdded, this, &LogFileModel::linesAdded);
+	}
+	endResetModel();
+}
+
+int LogFileModel::rowCount(const QModelIndex &parent) const
+{
+	return parent.isValid() ? 0 : m_rows;
+}
+
+QVariant LogFileModel::data(const QModelIndex &index, int role) const
+{
+	if (!m_file || !index.isValid() || index.row() >= m_rows)
+	{
+		return QVariant();
+	}
+	if (role == Qt::DisplayRole)
+	{
+		auto line = m_file->line(index.row());
+		if (line.size() > maxLineLength)
+		{
+			line.truncate(maxLineLength);
+			line.append(QChar(0x2026));
+		}
+		return line;
+	}
+	return QVariant();
+}
+
+void LogFileModel::linesAdded(int first, int last)
+{
+	// the signal is queued, we may have picked these up in setFile already
+	if (last < m_rows)
+	{
+		return;
+	}
+	first = qMax(first, m_rows);
+	beginInsertRows(QModelIndex(), first, last);
+	m_rows = last + 1;
+	endInsertRows();
+}
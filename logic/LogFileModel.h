@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <memory>
+
+#include "multimc_logic_export.h"
+
+class IndexedLogFile;
+
+/**
+ * Lines of an IndexedLogFile as a list model.
+ *
+ * Rows are added as the file gets indexed. Text is only decoded for the rows a view asks for,
+ * so a view with uniform item sizes only ever touches what is visible.
+ */
+class MULTIMC_LOGIC_EXPORT LogFileModel : public QAbstractListModel
+{
+	Q_OBJECT
+public:
+	/// longer lines are cut off for display
+	static const int maxLineLength = 10000;
+
+	explicit LogFileModel(QObject *parent = 0);
+	virtual ~LogFileModel();
+
+	/// show a different file. The model shares ownership of it.
+	void setFile(std::shared_ptr<IndexedLogFile> file);
+	std::shared_ptr<IndexedLogFile> file() const
+	{
+		return m_file;
+	}
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+private slots:
+	void linesAdded(int first, int last);
+
+private:
+	std::shared_ptr<IndexedLogFile> m_file;
+	int m_rows = 0;
+};
@@ -0,0 +1,155 @@
+#include "LogSearch.h"
+
+#include <QByteArrayMatcher>
+#include <QFile>
+#include <QtConcurrentRun>
+
+#include "GZip.h"
+
+namespace
+{
+/// splits a stream into lines and checks each of them
+class LineScanner
+{
+public:
+	LineScanner(const QString &needle, Qt::CaseSensitivity cs, const LogSearch::MatchHandler &found)
+		: m_caseInsensitive(cs == Qt::CaseInsensitive), m_found(found)
+	{
+		auto pattern = needle.toUtf8();
+		m_matcher.setPattern(m_caseInsensitive ? pattern.toLower() : pattern);
+	}
+
+	bool feed(const char *data, qint64 length)
+	{
+		m_pending.append(data, length);
+		const QByteArray haystack = m_caseInsensitive ? m_pending.toLower() : m_pending;
+		int start = 0;
+		int end;
+		while ((end = haystack.indexOf('\n', start)) != -1)
+		{
+			if (!check(haystack, start, end))
+			{
+				return false;
+			}
+			start = end + 1;
+		}
+		m_pending.remove(0, start);
+		return true;
+	}
+
+	bool finish()
+	{
+		if (m_pending.isEmpty())
+		{
+			return true;
+		}
+		const QByteArray haystack = m_caseInsensitive ? m_pending.toLower() : m_pending;
+		return check(haystack, 0, haystack.size());
+	}
+
+private:
+	bool check(const QByteArray &haystack, int start, int end)
+	{
+		const int line = m_line++;
+		if (m_matcher.indexIn(haystack.constData() + start, end - start) == -1)
+		{
+			return true;
+		}
+		// report the original, not the case folded text
+		auto text = QString::fromUtf8(m_pending.constData() + start, end - start);
+		if (text.endsWith('\r'))
+		{
+			text.chop(1);
+		}
+		return m_found(line, text);
+	}
+
+private:
+	bool m_caseInsensitive;
+	const LogSearch::MatchHandler &m_found;
+	QByteArrayMatcher m_matcher;
+	QByteArray m_pending;
+	int m_line = 0;
+};
+}
+
+LogSearch::LogSearch(const QStringList &files, const QString &needle, Qt::CaseSensitivity cs,
+					 QObject *parent)
+	: QObject(parent), m_files(files), m_needle(needle), m_cs(cs), m_cancel(false)
+{
+}
+
+LogSearch::~LogSearch()
+{
+	cancel();
+	m_future.waitForFinished();
+}
+
+void LogSearch::start()
+{
+	m_future = QtConcurrent::run([this]() { run(); });
+}
+
+void LogSearch::cancel()
+{
+	m_cancel = true;
+}
+
+bool LogSearch::searchDevice(QIODevice &device, bool gzipped, const QString &needle,
+							 Qt::CaseSensitivity cs, const MatchHandler &found,
+							 const std::atomic<bool> *cancelled)
+{
+	LineScanner scanner(needle, cs, found);
+	bool stopped = false;
+	auto sink = [&](const char *data, qint64 length)
+	{
+		// checked for every chunk, a big file without matches would otherwise be read to the end
+		stopped = (cancelled && *cancelled) || !scanner.feed(data, length);
+		return !stopped;
+	};
+	if (gzipped)
+	{
+		if (!GZip::unzip(device, sink))
+		{
+			return false;
+		}
+	}
+	else
+	{
+		QByteArray buffer(256 * 1024, Qt::Uninitialized);
+		qint64 got;
+		while (!stopped && (got = device.read(buffer.data(), buffer.size())) > 0)
+		{
+			sink(buffer.constData(), got);
+		}
+	}
+	if (!stopped)
+	{
+		scanner.finish();
+	}
+	return true;
+}
+
+void LogSearch::run()
+{
+	int results = 0;
+	for (const auto &path : m_files)
+	{
+		if (m_cancel || results >= maxResults)
+		{
+			break;
+		}
+		QFile file(path);
+		if (!file.open(QIODevice::ReadOnly))
+		{
+			continue;
+		}
+		auto handler = [&](int line, const QString &text)
+		{
+			emit found(path, line, text);
+			return !m_cancel && ++results < maxResults;
+		};
+		searchDevice(file, path.endsWith(".gz"), m_needle, m_cs, handler, &m_cancel);
+	}
+	emit finished(results);
+}
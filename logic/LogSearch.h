@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QObject>
+#include <QFuture>
+#include <QStringList>
+#include <atomic>
+#include <functional>
+
+#include "multimc_logic_export.h"
+
+class QIODevice;
+
+/**
+ * Looks for lines containing a string in a set of log files, in the background.
+ *
+ * Files are read as a stream, gzipped ones are decompressed on the fly. Results are reported
+ * as they are found, with zero based line numbers.
+ */
+class MULTIMC_LOGIC_EXPORT LogSearch : public QObject
+{
+	Q_OBJECT
+public:
+	/// stop looking after this many matching lines
+	static const int maxResults = 1000;
+
+	LogSearch(const QStringList &files, const QString &needle, Qt::CaseSensitivity cs,
+			  QObject *parent = 0);
+	virtual ~LogSearch();
+
+	void start();
+	void cancel();
+
+	typedef std::function<bool(int line, const QString &text)> MatchHandler;
+	/**
+	 * Search a single stream. found is called for every matching line and returns false to stop.
+	 * Reading stops as soon as cancelled is set, matching or not.
+	 * Returns false if the stream could not be read.
+	 */
+	static bool searchDevice(QIODevice &device, bool gzipped, const QString &needle,
+							 Qt::CaseSensitivity cs, const MatchHandler &found,
+							 const std::atomic<bool> *cancelled = nullptr);
+
+signals:
+	void found(const QString &file, int line, const QString &text);
+	void finished(int results);
+
+private:
+	void run();
+
+private:
+	QStringList m_files;
+	QString m_needle;
+	Qt::CaseSensitivity m_cs;
+	QFuture<void> m_future;
+	std::atomic<bool> m_cancel;
+};
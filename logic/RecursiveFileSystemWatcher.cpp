@@ -1,15 +1,32 @@
 #include "RecursiveFileSystemWatcher.h"
 
 #include <QRegularExpression>
+#include <QSocketNotifier>
+#include <QTimer>
 #include <QDebug>
+#include <algorithm>
+
+#ifdef Q_OS_LINUX
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#endif
 
 RecursiveFileSystemWatcher::RecursiveFileSystemWatcher(QObject *parent)
-	: QObject(parent), m_watcher(new QFileSystemWatcher(this))
+	: QObject(parent), m_watcher(new QFileSystemWatcher(this)), m_batchTimer(new QTimer(this))
 {
 	connect(m_watcher, &QFileSystemWatcher::fileChanged, this,
 			&RecursiveFileSystemWatcher::fileChange);
 	connect(m_watcher, &QFileSystemWatcher::directoryChanged, this,
 			&RecursiveFileSystemWatcher::directoryChange);
+	m_batchTimer->setSingleShot(true);
+	connect(m_batchTimer, &QTimer::timeout, this, &RecursiveFileSystemWatcher::emitBatch);
+}
+
+RecursiveFileSystemWatcher::~RecursiveFileSystemWatcher()
+{
+	stopInotify();
 }
 
 void RecursiveFileSystemWatcher::setRootDir(const QDir &root)
@@ -34,6 +51,16 @@ void RecursiveFileSystemWatcher::setWatchFiles(const bool watchFiles)
 	}
 }
 
+void RecursiveFileSystemWatcher::setBatchInterval(int msec)
+{
+	m_batchInterval = msec;
+}
+
+void RecursiveFileSystemWatcher::setMaxBatchDelay(int msec)
+{
+	m_maxBatchDelay = msec;
+}
+
 void RecursiveFileSystemWatcher::enable()
 {
 	if (m_isEnabled)
@@ -41,7 +68,10 @@ void RecursiveFileSystemWatcher::enable()
 		return;
 	}
 	Q_ASSERT(m_root != QDir::root());
-	addFilesToWatcherRecursive(m_root);
+	if (!startInotify())
+	{
+		addFilesToWatcherRecursive(m_root);
+	}
 	m_isEnabled = true;
 }
 void RecursiveFileSystemWatcher::disable()
@@ -51,6 +81,14 @@ void RecursiveFileSystemWatcher::disable()
 		return;
 	}
 	m_isEnabled = false;
+	m_batchTimer->stop();
+	m_rescanPending = false;
+	m_changedFiles.clear();
+	if (m_inotifyFd != -1)
+	{
+		stopInotify();
+		return;
+	}
 	m_watcher->removePaths(m_watcher->files());
 	m_watcher->removePaths(m_watcher->directories());
 }
@@ -101,11 +139,292 @@ QStringList RecursiveFileSystemWatcher::scanRecursive(const QDir &directory)
 	return ret;
 }
 
+bool RecursiveFileSystemWatcher::scanOrderLessThan(const QString &a, const QString &b)
+{
+	const auto partsA = a.split('/');
+	const auto partsB = b.split('/');
+	for (int i = 0; i < partsA.size() && i < partsB.size(); i++)
+	{
+		// scanRecursive lists the contents of subdirectories before the files next to them
+		const bool aIsDir = i < partsA.size() - 1;
+		const bool bIsDir = i < partsB.size() - 1;
+		if (aIsDir != bIsDir)
+		{
+			return aIsDir;
+		}
+		const int result = QString::compare(partsA[i], partsB[i], Qt::CaseInsensitive);
+		if (result != 0)
+		{
+			return result < 0;
+		}
+	}
+	return partsA.size() < partsB.size();
+}
+
+void RecursiveFileSystemWatcher::scheduleBatch()
+{
+	if (!m_batchTimer->isActive())
+	{
+		m_batchAge.start();
+	}
+	// debounce: a burst of changes is reported once, after it settles down.
+	// A tree that never settles down is still reported every m_maxBatchDelay.
+	const qint64 left = m_maxBatchDelay - m_batchAge.elapsed();
+	m_batchTimer->start(int(qBound<qint64>(0, left, m_batchInterval)));
+}
+
+void RecursiveFileSystemWatcher::emitBatch()
+{
+	if (m_rescanPending)
+	{
+		m_rescanPending = false;
+		if (m_inotifyFd != -1)
+		{
+			// the kernel dropped events, start over
+			forgetDirectory(QString());
+			watchDirectoryRecursive(QString());
+			m_fileSetDirty = true;
+		}
+		else
+		{
+			setFiles(scanRecursive(m_root));
+		}
+	}
+	if (m_fileSetDirty)
+	{
+		m_fileSetDirty = false;
+		auto files = m_fileSet.toList();
+		std::sort(files.begin(), files.end(), scanOrderLessThan);
+		setFiles(files);
+	}
+	auto changed = m_changedFiles;
+	m_changedFiles.clear();
+	for (const auto &path : changed)
+	{
+		emit fileChanged(path);
+	}
+}
+
 void RecursiveFileSystemWatcher::fileChange(const QString &path)
 {
-	emit fileChanged(path);
+	m_changedFiles.insert(path);
+	scheduleBatch();
 }
 void RecursiveFileSystemWatcher::directoryChange(const QString &path)
 {
-	setFiles(scanRecursive(m_root));
+	m_rescanPending = true;
+	scheduleBatch();
+}
+
+#ifdef Q_OS_LINUX
+bool RecursiveFileSystemWatcher::startInotify()
+{
+	m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (m_inotifyFd == -1)
+	{
+		qWarning() << "Could not initialize inotify:" << strerror(errno);
+		return false;
+	}
+	m_notifier = new QSocketNotifier(m_inotifyFd, QSocketNotifier::Read, this);
+	connect(m_notifier, &QSocketNotifier::activated, this,
+			&RecursiveFileSystemWatcher::inotifyActivated);
+
+	// nothing was tracked while disabled, so this also picks up what changed since
+	m_fileSet.clear();
+	watchDirectoryRecursive(QString());
+	m_fileSetDirty = false;
+	auto files = m_fileSet.toList();
+	std::sort(files.begin(), files.end(), scanOrderLessThan);
+	setFiles(files);
+	return true;
+}
+
+void RecursiveFileSystemWatcher::stopInotify()
+{
+	if (m_inotifyFd == -1)
+	{
+		return;
+	}
+	delete m_notifier;
+	m_notifier = nullptr;
+	// closing the descriptor drops all the watches with it
+	close(m_inotifyFd);
+	m_inotifyFd = -1;
+	m_watchedDirs.clear();
+	m_fileSet.clear();
+	m_fileSetDirty = false;
+}
+
+void RecursiveFileSystemWatcher::watchDirectoryRecursive(const QString &relPath)
+{
+	const QDir dir(relPath.isEmpty() ? m_root.absolutePath() : m_root.absoluteFilePath(relPath));
+	uint32_t mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF |
+					IN_MOVE_SELF | IN_ONLYDIR;
+	if (m_watchFiles)
+	{
+		// events for the files come from the directory watch, no per-file watches needed
+		mask |= IN_MODIFY | IN_CLOSE_WRITE;
+	}
+	int wd = inotify_add_watch(m_inotifyFd, QFile::encodeName(dir.absolutePath()).constData(), mask);
+	if (wd == -1)
+	{
+		// ENOSPC means the user's watch limit is exhausted
+		qWarning() << "Could not watch" << dir.absolutePath() << ":" << strerror(errno);
+		return;
+	}
+	m_watchedDirs.insert(wd, relPath);
+
+	const auto prefix = relPath.isEmpty() ? QString() : relPath + '/';
+	for (const QFileInfo &info :
+		 dir.entryInfoList(QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot | QDir::Hidden))
+	{
+		const auto childPath = prefix + info.fileName();
+		if (info.isDir())
+		{
+			watchDirectoryRecursive(childPath);
+		}
+		else if (m_matcher && m_matcher->matches(childPath))
+		{
+			m_fileSet.insert(childPath);
+		}
+	}
+}
+
+void RecursiveFileSystemWatcher::forgetDirectory(const QString &relPath)
+{
+	const auto prefix = relPath.isEmpty() ? QString() : relPath + '/';
+	auto iter = m_watchedDirs.begin();
+	while (iter != m_watchedDirs.end())
+	{
+		if (iter.value() == relPath || iter.value().startsWith(prefix))
+		{
+			inotify_rm_watch(m_inotifyFd, iter.key());
+			iter = m_watchedDirs.erase(iter);
+		}
+		else
+		{
+			iter++;
+		}
+	}
+	auto fileIter = m_fileSet.begin();
+	while (fileIter != m_fileSet.end())
+	{
+		if (fileIter->startsWith(prefix))
+		{
+			fileIter = m_fileSet.erase(fileIter);
+		}
+		else
+		{
+			fileIter++;
+		}
+	}
+}
+
+void RecursiveFileSystemWatcher::inotifyActivated()
+{
+	alignas(struct inotify_event) char buffer[16384];
+	bool changed = false;
+	while (true)
+	{
+		const ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+		if (length <= 0)
+		{
+			break;
+		}
+		for (char *ptr = buffer; ptr < buffer + length;)
+		{
+			const auto event = reinterpret_cast<const struct inotify_event *>(ptr);
+			ptr += sizeof(struct inotify_event) + event->len;
+
+			if (event->mask & IN_Q_OVERFLOW)
+			{
+				m_rescanPending = true;
+				changed = true;
+				continue;
+			}
+			if (event->mask & IN_IGNORED)
+			{
+				m_watchedDirs.remove(event->wd);
+				continue;
+			}
+			auto dirIter = m_watchedDirs.constFind(event->wd);
+			if (dirIter == m_watchedDirs.constEnd())
+			{
+				// already forgotten
+				continue;
+			}
+			const QString dirPath = dirIter.value();
+			if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF))
+			{
+				// subdirectories are handled through their parent, only the root matters here
+				if (dirPath.isEmpty())
+				{
+					forgetDirectory(dirPath);
+					m_fileSetDirty = true;
+					changed = true;
+				}
+				continue;
+			}
+			if (!event->len)
+			{
+				continue;
+			}
+			const auto name = QFile::decodeName(event->name);
+			const auto path = dirPath.isEmpty() ? name : dirPath + '/' + name;
+			if (event->mask & IN_ISDIR)
+			{
+				if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+				{
+					forgetDirectory(path);
+				}
+				if (event->mask & (IN_CREATE | IN_MOVED_TO))
+				{
+					// may already have contents, if it was moved here or filled quickly
+					watchDirectoryRecursive(path);
+				}
+				m_fileSetDirty = true;
+				changed = true;
+				continue;
+			}
+			if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+			{
+				m_fileSetDirty |= m_fileSet.remove(path);
+			}
+			if (event->mask & (IN_CREATE | IN_MOVED_TO))
+			{
+				if (m_matcher && m_matcher->matches(path))
+				{
+					m_fileSet.insert(path);
+					m_fileSetDirty = true;
+				}
+			}
+			if (event->mask & (IN_MODIFY | IN_CLOSE_WRITE))
+			{
+				m_changedFiles.insert(m_root.absoluteFilePath(path));
+			}
+			changed = true;
+		}
+	}
+	if (changed)
+	{
+		scheduleBatch();
+	}
+}
+#else
+bool RecursiveFileSystemWatcher::startInotify()
+{
+	return false;
+}
+void RecursiveFileSystemWatcher::stopInotify()
+{
+}
+void RecursiveFileSystemWatcher::watchDirectoryRecursive(const QString &)
+{
+}
+void RecursiveFileSystemWatcher::forgetDirectory(const QString &)
+{
+}
+void RecursiveFileSystemWatcher::inotifyActivated()
+{
 }
+#endif
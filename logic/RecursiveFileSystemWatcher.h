@@ -2,15 +2,29 @@
 
 #include <QFileSystemWatcher>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QSet>
 #include "pathmatcher/IPathMatcher.h"
 
 #include "multimc_logic_export.h"
 
+class QSocketNotifier;
+class QTimer;
+
+/**
+ * Keeps a list of the files below a directory that match a filter.
+ *
+ * On Linux, this uses a single inotify descriptor with one watch per directory and updates
+ * the list from the events themselves. Elsewhere, it uses QFileSystemWatcher and rescans.
+ * Either way, changes are collected for a short while and reported in batches.
+ */
 class MULTIMC_LOGIC_EXPORT RecursiveFileSystemWatcher : public QObject
 {
 	Q_OBJECT
 public:
 	RecursiveFileSystemWatcher(QObject *parent);
+	virtual ~RecursiveFileSystemWatcher();
 
 	void setRootDir(const QDir &root);
 	QDir rootDir() const
@@ -18,7 +32,7 @@ public:
 		return m_root;
 	}
 
-	// WARNING: setting this to true may be bad for performance
+	// WARNING: setting this to true may be bad for performance, unless inotify is used
 	void setWatchFiles(const bool watchFiles);
 	bool watchFiles() const
 	{
@@ -35,6 +49,15 @@ public:
 		return m_files;
 	}
 
+	/// how long changes are collected before being reported, in milliseconds
+	void setBatchInterval(int msec);
+
+	/// the longest a change waits to be reported while more keep coming, in milliseconds
+	void setMaxBatchDelay(int msec);
+
+	/// the order files() uses: depth first, directories before files, names ignoring case
+	static bool scanOrderLessThan(const QString &a, const QString &b);
+
 signals:
 	void filesChanged();
 	void fileChanged(const QString &path);
@@ -57,7 +80,33 @@ private:
 	void addFilesToWatcherRecursive(const QDir &dir);
 	QStringList scanRecursive(const QDir &dir);
 
+	/// changes waiting for the batch timer
+	QTimer *m_batchTimer;
+	int m_batchInterval = 200;
+	int m_maxBatchDelay = 1000;
+	/// since the oldest change in the current batch
+	QElapsedTimer m_batchAge;
+	bool m_rescanPending = false;
+	QSet<QString> m_changedFiles;
+	void scheduleBatch();
+
+	/// inotify backend, Linux only
+	int m_inotifyFd = -1;
+	QSocketNotifier *m_notifier = nullptr;
+	/// watch descriptor -> directory relative to the root ("" is the root)
+	QHash<int, QString> m_watchedDirs;
+	/// files() as a set, kept up to date from the events
+	QSet<QString> m_fileSet;
+	bool m_fileSetDirty = false;
+
+	bool startInotify();
+	void stopInotify();
+	void watchDirectoryRecursive(const QString &relPath);
+	void forgetDirectory(const QString &relPath);
+
 private slots:
 	void fileChange(const QString &path);
 	void directoryChange(const QString &path);
+	void inotifyActivated();
+	void emitBatch();
 };
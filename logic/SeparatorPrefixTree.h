@@ -82,6 +82,30 @@ public:
 		}
 	}
 
+	/// same as covers(QString), without making any copies of the path
+	bool covers(const QStringRef &path) const
+	{
+		if(m_contained)
+		{
+			return true;
+		}
+		auto sepIndex = path.indexOf(Tseparator);
+		auto prefix = sepIndex == -1 ? path : path.left(sepIndex);
+		// QMap can't look up a QStringRef, but the nodes do not have many children
+		for(auto iter = children.begin(); iter != children.end(); iter++)
+		{
+			if(iter.key() == prefix)
+			{
+				if(sepIndex == -1)
+				{
+					return (*iter).covers(QStringRef());
+				}
+				return (*iter).covers(path.mid(sepIndex + 1));
+			}
+		}
+		return false;
+	}
+
 	/// return the contained path that covers the path specified
 	QString cover(QString path) const
 	{
@@ -0,0 +1,122 @@
+#include "StartupScheduler.h"
+
+#include <QDebug>
+
+StartupScheduler::StartupScheduler(QObject *parent) : QObject(parent)
+{
+	m_clock.start();
+	// a zero timer fires when all pending events have been processed
+	m_idleTimer.setSingleShot(true);
+	m_idleTimer.setInterval(0);
+	connect(&m_idleTimer, &QTimer::timeout, this, &StartupScheduler::runNext);
+	m_holdBackTimer.setSingleShot(true);
+	connect(&m_holdBackTimer, &QTimer::timeout, this, &StartupScheduler::holdBackExpired);
+}
+
+void StartupScheduler::setMaxHoldBack(int msecs)
+{
+	if (m_criticalPathDone)
+	{
+		return;
+	}
+	m_holdBackTimer.start(qMax<qint64>(0, msecs - m_clock.elapsed()));
+}
+
+qint64 StartupScheduler::elapsed() const
+{
+	return m_clock.elapsed();
+}
+
+QStringList StartupScheduler::summary() const
+{
+	return m_summary;
+}
+
+void StartupScheduler::record(const QString &line)
+{
+	qDebug() << "Startup:" << line;
+	m_summary.append(line);
+}
+
+void StartupScheduler::phaseDone(const QString &name)
+{
+	const qint64 now = m_clock.elapsed();
+	record(QString("%1 took %2 ms").arg(name).arg(now - m_lastPhaseEnd));
+	m_lastPhaseEnd = now;
+}
+
+void StartupScheduler::criticalPathDone()
+{
+	if (m_criticalPathDone)
+	{
+		return;
+	}
+	m_criticalPathDone = true;
+	m_holdBackTimer.stop();
+	record(QString("critical path done after %1 ms").arg(m_clock.elapsed()));
+	release();
+}
+
+void StartupScheduler::holdBackExpired()
+{
+	qWarning() << "Startup critical path still not done after" << m_clock.elapsed()
+			   << "ms, starting deferred jobs anyway";
+	release();
+}
+
+void StartupScheduler::release()
+{
+	if (m_released)
+	{
+		return;
+	}
+	m_released = true;
+	if (!m_jobs.isEmpty())
+	{
+		m_idleTimer.start();
+	}
+}
+
+void StartupScheduler::defer(const QString &name, int priority, QObject *context,
+							 std::function<void()> job)
+{
+	// after all the jobs with the same or higher priority
+	auto iter = m_jobs.begin();
+	while (iter != m_jobs.end() && iter->priority >= priority)
+	{
+		iter++;
+	}
+	m_jobs.insert(iter, {name, priority, context != nullptr, context, job});
+	if (m_released && !m_idleTimer.isActive())
+	{
+		m_idleTimer.start();
+	}
+}
+
+void StartupScheduler::runNext()
+{
+	if (m_jobs.isEmpty())
+	{
+		return;
+	}
+	auto job = m_jobs.takeFirst();
+	if (!job.guarded || job.context)
+	{
+		QElapsedTimer timer;
+		timer.start();
+		job.run();
+		record(QString("%1 started at %2 ms, took %3 ms")
+				   .arg(job.name)
+				   .arg(m_clock.elapsed() - timer.elapsed())
+				   .arg(timer.elapsed()));
+	}
+	if (m_jobs.isEmpty())
+	{
+		emit idle();
+	}
+	else
+	{
+		// one job per pass, so input and painting get their turn in between
+		m_idleTimer.start();
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QStringList>
+#include <QTimer>
+#include <functional>
+
+#include "multimc_logic_export.h"
+
+/**
+ * Keeps the work done while starting up out of the way of the things the user is waiting for.
+ *
+ * Startup is split into the critical path (a sequence of phases, like loading settings and
+ * instances, ending with the first paint of the main window) and deferred jobs. The phases are
+ * timed and logged, not limited: they run synchronously, as everything after them needs their
+ * results. Deferred jobs do not start before the critical path is done, and then run one at a
+ * time, highest priority first, whenever the event loop has nothing else to do.
+ *
+ * So a slow critical path doesn't hold them back forever, the deferred jobs can be given a time
+ * after which they start anyway, see setMaxHoldBack().
+ */
+class MULTIMC_LOGIC_EXPORT StartupScheduler : public QObject
+{
+	Q_OBJECT
+public:
+	enum Priority
+	{
+		Low = 0,
+		Normal = 50,
+		High = 100
+	};
+
+	explicit StartupScheduler(QObject *parent = 0);
+	virtual ~StartupScheduler() {};
+
+	/// deferred jobs wait for the critical path at most until this many milliseconds since creation
+	void setMaxHoldBack(int msecs);
+
+	/// a critical path phase ended. It started where the previous one ended.
+	void phaseDone(const QString &name);
+
+	/// the critical path is over, deferred jobs can start once the event loop is idle
+	void criticalPathDone();
+
+	bool isCriticalPathDone() const
+	{
+		return m_criticalPathDone;
+	}
+
+	/**
+	 * Queue a job to run after the critical path. Jobs with the same priority run in the order
+	 * they were deferred. If context is given and destroyed before the job runs, the job is dropped.
+	 */
+	void defer(const QString &name, int priority, QObject *context, std::function<void()> job);
+
+	/// number of deferred jobs that did not run yet
+	int pendingJobs() const
+	{
+		return m_jobs.size();
+	}
+
+	/// milliseconds since the scheduler was created
+	qint64 elapsed() const;
+
+	/// one line per finished phase and job
+	QStringList summary() const;
+
+signals:
+	/// all deferred jobs ran
+	void idle();
+
+private slots:
+	void runNext();
+	void holdBackExpired();
+
+private:
+	void release();
+	void record(const QString &line);
+
+private:
+	struct Job
+	{
+		QString name;
+		int priority;
+		bool guarded;
+		QPointer<QObject> context;
+		std::function<void()> run;
+	};
+	QList<Job> m_jobs;
+	QElapsedTimer m_clock;
+	qint64 m_lastPhaseEnd = 0;
+	bool m_criticalPathDone = false;
+	bool m_released = false;
+	QTimer m_idleTimer;
+	QTimer m_holdBackTimer;
+	QStringList m_summary;
+};
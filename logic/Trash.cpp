@@ -0,0 +1,243 @@
+#include "Trash.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QFuture>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStringList>
+#include <QThread>
+#include <QtConcurrentRun>
+#include <atomic>
+
+#include "FileSystem.h"
+
+#if !defined Q_OS_WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#if defined Q_OS_LINUX
+#include <sys/syscall.h>
+#endif
+
+namespace
+{
+const char *trashName = ".trash";
+
+QMutex queueLock;
+QStringList queue;
+QString current;
+bool working = false;
+QFuture<void> worker;
+std::atomic<bool> stopping(false);
+
+/// lowers the CPU and I/O priority of the current thread while it exists
+class LowPriority
+{
+public:
+	LowPriority()
+	{
+		m_thread = QThread::currentThread();
+		m_priority = m_thread->priority();
+		m_thread->setPriority(QThread::LowestPriority);
+#if defined Q_OS_LINUX && defined SYS_ioprio_set
+		// IOPRIO_WHO_PROCESS with 0 is the calling thread, IOPRIO_CLASS_IDLE is 3 << IOPRIO_CLASS_SHIFT
+		m_ioPriority = syscall(SYS_ioprio_get, 1, 0);
+		syscall(SYS_ioprio_set, 1, 0, 3 << 13);
+#endif
+	}
+	~LowPriority()
+	{
+#if defined Q_OS_LINUX && defined SYS_ioprio_set
+		if (m_ioPriority >= 0)
+		{
+			syscall(SYS_ioprio_set, 1, 0, m_ioPriority);
+		}
+#endif
+		// pool threads start out inheriting, which can't be set back
+		m_thread->setPriority(m_priority == QThread::InheritPriority ? QThread::NormalPriority : m_priority);
+	}
+
+private:
+	QThread *m_thread;
+	QThread::Priority m_priority;
+	long m_ioPriority = -1;
+};
+
+void work()
+{
+	LowPriority priority;
+	while (true)
+	{
+		QString path;
+		{
+			QMutexLocker locker(&queueLock);
+			if (queue.isEmpty() || stopping)
+			{
+				current.clear();
+				working = false;
+				return;
+			}
+			current = path = queue.takeFirst();
+		}
+		if (!Trash::deleteTree(path) && !stopping)
+		{
+			qWarning() << "Couldn't delete everything in" << path;
+		}
+	}
+}
+
+void enqueue(const QString &path)
+{
+	QMutexLocker locker(&queueLock);
+	if (path == current || queue.contains(path))
+	{
+		return;
+	}
+	queue.append(path);
+	if (!working && !stopping)
+	{
+		working = true;
+		worker = QtConcurrent::run(work);
+	}
+}
+
+#if !defined Q_OS_WIN32
+/// removes everything in the directory open as fd, and closes fd
+bool removeContents(int fd)
+{
+	DIR *dir = fdopendir(fd);
+	if (!dir)
+	{
+		::close(fd);
+		return false;
+	}
+	bool OK = true;
+	while (auto entry = readdir(dir))
+	{
+		if (stopping)
+		{
+			OK = false;
+			break;
+		}
+		const char *name = entry->d_name;
+		if (qstrcmp(name, ".") == 0 || qstrcmp(name, "..") == 0)
+		{
+			continue;
+		}
+		bool isDir = entry->d_type == DT_DIR;
+		if (entry->d_type == DT_UNKNOWN)
+		{
+			struct stat info;
+			isDir = fstatat(fd, name, &info, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(info.st_mode);
+		}
+		if (isDir)
+		{
+			int inner = openat(fd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+			if (inner < 0)
+			{
+				OK = false;
+				continue;
+			}
+			OK &= removeContents(inner);
+			OK &= unlinkat(fd, name, AT_REMOVEDIR) == 0;
+		}
+		else
+		{
+			// symlinks are removed, never followed
+			OK &= unlinkat(fd, name, 0) == 0;
+		}
+	}
+	closedir(dir);
+	return OK;
+}
+#endif
+}
+
+namespace Trash
+{
+bool move(const QString &path)
+{
+	QFileInfo info(path);
+	if (!info.exists())
+	{
+		return false;
+	}
+	// next to the original, so the rename never crosses volumes
+	QDir trash(FS::PathCombine(info.absolutePath(), trashName));
+	if (!trash.mkpath("."))
+	{
+		return false;
+	}
+	auto target = trash.absoluteFilePath(
+		QString("%1-%2").arg(info.fileName()).arg(QDateTime::currentMSecsSinceEpoch()));
+	if (!QDir().rename(info.absoluteFilePath(), target))
+	{
+		return false;
+	}
+	enqueue(target);
+	return true;
+}
+
+void resume(const QString &folder)
+{
+	QDir trash(FS::PathCombine(folder, trashName));
+	for (auto &entry : trash.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System))
+	{
+		qDebug() << "Deleting leftover" << entry.absoluteFilePath();
+		enqueue(entry.absoluteFilePath());
+	}
+}
+
+bool deleteTree(const QString &path)
+{
+	QFileInfo info(path);
+	if (info.isSymLink() || info.isFile())
+	{
+		return QFile::remove(path);
+	}
+	if (!info.exists())
+	{
+		return true;
+	}
+#if defined Q_OS_WIN32
+	return FS::deletePath(path);
+#else
+	auto encoded = QFile::encodeName(path);
+	int fd = ::open(encoded.constData(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+	if (fd < 0)
+	{
+		return false;
+	}
+	bool OK = removeContents(fd);
+	OK &= ::rmdir(encoded.constData()) == 0;
+	return OK;
+#endif
+}
+
+void waitForFinished()
+{
+	while (true)
+	{
+		QFuture<void> running;
+		{
+			QMutexLocker locker(&queueLock);
+			if (!working)
+			{
+				return;
+			}
+			running = worker;
+		}
+		running.waitForFinished();
+	}
+}
+
+void stop()
+{
+	stopping = true;
+}
+}
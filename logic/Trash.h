@@ -0,0 +1,30 @@
+#pragma once
+
+#include <QString>
+
+#include "multimc_logic_export.h"
+
+/**
+ * Deleting big folders without waiting for it.
+ *
+ * A folder is first renamed into a '.trash' folder next to it, which is instant. The files are then
+ * removed on a background worker with low CPU and I/O priority. Whatever is left in a trash folder
+ * when the application exits is picked up again by resume().
+ */
+namespace Trash
+{
+/// rename path into the trash and delete it in the background. false if it couldn't be renamed
+MULTIMC_LOGIC_EXPORT bool move(const QString &path);
+
+/// delete what is still in the trash of folder from an earlier run
+MULTIMC_LOGIC_EXPORT void resume(const QString &folder);
+
+/// delete a folder tree right away, without following links
+MULTIMC_LOGIC_EXPORT bool deleteTree(const QString &path);
+
+/// wait until everything moved to the trash so far is gone
+MULTIMC_LOGIC_EXPORT void waitForFinished();
+
+/// make the worker stop at the next file, for quitting. The rest is left for resume()
+MULTIMC_LOGIC_EXPORT void stop();
+}
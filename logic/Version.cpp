@@ -89,52 +89,77 @@ bool versionIsInInterval(const QString &version, const QString &interval)
 }
 bool versionIsInInterval(const Version &version, const QString &interval)
 {
-	if (interval.isEmpty() || version.toString() == interval)
+	return VersionInterval(interval).contains(version);
+}
+
+VersionInterval::VersionInterval(const QString &interval) : m_string(interval)
+{
+	if (interval.isEmpty())
 	{
-		return true;
+		return;
 	}
 
 	// Interval notation is used
-	QRegularExpression exp(
+	static const QRegularExpression exp(
 		"(?<start>[\\[\\]\\(\\)])(?<bottom>.*?)(,(?<top>.*?))?(?<end>[\\[\\]\\(\\)]),?");
 	QRegularExpressionMatch match = exp.match(interval);
 	if (match.hasMatch())
 	{
-		const QChar start = match.captured("start").at(0);
-		const QChar end = match.captured("end").at(0);
+		m_valid = true;
+		m_start = match.captured("start").at(0);
+		m_end = match.captured("end").at(0);
 		const QString bottom = match.captured("bottom");
 		const QString top = match.captured("top");
-
-		// check if in range (bottom)
 		if (!bottom.isEmpty())
 		{
-			const auto bottomVersion = Version(bottom);
-			if ((start == '[') && !(version >= bottomVersion))
-			{
-				return false;
-			}
-			else if ((start == '(') && !(version > bottomVersion))
-			{
-				return false;
-			}
+			m_hasBottom = true;
+			m_bottom = Version(bottom);
 		}
-
-		// check if in range (top)
 		if (!top.isEmpty())
 		{
-			const auto topVersion = Version(top);
-			if ((end == ']') && !(version <= topVersion))
-			{
-				return false;
-			}
-			else if ((end == ')') && !(version < topVersion))
-			{
-				return false;
-			}
+			m_hasTop = true;
+			m_top = Version(top);
 		}
+	}
+}
 
+bool VersionInterval::contains(const Version &version) const
+{
+	if (m_string.isEmpty() || version.toString() == m_string)
+	{
 		return true;
 	}
 
-	return false;
+	if (!m_valid)
+	{
+		return false;
+	}
+
+	// check if in range (bottom)
+	if (m_hasBottom)
+	{
+		if ((m_start == '[') && !(version >= m_bottom))
+		{
+			return false;
+		}
+		else if ((m_start == '(') && !(version > m_bottom))
+		{
+			return false;
+		}
+	}
+
+	// check if in range (top)
+	if (m_hasTop)
+	{
+		if ((m_end == ']') && !(version <= m_top))
+		{
+			return false;
+		}
+		else if ((m_end == ')') && !(version < m_top))
+		{
+			return false;
+		}
+	}
+
+	return true;
 }
@@ -2,6 +2,7 @@
 
 #include <QString>
 #include <QList>
+#include <QMetaType>
 
 #include "multimc_logic_export.h"
 
@@ -105,6 +106,36 @@ private:
 	void parse();
 };
 
+Q_DECLARE_METATYPE(Version)
+
+/**
+ * A version interval in maven notation ("[1.2,1.3)", "(,1.7.10]", ...), parsed once.
+ * Use this instead of versionIsInInterval when checking many versions against the same interval.
+ */
+class MULTIMC_LOGIC_EXPORT VersionInterval
+{
+public:
+	VersionInterval() {}
+	explicit VersionInterval(const QString &interval);
+
+	bool contains(const Version &version) const;
+
+	QString toString() const
+	{
+		return m_string;
+	}
+
+private:
+	QString m_string;
+	bool m_valid = false;
+	QChar m_start;
+	QChar m_end;
+	bool m_hasBottom = false;
+	bool m_hasTop = false;
+	Version m_bottom;
+	Version m_top;
+};
+
 MULTIMC_LOGIC_EXPORT bool versionIsInInterval(const QString &version, const QString &interval);
 MULTIMC_LOGIC_EXPORT bool versionIsInInterval(const Version &version, const QString &interval);
 
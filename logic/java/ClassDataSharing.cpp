@@ -0,0 +1,86 @@
+#include "ClassDataSharing.h"
+#include "JavaVersion.h"
+#include <FileSystem.h>
+
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDir>
+#include <QDebug>
+
+bool ClassDataSharing::isSupported(const QString &javaVersion)
+{
+	return JavaVersion(javaVersion).supportsDynamicCDS();
+}
+
+QString ClassDataSharing::fingerprint(const QString &javaPath, const QString &javaVersion, const QStringList &classPath,
+									 const QStringList &inputs)
+{
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	auto addPath = [&hash](const QFileInfo &info)
+	{
+		QString canonical = info.canonicalFilePath();
+		if (canonical.isEmpty())
+		{
+			canonical = info.absoluteFilePath();
+		}
+		hash.addData(canonical.toUtf8());
+	};
+	auto addFile = [&hash, &addPath](const QString &path)
+	{
+		QFileInfo info(path);
+		addPath(info);
+		hash.addData(QByteArray::number(info.size()));
+		hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+		hash.addData("\n", 1);
+	};
+	hash.addData(javaVersion.toUtf8());
+	addFile(javaPath);
+	// the JVM checks the class path by name, the contents are covered by the inputs
+	for (auto &entry : classPath)
+	{
+		addPath(QFileInfo(entry));
+		hash.addData("\n", 1);
+	}
+	hash.addData("--\n", 3);
+	for (auto &input : inputs)
+	{
+		addFile(input);
+	}
+	return hash.result().toHex();
+}
+
+QStringList ClassDataSharing::arguments(const QString &archiveDir, const QString &prefix, const QString &javaPath,
+										const QString &javaVersion, const QStringList &classPath,
+										const QStringList &inputs)
+{
+	if (!isSupported(javaVersion))
+	{
+		return {};
+	}
+	QDir dir(archiveDir);
+	if (!FS::ensureFolderPathExists(dir.absolutePath()))
+	{
+		qWarning() << "Couldn't create the CDS archive folder" << dir.absolutePath();
+		return {};
+	}
+	const QString archiveName = prefix + "-" + fingerprint(javaPath, javaVersion, classPath, inputs) + ".jsa";
+	const QString archivePath = dir.absoluteFilePath(archiveName);
+
+	// anything else with our prefix was made for an older class path or java
+	for (auto &stale : dir.entryList({prefix + "-*.jsa"}, QDir::Files))
+	{
+		if (stale != archiveName)
+		{
+			qDebug() << "Removing out of date CDS archive" << stale;
+			dir.remove(stale);
+		}
+	}
+
+	if (QFileInfo(archivePath).size() > 0)
+	{
+		return {"-XX:SharedArchiveFile=" + archivePath};
+	}
+	// written by the JVM when the game exits
+	return {"-XX:ArchiveClassesAtExit=" + archivePath};
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+#include "multimc_logic_export.h"
+
+/**
+ * Java Class Data Sharing (CDS) archives for game launches.
+ *
+ * Java 13+ can dump the classes it loaded into an archive when it exits and map that archive
+ * on later starts, which saves parsing and verifying the same classes every time.
+ * An archive is only valid for the exact java and class path it was created with, so archives
+ * are named after a fingerprint of both.
+ *
+ * Class path entries that get rebuilt before every launch (the jar-modded minecraft.jar) can't be
+ * identified by their size and time. The files they are built from are passed as inputs instead.
+ */
+class MULTIMC_LOGIC_EXPORT ClassDataSharing
+{
+public:
+	/// true if the java version can create and use dynamic CDS archives
+	static bool isSupported(const QString &javaVersion);
+
+	/**
+	 * Identifies a java install together with a class path and the files it is made of.
+	 * Changes when the class path changes, or when java or any of the inputs is replaced or modified.
+	 */
+	static QString fingerprint(const QString &javaPath, const QString &javaVersion, const QStringList &classPath,
+							   const QStringList &inputs);
+
+	/**
+	 * Java arguments that use the archive for this java and class path, or create it if it doesn't exist yet.
+	 * Archives live in archiveDir and are named with the given prefix. Archives with the same prefix
+	 * and a different fingerprint are out of date and get removed.
+	 */
+	static QStringList arguments(const QString &archiveDir, const QString &prefix, const QString &javaPath,
+								 const QString &javaVersion, const QStringList &classPath,
+								 const QStringList &inputs);
+};
@@ -1,7 +1,11 @@
 #include "JavaChecker.h"
+#include "JavaProbeCache.h"
 #include <FileSystem.h>
 #include <Commandline.h>
+#include <Env.h>
 #include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
 #include <QProcess>
 #include <QMap>
 #include <QTemporaryFile>
@@ -12,8 +16,141 @@ JavaChecker::JavaChecker(QObject *parent) : QObject(parent)
 {
 }
 
+bool JavaChecker::isPlainProbe() const
+{
+	return m_args.isEmpty() && m_minMem == 0 && m_maxMem == 0 && m_permGen == 64;
+}
+
+static QString elfArchitecture(const QString &path)
+{
+	QFile binary(path);
+	if (!binary.open(QIODevice::ReadOnly))
+	{
+		return QString();
+	}
+	const QByteArray header = binary.read(20);
+	if (header.size() < 20 || !header.startsWith("\x7f" "ELF"))
+	{
+		return QString();
+	}
+	// e_machine, endianness given by e_ident[EI_DATA]
+	const uchar *data = reinterpret_cast<const uchar *>(header.constData());
+	const int machine = (data[5] == 2) ? ((data[18] << 8) | data[19]) : ((data[19] << 8) | data[18]);
+	switch (machine)
+	{
+	case 0x03:
+		return "i386";
+	case 0x3E:
+		return "amd64";
+	case 0x28:
+		return "arm";
+	case 0xB7:
+		return "aarch64";
+	default:
+		return QString();
+	}
+}
+
+bool JavaChecker::staticProbe(const QString &path, JavaCheckResult &result)
+{
+	QString executable = path;
+	if (!path.contains('/') && !path.contains('\\'))
+	{
+		executable = QStandardPaths::findExecutable(path);
+	}
+	const QString resolved = QFileInfo(executable).canonicalFilePath();
+	if (resolved.isEmpty())
+	{
+		return false;
+	}
+
+	// the binary lives either in <home>/bin or <home>/jre/bin
+	const QString binDir = QFileInfo(resolved).absolutePath();
+	QMap<QString, QString> release;
+	for (auto home : {FS::PathCombine(binDir, ".."), FS::PathCombine(binDir, "..", "..")})
+	{
+		QFile releaseFile(FS::PathCombine(home, "release"));
+		if (!releaseFile.open(QIODevice::ReadOnly))
+		{
+			continue;
+		}
+		for (auto line : QString::fromUtf8(releaseFile.readAll()).split('\n', QString::SkipEmptyParts))
+		{
+			const int separator = line.indexOf('=');
+			if (separator <= 0)
+			{
+				continue;
+			}
+			QString value = line.mid(separator + 1).trimmed();
+			if (value.startsWith('"') && value.endsWith('"') && value.size() >= 2)
+			{
+				value = value.mid(1, value.size() - 2);
+			}
+			release.insert(line.left(separator).trimmed(), value);
+		}
+		break;
+	}
+
+	const QString java_version = release.value("JAVA_VERSION");
+	if (java_version.isEmpty())
+	{
+		return false;
+	}
+	QString os_arch = release.value("OS_ARCH");
+	if (os_arch.isEmpty())
+	{
+		os_arch = elfArchitecture(resolved);
+	}
+	if (os_arch.isEmpty())
+	{
+		return false;
+	}
+	bool is_64 = os_arch == "x86_64" || os_arch == "amd64";
+
+	result.path = path;
+	result.valid = true;
+	result.is_64bit = is_64;
+	result.mojangPlatform = is_64 ? "64" : "32";
+	result.realPlatform = os_arch;
+	result.javaVersion = java_version;
+	return true;
+}
+
+void JavaChecker::finishWith(JavaCheckResult result)
+{
+	result.path = m_path;
+	result.id = m_id;
+	// report asynchronously, like a real check would
+	QTimer::singleShot(0, this, [this, result]()
+	{
+		emit checkFinished(result);
+	});
+}
+
 void JavaChecker::performCheck()
 {
+	if (isPlainProbe())
+	{
+		auto cache = ENV.javaProbeCache();
+		JavaCheckResult result;
+		if (cache && cache->lookup(m_path, result))
+		{
+			qDebug() << "Java checker used cached result for" << m_path;
+			finishWith(result);
+			return;
+		}
+		if (staticProbe(m_path, result))
+		{
+			qDebug() << "Java checker identified" << m_path << "without starting it.";
+			if (cache)
+			{
+				cache->store(result);
+			}
+			finishWith(result);
+			return;
+		}
+	}
+
 	QString checkerJar = FS::PathCombine(QCoreApplication::applicationDirPath(), "jars", "JavaCheck.jar");
 
 	QStringList args;
@@ -129,6 +266,11 @@ void JavaChecker::finished(int exitcode, QProcess::ExitStatus status)
 	result.realPlatform = os_arch;
 	result.javaVersion = java_version;
 	qDebug() << "Java checker succeeded.";
+	auto cache = ENV.javaProbeCache();
+	if (cache && isPlainProbe())
+	{
+		cache->store(result);
+	}
 	emit checkFinished(result);
 }
 
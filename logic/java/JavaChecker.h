@@ -30,6 +30,13 @@ public:
 	explicit JavaChecker(QObject *parent = 0);
 	void performCheck();
 
+	/**
+	 * Try to find out what java binary is at path without running it.
+	 * Reads the 'release' file of the java installation and falls back to the ELF header for the architecture.
+	 * Returns false if not enough information could be gathered.
+	 */
+	static bool staticProbe(const QString &path, JavaCheckResult &result);
+
 	QString m_path;
 	QString m_args;
 	int m_id = 0;
@@ -40,6 +47,10 @@ public:
 signals:
 	void checkFinished(JavaCheckResult result);
 private:
+	/// true if the check only asks what the java is, so the result can be taken from and put in the probe cache
+	bool isPlainProbe() const;
+	void finishWith(JavaCheckResult result);
+
 	QProcessPtr process;
 	QTimer killTimer;
 	QString m_stdout;
@@ -16,10 +16,12 @@
 #include "JavaCheckerJob.h"
 
 #include <QDebug>
+#include <QThread>
 
 void JavaCheckerJob::partFinished(JavaCheckResult result)
 {
 	num_finished++;
+	num_active--;
 	qDebug() << m_job_name.toLocal8Bit() << "progress:" << num_finished << "/"
 				<< javacheckers.size();
 	emit progress(num_finished, javacheckers.size());
@@ -29,6 +31,22 @@ void JavaCheckerJob::partFinished(JavaCheckResult result)
 	if (num_finished == javacheckers.size())
 	{
 		emit finished(javaresults);
+		return;
+	}
+	startMore();
+}
+
+void JavaCheckerJob::startMore()
+{
+	// every checker that can't be answered from the cache is a whole JVM, don't start them all at once
+	const int maxActive = qMax(2, QThread::idealThreadCount());
+	while (num_active < maxActive && num_started < javacheckers.size())
+	{
+		auto checker = javacheckers[num_started];
+		num_started++;
+		num_active++;
+		connect(checker.get(), SIGNAL(checkFinished(JavaCheckResult)), SLOT(partFinished(JavaCheckResult)));
+		checker->performCheck();
 	}
 }
 
@@ -36,10 +54,9 @@ void JavaCheckerJob::executeTask()
 {
 	qDebug() << m_job_name.toLocal8Bit() << " started.";
 	m_running = true;
-	for (auto iter : javacheckers)
+	for (int i = 0; i < javacheckers.size(); i++)
 	{
 		javaresults.append(JavaCheckResult());
-		connect(iter.get(), SIGNAL(checkFinished(JavaCheckResult)), SLOT(partFinished(JavaCheckResult)));
-		iter->performCheck();
 	}
+	startMore();
 }
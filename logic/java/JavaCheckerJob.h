@@ -33,13 +33,12 @@ public:
 	{
 		javacheckers.append(base);
 		total_progress++;
-		// if this is already running, the action needs to be started right away!
+		// if this is already running, the action needs to be started as soon as there is room
 		if (isRunning())
 		{
 			setProgress(current_progress, total_progress);
-			connect(base.get(), SIGNAL(checkFinished(JavaCheckResult)), SLOT(partFinished(JavaCheckResult)));
-
-			base->performCheck();
+			javaresults.append(JavaCheckResult());
+			startMore();
 		}
 		return true;
 	}
@@ -71,6 +70,10 @@ signals:
 private slots:
 	void partFinished(JavaCheckResult result);
 
+private:
+	/// start queued checkers until the concurrency limit is reached
+	void startMore();
+
 protected:
 	virtual void executeTask() override;
 
@@ -81,5 +84,7 @@ private:
 	qint64 current_progress = 0;
 	qint64 total_progress = 0;
 	int num_finished = 0;
+	int num_started = 0;
+	int num_active = 0;
 	bool m_running = false;
 };
@@ -72,6 +72,9 @@ QVariant JavaInstallList::data(const QModelIndex &index, int role) const
 			return version->path;
 		case ArchitectureRole:
 			return version->arch;
+		case VersionKeyRole:
+		case ParentGameVersionKeyRole:
+			return BaseVersionList::data(index, role);
 		default:
 			return QVariant();
 	}
@@ -108,6 +111,7 @@ void JavaInstallList::sortVersions()
 {
 	beginResetModel();
 	std::sort(m_vlist.begin(), m_vlist.end(), sortJavas);
+	rebuildIndex();
 	endResetModel();
 }
 
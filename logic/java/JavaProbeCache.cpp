@@ -0,0 +1,169 @@
+#include "JavaProbeCache.h"
+#include "FileSystem.h"
+
+#include <QFileInfo>
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QDebug>
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
+
+JavaProbeCache::JavaProbeCache(QString path) : QObject()
+{
+	m_index_file = path;
+	saveBatchingTimer.setSingleShot(true);
+	saveBatchingTimer.setTimerType(Qt::VeryCoarseTimer);
+	connect(&saveBatchingTimer, SIGNAL(timeout()), SLOT(SaveNow()));
+	Load();
+}
+
+JavaProbeCache::~JavaProbeCache()
+{
+	if (saveBatchingTimer.isActive())
+	{
+		saveBatchingTimer.stop();
+		SaveNow();
+	}
+}
+
+bool JavaProbeCache::identify(const QString &path, QString &resolved, qint64 &size, qint64 &mtime)
+{
+	// bare names like "java" are looked up in PATH, like QProcess would do
+	QString executable = path;
+	if (!path.contains('/') && !path.contains('\\'))
+	{
+		executable = QStandardPaths::findExecutable(path);
+		if (executable.isEmpty())
+		{
+			return false;
+		}
+	}
+	QFileInfo info(executable);
+	resolved = info.canonicalFilePath();
+	if (resolved.isEmpty())
+	{
+		return false;
+	}
+	QFileInfo resolvedInfo(resolved);
+	size = resolvedInfo.size();
+	mtime = resolvedInfo.lastModified().toMSecsSinceEpoch();
+	return true;
+}
+
+bool JavaProbeCache::lookup(const QString &path, JavaCheckResult &result)
+{
+	QString resolved;
+	qint64 size, mtime;
+	if (!identify(path, resolved, size, mtime))
+	{
+		return false;
+	}
+	auto iter = m_entries.find(resolved);
+	if (iter == m_entries.end())
+	{
+		return false;
+	}
+	const Entry &entry = *iter;
+	if (entry.size != size || entry.mtime != mtime)
+	{
+		// the binary changed (java update?), forget about it
+		m_entries.erase(iter);
+		SaveEventually();
+		return false;
+	}
+	result.path = path;
+	result.javaVersion = entry.javaVersion;
+	result.realPlatform = entry.realPlatform;
+	result.is_64bit = entry.is_64bit;
+	result.mojangPlatform = entry.is_64bit ? "64" : "32";
+	result.valid = true;
+	return true;
+}
+
+void JavaProbeCache::store(const JavaCheckResult &result)
+{
+	if (!result.valid)
+	{
+		return;
+	}
+	Entry entry;
+	QString resolved;
+	if (!identify(result.path, resolved, entry.size, entry.mtime))
+	{
+		return;
+	}
+	entry.javaVersion = JavaVersion(result.javaVersion).toString();
+	entry.realPlatform = result.realPlatform;
+	entry.is_64bit = result.is_64bit;
+	m_entries[resolved] = entry;
+	SaveEventually();
+}
+
+void JavaProbeCache::Load()
+{
+	QFile index(m_index_file);
+	if (!index.open(QIODevice::ReadOnly))
+		return;
+
+	QJsonDocument json = QJsonDocument::fromJson(index.readAll());
+	if (!json.isObject())
+		return;
+	auto root = json.object();
+	// check file version first
+	if (root.value("version").toString() != "1")
+		return;
+
+	for (auto element : root.value("entries").toArray())
+	{
+		if (!element.isObject())
+			continue;
+		auto element_obj = element.toObject();
+		QString path = element_obj.value("path").toString();
+		if (path.isEmpty())
+			continue;
+		Entry entry;
+		entry.size = element_obj.value("size").toDouble();
+		entry.mtime = element_obj.value("mtime").toDouble();
+		entry.javaVersion = element_obj.value("java.version").toString();
+		entry.realPlatform = element_obj.value("os.arch").toString();
+		entry.is_64bit = element_obj.value("64bit").toBool();
+		m_entries[path] = entry;
+	}
+}
+
+void JavaProbeCache::SaveEventually()
+{
+	// reset the save timer
+	saveBatchingTimer.stop();
+	saveBatchingTimer.start(5000);
+}
+
+void JavaProbeCache::SaveNow()
+{
+	QJsonObject toplevel;
+	toplevel.insert("version", QJsonValue(QString("1")));
+	QJsonArray entriesArr;
+	for (auto iter = m_entries.begin(); iter != m_entries.end(); iter++)
+	{
+		QJsonObject entryObj;
+		entryObj.insert("path", iter.key());
+		entryObj.insert("size", double(iter->size));
+		entryObj.insert("mtime", double(iter->mtime));
+		entryObj.insert("java.version", iter->javaVersion);
+		entryObj.insert("os.arch", iter->realPlatform);
+		entryObj.insert("64bit", iter->is_64bit);
+		entriesArr.append(entryObj);
+	}
+	toplevel.insert("entries", entriesArr);
+
+	try
+	{
+		FS::write(m_index_file, QJsonDocument(toplevel).toJson());
+	}
+	catch (Exception & e)
+	{
+		qWarning() << e.what();
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QString>
+#include <QMap>
+#include <QTimer>
+
+#include "JavaChecker.h"
+
+#include "multimc_logic_export.h"
+
+/**
+ * Remembers what we found out about java binaries, across runs.
+ *
+ * Entries are keyed by the resolved (canonical) path of the binary and are only
+ * considered valid while the size and modification time of that file stay the same.
+ */
+class MULTIMC_LOGIC_EXPORT JavaProbeCache : public QObject
+{
+	Q_OBJECT
+public:
+	// supply path to the cache index file
+	explicit JavaProbeCache(QString path);
+	~JavaProbeCache();
+
+	/// look up a previous probe result for the java binary at path. returns false on a miss.
+	bool lookup(const QString &path, JavaCheckResult &result);
+
+	/// remember a successful probe result. invalid results are not stored.
+	void store(const JavaCheckResult &result);
+
+	void Load();
+
+	// (re)start a timer that calls SaveNow later.
+	void SaveEventually();
+public
+slots:
+	void SaveNow();
+
+private:
+	struct Entry
+	{
+		qint64 size = 0;
+		qint64 mtime = 0;
+		QString javaVersion;
+		QString realPlatform;
+		bool is_64bit = false;
+	};
+	/// resolves the path and fills in the identity of the file. returns false if the file doesn't exist.
+	static bool identify(const QString &path, QString &resolved, qint64 &size, qint64 &mtime);
+
+	QMap<QString, Entry> m_entries;
+	QString m_index_file;
+	QTimer saveBatchingTimer;
+};
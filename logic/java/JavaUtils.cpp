@@ -16,6 +16,8 @@
 #include <QStringList>
 #include <QString>
 #include <QDir>
+#include <QFileInfo>
+#include <QSet>
 #include <QStringList>
 
 #include <settings/Setting.h>
@@ -197,14 +199,63 @@ QList<QString> JavaUtils::FindJavaPaths()
 #elif defined(Q_OS_LINUX)
 QList<QString> JavaUtils::FindJavaPaths()
 {
-	qDebug() << "Linux Java detection incomplete - defaulting to \"java\"";
-
 	QList<QString> javas;
 	javas.append(this->GetDefaultJava()->path);
-    javas.append("/opt/java/bin/java");
-    javas.append("/usr/bin/java");
+	javas.append("/opt/java/bin/java");
+	javas.append("/usr/bin/java");
 
-	return javas;
+	// look inside directories holding one java installation per subdirectory
+	auto scanJavaDir = [&](const QString &dirPath)
+	{
+		QDir dir(dirPath);
+		if (!dir.exists())
+		{
+			return;
+		}
+		for (auto &entry : dir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot))
+		{
+			for (auto candidate : {FS::PathCombine(entry.absoluteFilePath(), "jre/bin/java"),
+								   FS::PathCombine(entry.absoluteFilePath(), "bin/java")})
+			{
+				if (QFileInfo(candidate).isExecutable())
+				{
+					javas.append(candidate);
+				}
+			}
+		}
+	};
+	scanJavaDir("/usr/lib/jvm");
+	scanJavaDir("/usr/lib64/jvm");
+	scanJavaDir("/usr/lib32/jvm");
+	scanJavaDir("/opt/jdk");
+	scanJavaDir("/opt/jdks");
+	// SDKMAN! (sdkman.io) keeps javas in ~/.sdkman/candidates/java/<version>
+	QString sdkmanDir = qgetenv("SDKMAN_DIR");
+	if (sdkmanDir.isEmpty())
+	{
+		sdkmanDir = FS::PathCombine(QDir::homePath(), ".sdkman");
+	}
+	scanJavaDir(FS::PathCombine(sdkmanDir, "candidates", "java"));
+
+	// the distribution directories are full of symlinks pointing at each other, only probe each binary once
+	QList<QString> unique;
+	QSet<QString> seen;
+	for (auto &java : javas)
+	{
+		const QString resolved = QFileInfo(java).canonicalFilePath();
+		if (resolved.isEmpty())
+		{
+			unique.append(java);
+			continue;
+		}
+		if (seen.contains(resolved))
+		{
+			continue;
+		}
+		seen.insert(resolved);
+		unique.append(java);
+	}
+	return unique;
 }
 #else
 QList<QString> JavaUtils::FindJavaPaths()
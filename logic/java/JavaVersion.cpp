@@ -56,6 +56,15 @@ bool JavaVersion::requiresPermGen()
 	return true;
 }
 
+bool JavaVersion::supportsDynamicCDS()
+{
+	if(parseable)
+	{
+		return major >= 13;
+	}
+	return false;
+}
+
 bool JavaVersion::operator<(const JavaVersion &rhs)
 {
 	if(parseable && rhs.parseable)
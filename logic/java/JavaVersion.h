@@ -18,6 +18,9 @@ public:
 
 	bool requiresPermGen();
 
+	/// Java 13+ can write and read dynamic class data sharing archives
+	bool supportsDynamicCDS();
+
 	QString toString();
 
 private:
@@ -25,3 +25,16 @@ void LaunchStep::bind(LaunchTask *parent)
 	connect(this, &LaunchStep::finished, parent, &LaunchTask::onStepFinished);
 	connect(this, &LaunchStep::progressReportingRequest, parent, &LaunchTask::onProgressReportingRequested);
 }
+
+void LaunchStep::trackSubTask(Task *task, const QString &name)
+{
+	if(!task)
+	{
+		return;
+	}
+	m_parent->timeline().track(task, name, "task");
+	connect(task, &Task::subTaskStarted, this, [this](Task *subTask, QString subTaskName)
+	{
+		trackSubTask(subTask, subTaskName);
+	});
+}
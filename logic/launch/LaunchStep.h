@@ -34,6 +34,9 @@ public: /* methods */
 protected: /* methods */
 	virtual void bind(LaunchTask *parent);
 
+	/// record the task and the tasks it starts in the launch timeline
+	void trackSubTask(Task *task, const QString &name);
+
 signals:
 	void logLines(QStringList lines, MessageLevel::Enum level);
 	void logLine(QString line, MessageLevel::Enum level);
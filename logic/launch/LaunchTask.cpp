@@ -26,6 +26,7 @@
 #include <QRegularExpression>
 #include <QCoreApplication>
 #include <QStandardPaths>
+#include <FileSystem.h>
 #include <assert.h>
 
 void LaunchTask::init()
@@ -44,6 +45,24 @@ LaunchTask::LaunchTask(InstancePtr instance): m_instance(instance)
 {
 }
 
+void LaunchTask::setPid(qint64 pid)
+{
+	m_pid = pid;
+	if(pid > 0)
+	{
+		m_sampler.start(pid);
+	}
+	else if(m_sampler.isActive())
+	{
+		m_sampler.stop();
+		auto summary = m_sampler.summary();
+		if(!summary.isEmpty())
+		{
+			onLogLine(tr("Game resource usage: %1\n").arg(summary), MessageLevel::MultiMC);
+		}
+	}
+}
+
 void LaunchTask::appendStep(std::shared_ptr<LaunchStep> step)
 {
 	m_steps.append(step);
@@ -62,6 +81,7 @@ void LaunchTask::executeTask()
 		emitSucceeded();
 	}
 	state = LaunchTask::Running;
+	m_launchEvent = m_timeline.begin("Launch", "launch");
 	onStepFinished();
 }
 
@@ -77,11 +97,13 @@ void LaunchTask::onStepFinished()
 	if(currentStep == -1)
 	{
 		currentStep ++;
+		m_stepEvent = m_timeline.begin(m_steps[currentStep]->metaObject()->className(), "step");
 		m_steps[currentStep]->start();
 		return;
 	}
 
 	auto step = m_steps[currentStep];
+	m_timeline.end(m_stepEvent);
 	if(step->successful())
 	{
 		// end?
@@ -93,6 +115,7 @@ void LaunchTask::onStepFinished()
 		{
 			currentStep ++;
 			step = m_steps[currentStep];
+			m_stepEvent = m_timeline.begin(step->metaObject()->className(), "step");
 			step->start();
 		}
 	}
@@ -196,8 +219,38 @@ void LaunchTask::onLogLine(QString line, MessageLevel::Enum level)
 	emit log(line, level);
 }
 
+void LaunchTask::reportTimeline()
+{
+	if(m_timelineReported)
+	{
+		return;
+	}
+	m_timelineReported = true;
+	QStringList lines;
+	lines.append(tr("Launch timeline:"));
+	lines.append(m_timeline.summary());
+	// only for looking into slow launches, it's rewritten every time
+	if (m_instance->settings()->get("SaveLaunchTrace").toBool())
+	{
+		auto tracePath = FS::PathCombine(m_instance->instanceRoot(), "launch-trace.json");
+		try
+		{
+			FS::write(tracePath, m_timeline.toChromeTrace());
+			lines.append(tr("Chrome trace saved to %1").arg(tracePath));
+		}
+		catch (Exception &e)
+		{
+			qWarning() << "Couldn't save the launch trace:" << e.cause();
+		}
+	}
+	lines.append("");
+	onLogLines(lines, MessageLevel::MultiMC);
+}
+
 void LaunchTask::emitSucceeded()
 {
+	m_timeline.end(m_launchEvent);
+	reportTimeline();
 	m_instance->cleanupAfterRun();
 	m_instance->setRunning(false);
 	Task::emitSucceeded();
@@ -205,6 +258,9 @@ void LaunchTask::emitSucceeded()
 
 void LaunchTask::emitFailed(QString reason)
 {
+	m_timeline.end(m_stepEvent);
+	m_timeline.end(m_launchEvent);
+	reportTimeline();
 	m_instance->cleanupAfterRun();
 	m_instance->setRunning(false);
 	Task::emitFailed(reason);
@@ -21,6 +21,8 @@
 #include "MessageLevel.h"
 #include "LoggedProcess.h"
 #include "LaunchStep.h"
+#include "LaunchTimeline.h"
+#include "ProcessSampler.h"
 
 #include "multimc_logic_export.h"
 
@@ -55,16 +57,29 @@ public: /* methods */
 		return m_instance;
 	}
 
-	void setPid(qint64 pid)
-	{
-		m_pid = pid;
-	}
+	/// set the game process ID, -1 when it exited. Starts and stops resource sampling.
+	void setPid(qint64 pid);
 
 	qint64 pid()
 	{
 		return m_pid;
 	}
 
+	/// resource usage of the game process
+	ProcessSampler & sampler()
+	{
+		return m_sampler;
+	}
+
+	/// when the steps of this launch and their sub-tasks ran
+	LaunchTimeline & timeline()
+	{
+		return m_timeline;
+	}
+
+	/// print the timeline into the log and save it as a trace file. Only does anything the first time.
+	void reportTimeline();
+
 	/**
 	 * @brief prepare the process for launch (for multi-stage launch)
 	 */
@@ -119,4 +134,9 @@ protected: /* data */
 	int currentStep = -1;
 	State state = NotStarted;
 	qint64 m_pid = -1;
+	LaunchTimeline m_timeline;
+	ProcessSampler m_sampler;
+	int m_launchEvent = -1;
+	int m_stepEvent = -1;
+	bool m_timelineReported = false;
 };
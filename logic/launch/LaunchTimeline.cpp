@@ -0,0 +1,121 @@
+#include "LaunchTimeline.h"
+#include "tasks/Task.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QCoreApplication>
+
+LaunchTimeline::LaunchTimeline()
+{
+	m_clock.start();
+}
+
+int LaunchTimeline::begin(const QString &name, const QString &category)
+{
+	m_events.append({name, category, m_clock.nsecsElapsed(), -1, false});
+	return m_events.size() - 1;
+}
+
+void LaunchTimeline::end(int handle)
+{
+	if (handle < 0 || handle >= m_events.size())
+	{
+		return;
+	}
+	auto &event = m_events[handle];
+	if (event.end == -1)
+	{
+		event.end = m_clock.nsecsElapsed();
+	}
+}
+
+void LaunchTimeline::mark(const QString &name, const QString &category)
+{
+	auto now = m_clock.nsecsElapsed();
+	m_events.append({name, category, now, now, true});
+}
+
+void LaunchTimeline::track(Task *task, const QString &name, const QString &category)
+{
+	if (!task)
+	{
+		return;
+	}
+	int handle = begin(name, category);
+	connect(task, &Task::finished, this, [this, handle]()
+	{
+		end(handle);
+	});
+}
+
+qint64 LaunchTimeline::elapsed() const
+{
+	return m_clock.elapsed();
+}
+
+QStringList LaunchTimeline::summary() const
+{
+	QStringList out;
+	for (auto &event : m_events)
+	{
+		const double start = event.start / 1000000.0;
+		// steps are the top level, everything else happens inside or next to them
+		const QString indent = event.category == "step" ? "" : "  ";
+		if (event.instant)
+		{
+			out.append(QString("%1 ms %2* %3").arg(start, 9, 'f', 1).arg(indent, event.name));
+		}
+		else if (event.end == -1)
+		{
+			out.append(QString("%1 ms %2%3 (unfinished)").arg(start, 9, 'f', 1).arg(indent, event.name));
+		}
+		else
+		{
+			const double duration = (event.end - event.start) / 1000000.0;
+			out.append(QString("%1 ms %2%3 took %4 ms")
+						   .arg(start, 9, 'f', 1)
+						   .arg(indent, event.name)
+						   .arg(duration, 0, 'f', 1));
+		}
+	}
+	return out;
+}
+
+QByteArray LaunchTimeline::toChromeTrace() const
+{
+	const qint64 pid = QCoreApplication::applicationPid();
+	// overlapping spans need their own rows, so each category gets a 'thread'
+	QStringList categories;
+	QJsonArray events;
+	for (auto &event : m_events)
+	{
+		if (!categories.contains(event.category))
+		{
+			categories.append(event.category);
+		}
+		QJsonObject obj;
+		obj.insert("name", event.name);
+		obj.insert("cat", event.category);
+		obj.insert("pid", double(pid));
+		obj.insert("tid", categories.indexOf(event.category) + 1);
+		// microseconds
+		obj.insert("ts", event.start / 1000.0);
+		if (event.instant)
+		{
+			obj.insert("ph", QString("i"));
+			obj.insert("s", QString("g"));
+		}
+		else
+		{
+			obj.insert("ph", QString("X"));
+			const qint64 end = event.end == -1 ? m_clock.nsecsElapsed() : event.end;
+			obj.insert("dur", (end - event.start) / 1000.0);
+		}
+		events.append(obj);
+	}
+	QJsonObject root;
+	root.insert("traceEvents", events);
+	root.insert("displayTimeUnit", QString("ms"));
+	return QJsonDocument(root).toJson();
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QStringList>
+
+#include "multimc_logic_export.h"
+
+class Task;
+
+/**
+ * Records when the parts of a launch started and ended, on a monotonic clock.
+ *
+ * Can be turned into a human readable summary or a Chrome trace-event JSON file
+ * (open it in chrome://tracing).
+ */
+class MULTIMC_LOGIC_EXPORT LaunchTimeline : public QObject
+{
+public:
+	LaunchTimeline();
+	virtual ~LaunchTimeline() {};
+
+	/// start recording a span, returns its handle for end()
+	int begin(const QString &name, const QString &category);
+
+	/// end a span started by begin(). Ending an already ended span does nothing.
+	void end(int handle);
+
+	/// record a point in time
+	void mark(const QString &name, const QString &category);
+
+	/// record a span for a task, from now until it finishes
+	void track(Task *task, const QString &name, const QString &category);
+
+	/// milliseconds since the timeline was created
+	qint64 elapsed() const;
+
+	/// one line per recorded event
+	QStringList summary() const;
+
+	/// the events as Chrome trace-event JSON
+	QByteArray toChromeTrace() const;
+
+private:
+	struct Event
+	{
+		QString name;
+		QString category;
+		/// nanoseconds since the start of the timeline
+		qint64 start;
+		qint64 end;
+		bool instant;
+	};
+	QElapsedTimer m_clock;
+	QList<Event> m_events;
+};
@@ -0,0 +1,245 @@
+#include "ProcessSampler.h"
+
+#include <QFile>
+#include <QDir>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+namespace
+{
+QByteArray readProcFile(qint64 pid, const char *name)
+{
+	QFile file(QString("/proc/%1/%2").arg(pid).arg(name));
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		return QByteArray();
+	}
+	// procfs files report a size of 0, readAll handles that
+	return file.readAll();
+}
+
+QString formatBytes(qint64 bytes)
+{
+	if (bytes >= 1024LL * 1024 * 1024)
+		return QString("%1 GiB").arg(bytes / (1024.0 * 1024.0 * 1024.0), 0, 'f', 2);
+	return QString("%1 MiB").arg(bytes / (1024.0 * 1024.0), 0, 'f', 1);
+}
+}
+
+ProcessSampler::ProcessSampler(QObject *parent) : QObject(parent)
+{
+	m_buffer.resize(bufferSize);
+	connect(&m_timer, &QTimer::timeout, this, &ProcessSampler::takeSample);
+}
+
+bool ProcessSampler::isSupported()
+{
+#ifdef Q_OS_LINUX
+	return QFile::exists("/proc/self/stat");
+#else
+	return false;
+#endif
+}
+
+void ProcessSampler::start(qint64 pid, int intervalMs)
+{
+	if (!isSupported() || pid <= 0)
+	{
+		return;
+	}
+	m_pid = pid;
+	m_next = 0;
+	m_wrapped = false;
+	m_lastTicks.clear();
+	m_ioPerProcess.clear();
+	m_count = 0;
+	m_cpuSum = m_peakCpu = 0;
+	m_peakRss = m_readBytes = m_writeBytes = 0;
+	m_peakThreads = 0;
+	m_clock.start();
+	m_lastSampleTime = 0;
+	// the first sample only establishes the cpu time baseline
+	takeSample();
+	m_timer.start(intervalMs);
+}
+
+void ProcessSampler::stop()
+{
+	m_timer.stop();
+	m_pid = -1;
+}
+
+bool ProcessSampler::isActive() const
+{
+	return m_timer.isActive();
+}
+
+bool ProcessSampler::parseStat(const QByteArray &data, ProcStat &out)
+{
+	// the process name is in parentheses and may contain anything, including spaces and ')'
+	int nameEnd = data.lastIndexOf(')');
+	if (nameEnd < 0)
+	{
+		return false;
+	}
+	auto fields = data.mid(nameEnd + 1).simplified().split(' ');
+	// fields[0] is field 3 (state) in proc(5)
+	if (fields.size() < 22)
+	{
+		return false;
+	}
+	out.ppid = fields[1].toLongLong();
+	out.cpuTicks = fields[11].toLongLong() + fields[12].toLongLong();
+	out.threads = fields[17].toInt();
+	out.rssPages = fields[21].toLongLong();
+	return true;
+}
+
+bool ProcessSampler::parseIo(const QByteArray &data, qint64 &readBytes, qint64 &writeBytes)
+{
+	bool haveRead = false, haveWrite = false;
+	for (auto line : data.split('\n'))
+	{
+		if (line.startsWith("read_bytes:"))
+		{
+			readBytes = line.mid(11).trimmed().toLongLong(&haveRead);
+		}
+		else if (line.startsWith("write_bytes:"))
+		{
+			writeBytes = line.mid(12).trimmed().toLongLong(&haveWrite);
+		}
+	}
+	return haveRead && haveWrite;
+}
+
+QList<qint64> ProcessSampler::processTree() const
+{
+	QList<qint64> tree;
+	tree.append(m_pid);
+	// there's no cheap 'list my descendants' in procfs, so look at everything once and build the tree
+	QHash<qint64, QList<qint64>> children;
+	for (auto &entry : QDir("/proc").entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+	{
+		bool isPid = false;
+		qint64 pid = entry.toLongLong(&isPid);
+		if (!isPid || pid == m_pid)
+		{
+			continue;
+		}
+		ProcStat stat;
+		if (parseStat(readProcFile(pid, "stat"), stat))
+		{
+			children[stat.ppid].append(pid);
+		}
+	}
+	for (int i = 0; i < tree.size(); i++)
+	{
+		tree.append(children.value(tree[i]));
+	}
+	return tree;
+}
+
+void ProcessSampler::takeSample()
+{
+#ifdef Q_OS_LINUX
+	if (m_pid <= 0)
+	{
+		return;
+	}
+	static const qint64 pageSize = sysconf(_SC_PAGESIZE);
+	static const double ticksPerSecond = sysconf(_SC_CLK_TCK);
+
+	Sample sample;
+	sample.time = m_clock.elapsed();
+	qint64 tickDelta = 0;
+	QHash<qint64, qint64> ticks;
+	bool any = false;
+	for (auto pid : processTree())
+	{
+		ProcStat stat;
+		if (!parseStat(readProcFile(pid, "stat"), stat))
+		{
+			continue;
+		}
+		any = true;
+		sample.rssBytes += stat.rssPages * pageSize;
+		sample.threads += stat.threads;
+		ticks[pid] = stat.cpuTicks;
+		if (m_lastTicks.contains(pid))
+		{
+			tickDelta += stat.cpuTicks - m_lastTicks[pid];
+		}
+		qint64 readBytes = 0, writeBytes = 0;
+		if (parseIo(readProcFile(pid, "io"), readBytes, writeBytes))
+		{
+			m_ioPerProcess[pid] = qMakePair(readBytes, writeBytes);
+		}
+	}
+	if (!any)
+	{
+		// the process is gone
+		return;
+	}
+	const bool baseline = m_lastTicks.isEmpty();
+	m_lastTicks = ticks;
+
+	// exited children keep counting with their last known numbers
+	for (auto &io : m_ioPerProcess)
+	{
+		sample.readBytes += io.first;
+		sample.writeBytes += io.second;
+	}
+	const qint64 wall = sample.time - m_lastSampleTime;
+	m_lastSampleTime = sample.time;
+	if (baseline || wall <= 0)
+	{
+		return;
+	}
+	sample.cpuPercent = (tickDelta / ticksPerSecond) / (wall / 1000.0) * 100.0;
+	record(sample);
+#endif
+}
+
+void ProcessSampler::record(const Sample &sample)
+{
+	m_buffer[m_next] = sample;
+	m_next = (m_next + 1) % bufferSize;
+	if (m_next == 0)
+	{
+		m_wrapped = true;
+	}
+	m_count++;
+	m_cpuSum += sample.cpuPercent;
+	m_peakCpu = qMax(m_peakCpu, sample.cpuPercent);
+	m_peakRss = qMax(m_peakRss, sample.rssBytes);
+	m_peakThreads = qMax(m_peakThreads, sample.threads);
+	m_readBytes = sample.readBytes;
+	m_writeBytes = sample.writeBytes;
+	emit sampled(sample);
+}
+
+QVector<ProcessSampler::Sample> ProcessSampler::samples() const
+{
+	if (!m_wrapped)
+	{
+		return m_buffer.mid(0, m_next);
+	}
+	return m_buffer.mid(m_next) + m_buffer.mid(0, m_next);
+}
+
+QString ProcessSampler::summary() const
+{
+	if (m_count == 0)
+	{
+		return QString();
+	}
+	return tr("Peak memory %1, CPU %2% average / %3% peak, up to %4 threads, %5 read, %6 written.")
+		.arg(formatBytes(m_peakRss))
+		.arg(m_cpuSum / m_count, 0, 'f', 0)
+		.arg(m_peakCpu, 0, 'f', 0)
+		.arg(m_peakThreads)
+		.arg(formatBytes(m_readBytes))
+		.arg(formatBytes(m_writeBytes));
+}
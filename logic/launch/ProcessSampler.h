@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+#include <QHash>
+#include <QElapsedTimer>
+
+#include "multimc_logic_export.h"
+
+/**
+ * Periodically samples the resource usage of a process and all of its children.
+ *
+ * Only works on Linux, where the numbers come from /proc. Elsewhere, start() does nothing.
+ * The last samples are kept in a ring buffer, totals and peaks are kept for the whole run.
+ */
+class MULTIMC_LOGIC_EXPORT ProcessSampler : public QObject
+{
+	Q_OBJECT
+public:
+	struct Sample
+	{
+		/// milliseconds since sampling started
+		qint64 time = 0;
+		/// 100% = one core busy
+		double cpuPercent = 0;
+		qint64 rssBytes = 0;
+		int threads = 0;
+		/// bytes read from/written to storage since the process started
+		qint64 readBytes = 0;
+		qint64 writeBytes = 0;
+	};
+
+	/// what a single /proc/<pid>/stat line tells us
+	struct ProcStat
+	{
+		qint64 ppid = 0;
+		/// user + system time, in clock ticks
+		qint64 cpuTicks = 0;
+		int threads = 0;
+		/// in pages
+		qint64 rssPages = 0;
+	};
+
+public:
+	explicit ProcessSampler(QObject *parent = 0);
+	virtual ~ProcessSampler() {};
+
+	static bool isSupported();
+
+	void start(qint64 pid, int intervalMs = 1000);
+	void stop();
+	bool isActive() const;
+
+	/// the samples in the ring buffer, oldest first
+	QVector<Sample> samples() const;
+
+	/// one line describing the whole run
+	QString summary() const;
+
+	/// parse the contents of /proc/<pid>/stat
+	static bool parseStat(const QByteArray &data, ProcStat &out);
+	/// parse the contents of /proc/<pid>/io
+	static bool parseIo(const QByteArray &data, qint64 &readBytes, qint64 &writeBytes);
+
+signals:
+	void sampled(const ProcessSampler::Sample &sample);
+
+private slots:
+	void takeSample();
+
+private:
+	QList<qint64> processTree() const;
+	void record(const Sample &sample);
+
+private:
+	static const int bufferSize = 300;
+
+	QTimer m_timer;
+	QElapsedTimer m_clock;
+	qint64 m_pid = -1;
+
+	QVector<Sample> m_buffer;
+	int m_next = 0;
+	bool m_wrapped = false;
+
+	/// cpu ticks per process at the previous sample, so exited children don't make the total go backwards
+	QHash<qint64, qint64> m_lastTicks;
+	qint64 m_lastSampleTime = 0;
+
+	// totals for the whole run
+	int m_count = 0;
+	double m_cpuSum = 0;
+	double m_peakCpu = 0;
+	qint64 m_peakRss = 0;
+	int m_peakThreads = 0;
+	qint64 m_readBytes = 0;
+	qint64 m_writeBytes = 0;
+	QHash<qint64, QPair<qint64, qint64>> m_ioPerProcess;
+};
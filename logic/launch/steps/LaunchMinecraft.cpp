@@ -21,7 +21,7 @@
 
 LaunchMinecraft::LaunchMinecraft(LaunchTask *parent) : LaunchStep(parent)
 {
-	connect(&m_process, &LoggedProcess::log, this, &LaunchMinecraft::logLines);
+	connect(&m_process, &LoggedProcess::log, this, &LaunchMinecraft::on_log);
 	connect(&m_process, &LoggedProcess::stateChanged, this, &LaunchMinecraft::on_state);
 }
 
@@ -30,9 +30,21 @@ void LaunchMinecraft::executeTask()
 	auto instance = m_parent->instance();
 	std::shared_ptr<MinecraftInstance> minecraftInstance = std::dynamic_pointer_cast<MinecraftInstance>(instance);
 
+	int scriptEvent = m_parent->timeline().begin(tr("Launch script"), "task");
 	m_launchScript = minecraftInstance->createLaunchScript(m_session);
+	m_parent->timeline().end(scriptEvent);
 
 	QStringList args = minecraftInstance->javaArguments();
+	// java options have to come before the jar
+	int jarIndex = args.lastIndexOf("-jar");
+	if (jarIndex < 0)
+	{
+		jarIndex = args.size();
+	}
+	for (auto &arg : m_extraJavaArgs)
+	{
+		args.insert(jarIndex++, arg);
+	}
 
 	// HACK: this is a workaround for MCL-3732 - 'server-resource-packs' is created.
 	if(!FS::ensureFolderPathExists(FS::PathCombine(minecraftInstance->minecraftRoot(), "server-resource-packs")))
@@ -47,6 +59,8 @@ void LaunchMinecraft::executeTask()
 
 	m_process.setProcessEnvironment(instance->createEnvironment());
 
+	m_parent->timeline().mark(tr("Process spawned"), "process");
+
 	QString wrapperCommand = instance->getWrapperCommand();
 	if(!wrapperCommand.isEmpty())
 	{
@@ -105,6 +119,7 @@ void LaunchMinecraft::on_state(LoggedProcess::State state)
 			break;
 		}
 		case LoggedProcess::Running:
+			m_parent->timeline().mark(tr("Process running"), "process");
 			emit logLine(tr("Minecraft process ID: %1\n\n").arg(m_process.processId()), MessageLevel::MultiMC);
 			m_parent->setPid(m_process.processId());
 			m_parent->instance()->setLastLaunch();
@@ -119,6 +134,18 @@ void LaunchMinecraft::on_state(LoggedProcess::State state)
 	}
 }
 
+void LaunchMinecraft::on_log(QStringList lines, MessageLevel::Enum level)
+{
+	emit logLines(lines, level);
+	if(!m_sawOutput)
+	{
+		// everything before this is what the user waits for
+		m_sawOutput = true;
+		m_parent->timeline().mark(tr("First output"), "process");
+		m_parent->reportTimeline();
+	}
+}
+
 void LaunchMinecraft::setWorkingDirectory(const QString &wd)
 {
 	m_process.setWorkingDirectory(wd);
@@ -128,6 +155,7 @@ void LaunchMinecraft::proceed()
 {
 	if(mayProceed)
 	{
+		m_parent->timeline().mark(tr("Launch confirmed"), "process");
 		QString launchString("launch\n");
 		m_process.write(launchString.toUtf8());
 		mayProceed = false;
@@ -36,13 +36,21 @@ public:
 	{
 		m_session = session;
 	}
+	/// arguments for java decided by earlier steps, passed before the launcher jar
+	void addJavaArguments(const QStringList &args)
+	{
+		m_extraJavaArgs.append(args);
+	}
 private slots:
 	void on_state(LoggedProcess::State state);
+	void on_log(QStringList lines, MessageLevel::Enum level);
 
 private:
 	LoggedProcess m_process;
 	QString m_command;
 	QString m_launchScript;
 	AuthSessionPtr m_session;
+	QStringList m_extraJavaArgs;
 	bool mayProceed = false;
+	bool m_sawOutput = false;
 };
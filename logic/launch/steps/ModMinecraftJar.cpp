@@ -23,6 +23,7 @@ void ModMinecraftJar::executeTask()
 	if(m_jarModTask)
 	{
 		connect(m_jarModTask.get(), SIGNAL(finished()), this, SLOT(jarModdingFinished()));
+		trackSubTask(m_jarModTask.get(), tr("Jar modding"));
 		m_jarModTask->start();
 		return;
 	}
@@ -0,0 +1,55 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PrepareClassDataSharing.h"
+#include "LaunchMinecraft.h"
+#include <launch/LaunchTask.h>
+#include <minecraft/MinecraftInstance.h>
+#include <java/ClassDataSharing.h>
+#include <FileSystem.h>
+#include <QDir>
+
+PrepareClassDataSharing::PrepareClassDataSharing(LaunchTask *parent) : LaunchStep(parent)
+{
+}
+
+void PrepareClassDataSharing::executeTask()
+{
+	auto instance = std::dynamic_pointer_cast<MinecraftInstance>(m_parent->instance());
+	auto launchStep = m_launchStep.lock();
+	if (!instance || !launchStep)
+	{
+		emitSucceeded();
+		return;
+	}
+	auto settings = instance->settings();
+	auto javaPath = FS::ResolveExecutable(settings->get("JavaPath").toString());
+	auto javaVersion = settings->get("JavaVersion").toString();
+	if (!ClassDataSharing::isSupported(javaVersion))
+	{
+		emit logLine(tr("Class data sharing needs Java 13 or newer, launching without it.\n"), MessageLevel::MultiMC);
+		emitSucceeded();
+		return;
+	}
+
+	auto classPath = instance->classPath();
+	classPath.prepend(MinecraftInstance::launcherJar());
+	auto inputs = instance->classPathInputs();
+	inputs.prepend(MinecraftInstance::launcherJar());
+	auto args = ClassDataSharing::arguments(QDir("cds").absolutePath(), instance->id(), javaPath, javaVersion,
+											classPath, inputs);
+	launchStep->addJavaArguments(args);
+	emitSucceeded();
+}
@@ -0,0 +1,47 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <launch/LaunchStep.h>
+#include <memory>
+
+class LaunchMinecraft;
+
+/**
+ * Picks the Class Data Sharing archive for the launch, removing out of date ones.
+ *
+ * Runs after everything on the class path has been built, and passes the java arguments on to the launch step.
+ */
+class PrepareClassDataSharing: public LaunchStep
+{
+	Q_OBJECT
+public:
+	explicit PrepareClassDataSharing(LaunchTask *parent);
+	virtual ~PrepareClassDataSharing(){};
+
+	virtual void executeTask();
+	virtual bool canAbort() const
+	{
+		return false;
+	}
+	void setLaunchStep(std::shared_ptr<LaunchMinecraft> step)
+	{
+		m_launchStep = step;
+	}
+
+private:
+	std::weak_ptr<LaunchMinecraft> m_launchStep;
+};
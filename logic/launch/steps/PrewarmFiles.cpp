@@ -0,0 +1,113 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PrewarmFiles.h"
+#include <launch/LaunchTask.h>
+#include <QtConcurrentMap>
+#include <QFile>
+
+#if defined(Q_OS_LINUX) || defined(Q_OS_MAC)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <climits>
+#endif
+
+PrewarmFiles::PrewarmFiles(LaunchTask *parent) : LaunchStep(parent)
+{
+	connect(&m_watcher, &QFutureWatcher<qint64>::finished, this, &PrewarmFiles::prewarmFinished);
+}
+
+void PrewarmFiles::setFiles(const QStringList &files)
+{
+	m_files = files;
+	m_files.removeDuplicates();
+}
+
+qint64 PrewarmFiles::prewarmFile(const QString &path)
+{
+#if defined(Q_OS_LINUX) || defined(Q_OS_MAC)
+	int fd = ::open(QFile::encodeName(path).constData(), O_RDONLY);
+	if (fd < 0)
+	{
+		return 0;
+	}
+	struct stat info;
+	if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+	{
+		::close(fd);
+		return 0;
+	}
+	qint64 size = info.st_size;
+#if defined(Q_OS_LINUX)
+	// starts asynchronous readahead of the whole file
+	int result = ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#else
+	struct radvisory advice;
+	advice.ra_offset = 0;
+	advice.ra_count = size > INT_MAX ? INT_MAX : int(size);
+	int result = ::fcntl(fd, F_RDADVISE, &advice);
+#endif
+	::close(fd);
+	return result == 0 ? size : 0;
+#else
+	// no readahead hints available, read it through
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		return 0;
+	}
+	char buffer[64 * 1024];
+	qint64 total = 0;
+	qint64 read;
+	while ((read = file.read(buffer, sizeof(buffer))) > 0)
+	{
+		total += read;
+	}
+	return total;
+#endif
+}
+
+void PrewarmFiles::executeTask()
+{
+	if (!m_files.isEmpty())
+	{
+		m_timer.start();
+		m_timelineEvent = m_parent->timeline().begin(tr("Prewarming %1 files").arg(m_files.size()), "background");
+		m_watcher.setFuture(QtConcurrent::mapped(m_files, &PrewarmFiles::prewarmFile));
+	}
+	emitSucceeded();
+}
+
+void PrewarmFiles::prewarmFinished()
+{
+	m_parent->timeline().end(m_timelineEvent);
+	qint64 total = 0;
+	int warmed = 0;
+	for (auto size : m_watcher.future().results())
+	{
+		if (size > 0)
+		{
+			total += size;
+			warmed++;
+		}
+	}
+	emit logLine(tr("Prewarmed %1 of %2 files (%3 MiB) in %4 ms.\n")
+					 .arg(warmed)
+					 .arg(m_files.size())
+					 .arg(double(total) / (1024.0 * 1024.0), 0, 'f', 1)
+					 .arg(m_timer.elapsed()),
+				 MessageLevel::MultiMC);
+}
@@ -0,0 +1,53 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <launch/LaunchStep.h>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+
+/**
+ * Asks the OS to read the files the game is going to open into the page cache.
+ *
+ * This runs in the background, the step itself finishes right away so the following steps
+ * (updates, jar modding, ...) overlap with the reading.
+ */
+class PrewarmFiles: public LaunchStep
+{
+	Q_OBJECT
+public:
+	explicit PrewarmFiles(LaunchTask *parent);
+	virtual ~PrewarmFiles(){};
+
+	virtual void executeTask();
+	virtual bool canAbort() const
+	{
+		return false;
+	}
+	void setFiles(const QStringList &files);
+
+	/// start reading a file into the page cache, returns the size of the file or 0 if it couldn't be read
+	static qint64 prewarmFile(const QString &path);
+
+private slots:
+	void prewarmFinished();
+
+private:
+	QStringList m_files;
+	QFutureWatcher<qint64> m_watcher;
+	QElapsedTimer m_timer;
+	int m_timelineEvent = -1;
+};
@@ -0,0 +1,59 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ReconstructAssets.h"
+#include <launch/LaunchTask.h>
+#include <QtConcurrentRun>
+
+ReconstructAssets::ReconstructAssets(LaunchTask *parent) : LaunchStep(parent)
+{
+	connect(&m_watcher, &QFutureWatcher<AssetsUtils::ReconstructStats>::finished, this,
+			&ReconstructAssets::reconstructFinished);
+}
+
+void ReconstructAssets::executeTask()
+{
+	if (m_assetsId.isEmpty())
+	{
+		emitSucceeded();
+		return;
+	}
+	m_timer.start();
+	auto assetsId = m_assetsId;
+	m_watcher.setFuture(QtConcurrent::run([assetsId]()
+	{
+		AssetsUtils::ReconstructStats stats;
+		AssetsUtils::reconstructAssets(assetsId, &stats);
+		AssetsUtils::removeStaleVirtualAssets(AssetsUtils::staleVirtualAssetsDays, assetsId);
+		return stats;
+	}));
+}
+
+void ReconstructAssets::reconstructFinished()
+{
+	auto stats = m_watcher.result();
+	// nothing to report for versions that don't use virtual assets
+	if (stats.linked || stats.copied || stats.failed)
+	{
+		emit logLine(tr("Virtual assets: %1 linked, %2 copied, %3 already present, %4 failed in %5 ms.\n")
+						 .arg(stats.linked)
+						 .arg(stats.copied)
+						 .arg(stats.present)
+						 .arg(stats.failed)
+						 .arg(m_timer.elapsed()),
+					 MessageLevel::MultiMC);
+	}
+	emitSucceeded();
+}
@@ -0,0 +1,52 @@
+/* Copyright 2013-2015 MultiMC Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <launch/LaunchStep.h>
+#include <minecraft/AssetsUtils.h>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+
+/**
+ * Puts together the virtual assets folder used by old versions of the game, off the GUI thread.
+ *
+ * Also removes virtual assets folders that have not been used in a long time.
+ */
+class ReconstructAssets: public LaunchStep
+{
+	Q_OBJECT
+public:
+	explicit ReconstructAssets(LaunchTask *parent);
+	virtual ~ReconstructAssets(){};
+
+	virtual void executeTask();
+	virtual bool canAbort() const
+	{
+		return false;
+	}
+	void setAssetsId(const QString &assetsId)
+	{
+		m_assetsId = assetsId;
+	}
+
+private slots:
+	void reconstructFinished();
+
+private:
+	QString m_assetsId;
+	QFutureWatcher<AssetsUtils::ReconstructStats> m_watcher;
+	QElapsedTimer m_timer;
+};
@@ -32,6 +32,7 @@ void Update::executeTask()
 
 void Update::proceed()
 {
+	trackSubTask(m_updateTask.get(), tr("Instance update"));
 	m_updateTask->start();
 }
 
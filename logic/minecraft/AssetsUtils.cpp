@@ -20,6 +20,9 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QVariant>
+#include <QDateTime>
+#include <QSet>
+#include <QtConcurrentMap>
 #include <QDebug>
 
 #include "AssetsUtils.h"
@@ -122,16 +125,64 @@ bool loadAssetsIndexJson(QString path, AssetsIndex *index)
 	return true;
 }
 
-QDir reconstructAssets(QString assetsId)
+namespace
+{
+enum class LinkResult
+{
+	Linked,
+	Copied,
+	Present,
+	Failed
+};
+
+struct AssetLink
+{
+	QString original;
+	QString target;
+	LinkResult result;
+};
+
+void linkAsset(AssetLink &link)
+{
+	// try the cheap thing first, only look closer if it fails
+	if (FS::createHardLink(link.original, link.target))
+	{
+		link.result = LinkResult::Linked;
+	}
+	else if (QFile::exists(link.target))
+	{
+		link.result = LinkResult::Present;
+	}
+	else if (QFile::copy(link.original, link.target))
+	{
+		link.result = LinkResult::Copied;
+	}
+	else
+	{
+		link.result = LinkResult::Failed;
+	}
+}
+
+QString lastUsedPath(const QDir &virtualRoot)
+{
+	return virtualRoot.absoluteFilePath(".lastused");
+}
+}
+
+QDir virtualAssetsDir(QString assetsId)
+{
+	return QDir(FS::PathCombine("assets/virtual", assetsId));
+}
+
+QDir reconstructAssets(QString assetsId, ReconstructStats *stats)
 {
 	QDir assetsDir = QDir("assets/");
 	QDir indexDir = QDir(FS::PathCombine(assetsDir.path(), "indexes"));
 	QDir objectDir = QDir(FS::PathCombine(assetsDir.path(), "objects"));
-	QDir virtualDir = QDir(FS::PathCombine(assetsDir.path(), "virtual"));
+	QDir virtualRoot = virtualAssetsDir(assetsId);
 
 	QString indexPath = FS::PathCombine(indexDir.path(), assetsId + ".json");
 	QFile indexFile(indexPath);
-	QDir virtualRoot(FS::PathCombine(virtualDir.path(), assetsId));
 
 	if (!indexFile.exists())
 	{
@@ -139,9 +190,6 @@ QDir reconstructAssets(QString assetsId)
 		return virtualRoot;
 	}
 
-	qDebug() << "reconstructAssets" << assetsDir.path() << indexDir.path()
-				 << objectDir.path() << virtualDir.path() << virtualRoot.path();
-
 	AssetsIndex index;
 	bool loadAssetsIndex = AssetsUtils::loadAssetsIndexJson(indexPath, &index);
 
@@ -149,36 +197,100 @@ QDir reconstructAssets(QString assetsId)
 	{
 		qDebug() << "Reconstructing virtual assets folder at" << virtualRoot.path();
 
-		for (QString map : index.objects.keys())
+		QVector<AssetLink> links;
+		links.reserve(index.objects.size());
+		QSet<QString> targetDirs;
+		for (auto iter = index.objects.constBegin(); iter != index.objects.constEnd(); ++iter)
 		{
-			AssetObject asset_object = index.objects.value(map);
-			QString target_path = FS::PathCombine(virtualRoot.path(), map);
-			QFile target(target_path);
+			const auto &hash = iter.value().hash;
+			AssetLink link;
+			link.original = FS::PathCombine(objectDir.path(), hash.left(2), hash);
+			link.target = FS::PathCombine(virtualRoot.path(), iter.key());
+			link.result = LinkResult::Failed;
+			targetDirs.insert(QFileInfo(link.target).path());
+			links.append(link);
+		}
+
+		// create the folders up front, so the workers don't race for them
+		QDir root;
+		for (const auto &dir : targetDirs)
+		{
+			root.mkpath(dir);
+		}
 
-			QString tlk = asset_object.hash.left(2);
+		QtConcurrent::blockingMap(links, linkAsset);
 
-			QString original_path = FS::PathCombine(objectDir.path(), tlk, asset_object.hash);
-			QFile original(original_path);
-			if (!original.exists())
-				continue;
-			if (!target.exists())
+		ReconstructStats result;
+		for (const auto &link : links)
+		{
+			switch (link.result)
 			{
-				QFileInfo info(target_path);
-				QDir target_dir = info.dir();
-				// qDebug() << target_dir;
-				if (!target_dir.exists())
-					QDir("").mkpath(target_dir.path());
-
-				bool couldCopy = original.copy(target_path);
-				qDebug() << " Copying" << original_path << "to" << target_path
-							 << QString::number(couldCopy); // << original.errorString();
+			case LinkResult::Linked:
+				result.linked++;
+				break;
+			case LinkResult::Copied:
+				result.copied++;
+				break;
+			case LinkResult::Present:
+				result.present++;
+				break;
+			case LinkResult::Failed:
+				result.failed++;
+				break;
 			}
 		}
+		qDebug() << "Virtual assets:" << result.linked << "linked," << result.copied << "copied,"
+				 << result.present << "already present," << result.failed << "failed";
+		if (stats)
+		{
+			*stats = result;
+		}
 
-		// TODO: Write last used time to virtualRoot/.lastused
+		// lets removeStaleVirtualAssets know this one is still in use
+		FS::ensureFolderPathExists(virtualRoot.path());
+		QFile lastUsed(lastUsedPath(virtualRoot));
+		if (lastUsed.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		{
+			lastUsed.write(QDateTime::currentDateTimeUtc().toString(Qt::ISODate).toUtf8());
+		}
 	}
 
 	return virtualRoot;
 }
 
+int removeStaleVirtualAssets(int maxAgeDays, const QString &keepId)
+{
+	QDir virtualDir("assets/virtual");
+	const auto cutoff = QDateTime::currentDateTimeUtc().addDays(-maxAgeDays);
+	int removed = 0;
+	for (const auto &id : virtualDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+	{
+		if (id == keepId)
+		{
+			continue;
+		}
+		QDir virtualRoot(virtualDir.absoluteFilePath(id));
+		QDateTime lastUsed;
+		QFile marker(lastUsedPath(virtualRoot));
+		if (marker.open(QIODevice::ReadOnly))
+		{
+			lastUsed = QDateTime::fromString(QString::fromUtf8(marker.readAll()).trimmed(), Qt::ISODate);
+		}
+		if (!lastUsed.isValid())
+		{
+			// made before there were markers, go by the folder itself
+			lastUsed = QFileInfo(virtualRoot.absolutePath()).lastModified();
+		}
+		if (lastUsed.toUTC() < cutoff)
+		{
+			qDebug() << "Removing stale virtual assets folder" << virtualRoot.absolutePath();
+			if (FS::deletePath(virtualRoot.absolutePath()))
+			{
+				removed++;
+			}
+		}
+	}
+	return removed;
+}
+
 }
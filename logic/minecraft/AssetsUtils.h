@@ -17,6 +17,9 @@
 
 #include <QString>
 #include <QMap>
+#include <QDir>
+
+#include "multimc_logic_export.h"
 
 struct AssetObject
 {
@@ -32,7 +35,30 @@ struct AssetsIndex
 
 namespace AssetsUtils
 {
+/// What reconstructAssets did with the objects of the index
+struct ReconstructStats
+{
+	int linked = 0;
+	int copied = 0;
+	int present = 0;
+	int failed = 0;
+};
+
+/// Virtual assets folders not used for this long get deleted
+const int staleVirtualAssetsDays = 30;
+
 bool loadAssetsIndexJson(QString file, AssetsIndex* index);
-/// Reconstruct a virtual assets folder for the given assets ID and return the folder
-QDir reconstructAssets(QString assetsId);
+/// The virtual assets folder for the given assets ID. Does not create it.
+MULTIMC_LOGIC_EXPORT QDir virtualAssetsDir(QString assetsId);
+/**
+ * Reconstruct a virtual assets folder for the given assets ID and return the folder
+ * Objects are hard linked into place where possible and copied otherwise, in parallel.
+ * This blocks, don't call it from the GUI thread.
+ */
+MULTIMC_LOGIC_EXPORT QDir reconstructAssets(QString assetsId, ReconstructStats *stats = nullptr);
+/**
+ * Delete the virtual assets folders that were not used for maxAgeDays, except the one for keepId
+ * Returns how many were deleted.
+ */
+MULTIMC_LOGIC_EXPORT int removeStaleVirtualAssets(int maxAgeDays, const QString &keepId = QString());
 }
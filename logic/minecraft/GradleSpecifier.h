@@ -3,6 +3,7 @@
 #include <QString>
 #include <QStringList>
 #include "DefaultVariable.h"
+#include "StringPool.h"
 
 struct GradleSpecifier
 {
@@ -30,13 +31,14 @@ struct GradleSpecifier
 		QRegExp matcher("([^:@]+):([^:@]+):([^:@]+)" "(:([^:@]+))?" "(@([^:@]+))?");
 		m_valid = matcher.exactMatch(value);
 		auto elements = matcher.capturedTexts();
-		m_groupId = elements[1];
-		m_artifactId = elements[2];
-		m_version = elements[3];
-		m_classifier = elements[5];
+		// the same few libraries show up in every profile, share the strings
+		m_groupId = StringPool::intern(elements[1]);
+		m_artifactId = StringPool::intern(elements[2]);
+		m_version = StringPool::intern(elements[3]);
+		m_classifier = StringPool::intern(elements[5]);
 		if(!elements[7].isEmpty())
 		{
-			m_extension = elements[7];
+			m_extension = StringPool::intern(elements[7]);
 		}
 		return *this;
 	}
@@ -87,7 +89,7 @@ struct GradleSpecifier
 	}
 	inline void setClassifier(const QString & classifier)
 	{
-		m_classifier = classifier;
+		m_classifier = StringPool::intern(classifier);
 	}
 	inline QString classifier() const
 	{
@@ -1,6 +1,95 @@
 #include "Library.h"
 #include <FileSystem.h>
 
+#include <QHash>
+#include <QJsonDocument>
+#include <QMutex>
+#include <QMutexLocker>
+
+namespace
+{
+QMutex sharedLock;
+/// libraries handed out by sharedCopy, by sharingKey. They go away when no profile uses them.
+QHash<QString, std::weak_ptr<Library>> sharedLibraries;
+/// drop the expired entries once there are this many
+int sharedPruneSize = 256;
+}
+
+QString Library::sharingKey() const
+{
+	// unit separators between the values, the list sizes keep the lists apart
+	const QChar sep(0x1f);
+	QString key = (QString)m_name + sep + m_base_url + sep + m_hint + sep + m_absolute_url + sep +
+				  m_storagePrefix;
+	key += sep + QString::number(extract_excludes.size());
+	for (auto &exclude : extract_excludes)
+	{
+		key += sep + exclude;
+	}
+	key += sep + QString::number(m_native_classifiers.size());
+	for (auto iter = m_native_classifiers.begin(); iter != m_native_classifiers.end(); iter++)
+	{
+		key += sep + OpSys_toString(iter.key()) + sep + iter.value();
+	}
+	key += sep + QString::number(m_rules.size());
+	for (auto &rule : m_rules)
+	{
+		key += sep + QString::fromUtf8(QJsonDocument(rule->toJson()).toJson(QJsonDocument::Compact));
+	}
+	return key;
+}
+
+LibraryPtr Library::sharedCopy(LibraryPtr base)
+{
+	// invalid names all look the same, do not mix them up
+	if (!base->m_name.valid())
+	{
+		return limitedCopy(base);
+	}
+	const QString key = base->sharingKey();
+	QMutexLocker locker(&sharedLock);
+	auto iter = sharedLibraries.find(key);
+	if (iter != sharedLibraries.end())
+	{
+		if (auto existing = iter.value().lock())
+		{
+			return existing;
+		}
+	}
+	auto copy = limitedCopy(base);
+	sharedLibraries.insert(key, copy);
+	if (sharedLibraries.size() >= sharedPruneSize)
+	{
+		for (auto prune = sharedLibraries.begin(); prune != sharedLibraries.end();)
+		{
+			if (prune.value().expired())
+			{
+				prune = sharedLibraries.erase(prune);
+			}
+			else
+			{
+				prune++;
+			}
+		}
+		sharedPruneSize = qMax(256, sharedLibraries.size() * 2);
+	}
+	return copy;
+}
+
+int Library::sharedCount()
+{
+	QMutexLocker locker(&sharedLock);
+	int count = 0;
+	for (auto &shared : sharedLibraries)
+	{
+		if (!shared.expired())
+		{
+			count++;
+		}
+	}
+	return count;
+}
+
 QStringList Library::files() const
 {
 	QStringList retval;
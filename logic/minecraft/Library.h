@@ -13,12 +13,14 @@
 #include "GradleSpecifier.h"
 #include "net/URLConstants.h"
 
+#include "multimc_logic_export.h"
+
 class MojangLibraryDownloadInfo;
 class Library;
 
 typedef std::shared_ptr<Library> LibraryPtr;
 
-class Library
+class MULTIMC_LOGIC_EXPORT Library
 {
 	friend class OneSixVersionFormat;
 	friend class MojangVersionFormat;
@@ -45,6 +47,15 @@ public:
 		return newlib;
 	}
 
+	/**
+	 * Same as limitedCopy, but shared with every other profile that uses an identical library.
+	 * The result must not be modified, make a limitedCopy of it to do that.
+	 */
+	static LibraryPtr sharedCopy(LibraryPtr base);
+
+	/// number of distinct libraries currently shared through sharedCopy
+	static int sharedCount();
+
 public: /* methods */
 	/// Returns the raw name field
 	const GradleSpecifier & rawName() const
@@ -146,6 +157,10 @@ public: /* methods */
 	/// Get the URL to download the library from
 	QString url() const;
 
+private:
+	/// everything limitedCopy keeps, as one string
+	QString sharingKey() const;
+
 protected: /* data */
 	/// the basic gradle dependency specifier.
 	GradleSpecifier m_name;
@@ -6,6 +6,7 @@
 #include <MMCStrings.h>
 #include <pathmatcher/RegexpMatcher.h>
 #include <pathmatcher/MultiMatcher.h>
+#include <pathmatcher/CompiledMatcher.h>
 #include <FileSystem.h>
 #include <java/JavaVersion.h>
 
@@ -48,6 +49,7 @@ MinecraftInstance::MinecraftInstance(SettingsObjectPtr globalSettings, SettingsO
 
 	m_settings->registerOverride(globalSettings->getSetting("JavaPath"), javaOrLocation);
 	m_settings->registerOverride(globalSettings->getSetting("JvmArgs"), javaOrArgs);
+	m_settings->registerOverride(globalSettings->getSetting("JavaClassDataSharing"), javaOrArgs);
 
 	// special!
 	m_settings->registerPassthrough(globalSettings->getSetting("JavaTimestamp"), javaOrLocation);
@@ -82,6 +84,11 @@ std::shared_ptr< BaseVersionList > MinecraftInstance::versionList() const
 	return ENV.getVersionList("net.minecraft");
 }
 
+QString MinecraftInstance::launcherJar()
+{
+	return FS::PathCombine(QCoreApplication::applicationDirPath(), "jars", "NewLaunch.jar");
+}
+
 QStringList MinecraftInstance::javaArguments() const
 {
 	QStringList args;
@@ -116,7 +123,8 @@ QStringList MinecraftInstance::javaArguments() const
 	}
 
 	args << "-Duser.language=en";
-	args << "-jar" << FS::PathCombine(QCoreApplication::applicationDirPath(), "jars", "NewLaunch.jar");
+
+	args << "-jar" << launcherJar();
 
 	return args;
 }
@@ -316,7 +324,7 @@ IPathMatcher::Ptr MinecraftInstance::getLogFileMatcher()
 	combined->add(std::make_shared<RegexpMatcher>("crash-.*\\.txt"));
 	combined->add(std::make_shared<RegexpMatcher>("IDMap dump.*\\.txt$"));
 	combined->add(std::make_shared<RegexpMatcher>("ModLoader\\.txt(\\..*)?$"));
-	return combined;
+	return CompiledMatcher::compile(combined);
 }
 
 QString MinecraftInstance::getLogFileRoot()
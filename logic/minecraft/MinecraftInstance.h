@@ -42,9 +42,24 @@ public:
 	//FIXME: nuke?
 	virtual std::shared_ptr<BaseVersionList> versionList() const override;
 
+	/// get the class path the game is launched with
+	virtual QStringList classPath() const
+	{
+		return QStringList();
+	}
+
+	/// get the files the class path is made from. Same as the class path, unless parts of it are built before launch.
+	virtual QStringList classPathInputs() const
+	{
+		return classPath();
+	}
+
 	/// get arguments passed to java
 	QStringList javaArguments() const;
 
+	/// get the jar java is started with, which then loads the game
+	static QString launcherJar();
+
 	/// get variables for launch command variable substitution/environment
 	virtual QMap<QString, QString> getVariables() const override;
 
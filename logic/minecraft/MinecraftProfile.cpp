@@ -51,14 +51,30 @@ ProfileStrategy* MinecraftProfile::strategy()
 
 void MinecraftProfile::reload()
 {
+	auto fingerprint = m_strategy->inputsFingerprint();
+	m_loadedFingerprint.clear();
 	beginResetModel();
 	m_strategy->load();
-	reapplySafe();
+	if(reapplySafe())
+	{
+		m_loadedFingerprint = fingerprint;
+	}
 	endResetModel();
 }
 
+bool MinecraftProfile::isUpToDate()
+{
+	if(m_loadedFingerprint.isEmpty())
+	{
+		return false;
+	}
+	return m_strategy->inputsFingerprint() == m_loadedFingerprint;
+}
+
 void MinecraftProfile::clear()
 {
+	// whatever gets applied next may not match what was loaded from disk
+	m_loadedFingerprint.clear();
 	id.clear();
 	m_updateTime = QDateTime();
 	m_releaseTime = QDateTime();
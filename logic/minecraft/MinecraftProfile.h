@@ -79,6 +79,9 @@ public:
 	/// reload all profile patches from storage, clear the profile and apply the patches
 	void reload();
 
+	/// true if the profile was loaded successfully and nothing it was loaded from changed since
+	bool isUpToDate();
+
 	/// clear the profile
 	void clear();
 
@@ -195,4 +198,6 @@ public: /* data */
 private:
 	QList<ProfilePatchPtr> VersionPatches;
 	ProfileStrategy *m_strategy = nullptr;
+	/// inputs fingerprint of the last successful reload, empty if the profile changed since
+	QString m_loadedFingerprint;
 };
@@ -117,6 +117,7 @@ static bool cmpVersions(BaseVersionPtr first, BaseVersionPtr second)
 void MinecraftVersionList::sortInternal()
 {
 	qSort(m_vlist.begin(), m_vlist.end(), cmpVersions);
+	rebuildIndex();
 }
 
 void MinecraftVersionList::loadCachedList()
@@ -359,6 +360,10 @@ QVariant MinecraftVersionList::data(const QModelIndex& index, int role) const
 	case TypeRole:
 		return version->typeString();
 
+	case VersionKeyRole:
+	case ParentGameVersionKeyRole:
+		return BaseVersionList::data(index, role);
+
 	default:
 		return QVariant();
 	}
@@ -613,15 +618,7 @@ void MinecraftVersionList::saveCachedList()
 
 void MinecraftVersionList::finalizeUpdate(QString version)
 {
-	int idx = -1;
-	for (int i = 0; i < m_vlist.size(); i++)
-	{
-		if (version == m_vlist[i]->descriptor())
-		{
-			idx = i;
-			break;
-		}
-	}
+	int idx = findVersionRow(version);
 	if (idx == -1)
 	{
 		return;
@@ -25,6 +25,8 @@
 #include "Mod.h"
 #include "settings/INIFile.h"
 #include <FileSystem.h>
+#include <Env.h>
+#include "ModStore.h"
 #include <QDebug>
 
 Mod::Mod(const QFileInfo &file)
@@ -274,7 +276,9 @@ bool Mod::replace(Mod &with)
 	if (t == MOD_ZIPFILE || t == MOD_SINGLEFILE || t == MOD_LITEMOD)
 	{
 		qDebug() << "Copy: " << with.m_file.filePath() << " to " << m_file.filePath();
-		success = QFile::copy(with.m_file.filePath(), m_file.filePath());
+		auto store = ENV.modStore();
+		success = store ? store->install(with.m_file.filePath(), m_file.filePath())
+						: QFile::copy(with.m_file.filePath(), m_file.filePath());
 	}
 	if (t == MOD_FOLDER)
 	{
@@ -311,8 +315,8 @@ bool Mod::destroy()
 	}
 	else if (m_type == MOD_SINGLEFILE || m_type == MOD_ZIPFILE || m_type == MOD_LITEMOD)
 	{
-		QFile f(m_file.filePath());
-		if (f.remove())
+		// files from the mod store are read-only
+		if (FS::removeFile(m_file.filePath()))
 		{
 			m_type = MOD_UNKNOWN;
 			return true;
@@ -15,6 +15,8 @@
 
 #include "ModList.h"
 #include <FileSystem.h>
+#include <Env.h>
+#include "ModStore.h"
 #include <QMimeData>
 #include <QUrl>
 #include <QUuid>
@@ -276,7 +278,11 @@ bool ModList::installMod(const QString &filename, int index)
 	if (type == Mod::MOD_SINGLEFILE || type == Mod::MOD_ZIPFILE || type == Mod::MOD_LITEMOD)
 	{
 		QString newpath = FS::PathCombine(m_dir.path(), fileinfo.fileName());
-		if (!QFile::copy(fileinfo.filePath(), newpath))
+		// with the mod store, instances share one copy of the file
+		auto store = ENV.modStore();
+		bool copied = store ? store->install(fileinfo.filePath(), newpath)
+							: QFile::copy(fileinfo.filePath(), newpath);
+		if (!copied)
 			return false;
 		m.repath(newpath);
 		beginInsertRows(QModelIndex(), index, index);
@@ -0,0 +1,378 @@
+#include "ModStore.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QtConcurrentRun>
+
+#include "FileSystem.h"
+
+namespace
+{
+QString mebibytes(qint64 bytes)
+{
+	return QString::number(double(bytes) / (1024 * 1024), 'f', 1) + " MiB";
+}
+
+/// stored files are shared by all the instances linking to them, so nobody gets to change one
+void protect(const QString &blob)
+{
+	QFile::setPermissions(blob, QFile::ReadOwner | QFile::ReadUser | QFile::ReadGroup | QFile::ReadOther);
+}
+}
+
+QString ModStore::Report::toString() const
+{
+	return QString("%1 files in the mod store (%2), linked %3 times (%4 without the store), "
+				   "%5 saved, %6 unused files (%7)")
+		.arg(blobs)
+		.arg(mebibytes(storedBytes))
+		.arg(references)
+		.arg(mebibytes(referencedBytes))
+		.arg(mebibytes(savedBytes()))
+		.arg(garbage)
+		.arg(mebibytes(garbageBytes));
+}
+
+ModStore::ModStore(const QString &root) : m_root(QDir(root).absolutePath()), m_stopping(false)
+{
+}
+
+bool ModStore::canLinkInto(const QString &folder)
+{
+	auto key = QDir(folder).absolutePath();
+	QMutexLocker locker(&m_linkableLock);
+	auto found = m_linkable.constFind(key);
+	if (found != m_linkable.constEnd())
+	{
+		return *found;
+	}
+	bool linkable = probeLinks(key);
+	if (!linkable)
+	{
+		qDebug() << "Mod store: no hard links possible to" << key << ", copying files there";
+	}
+	m_linkable.insert(key, linkable);
+	return linkable;
+}
+
+bool ModStore::probeLinks(const QString &folder) const
+{
+	// next to the stored files, not among them, or the garbage collection could take the probe
+	if (!QDir().mkpath(m_root) || !QDir().mkpath(folder))
+	{
+		return false;
+	}
+	return FS::canHardLink(m_root, folder);
+}
+
+void ModStore::stopMaintenance()
+{
+	m_stopping = true;
+}
+
+QString ModStore::hashFile(const QString &path)
+{
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		return QString();
+	}
+	QCryptographicHash hash(QCryptographicHash::Sha256);
+	if (!hash.addData(&file))
+	{
+		return QString();
+	}
+	return hash.result().toHex();
+}
+
+QString ModStore::blobPath(const QString &hash) const
+{
+	return FS::PathCombine(m_root, "objects", hash.left(2) + "/" + hash);
+}
+
+bool ModStore::isStorable(const QString &path)
+{
+	auto name = QFileInfo(path).fileName().toLower();
+	if (name.endsWith(".disabled"))
+	{
+		name.chop(9);
+	}
+	return name.endsWith(".jar") || name.endsWith(".zip") || name.endsWith(".litemod");
+}
+
+QString ModStore::store(const QString &path, const QString &hash, bool mayTakeFile, bool *took)
+{
+	if (took)
+	{
+		*took = false;
+	}
+	if (hash.isEmpty())
+	{
+		return QString();
+	}
+	auto blob = blobPath(hash);
+	QFileInfo stored(blob);
+	if (stored.isFile())
+	{
+		if (stored.size() == QFileInfo(path).size())
+		{
+			return blob;
+		}
+		// written to in place through one of its links, it doesn't have the contents its name says
+		qWarning() << "Mod store file" << blob << "was changed, storing it again";
+		if (!FS::removeFile(blob))
+		{
+			return QString();
+		}
+	}
+	if (!QDir().mkpath(QFileInfo(blob).absolutePath()))
+	{
+		return QString();
+	}
+	// a file that is already in an instance folder becomes the stored file as it is
+	if (mayTakeFile && FS::createHardLink(path, blob))
+	{
+		protect(blob);
+		if (took)
+		{
+			*took = true;
+		}
+		return blob;
+	}
+	// anything else is copied, so changes to the original don't reach the store
+	auto part = blob + ".part";
+	FS::removeFile(part);
+	if (!QFile::copy(path, part))
+	{
+		return QString();
+	}
+	protect(part);
+	if (!QFile::rename(part, blob))
+	{
+		FS::removeFile(part);
+		// someone else stored it in the meantime
+		return QFileInfo(blob).isFile() ? blob : QString();
+	}
+	return blob;
+}
+
+QString ModStore::relink(const QString &path)
+{
+	QFileInfo info(path);
+	if (!info.isFile() || info.isSymLink() || !isStorable(path))
+	{
+		return QString();
+	}
+	auto hash = hashFile(path);
+	QMutexLocker locker(&m_lock);
+	bool took = false;
+	auto blob = store(path, hash, true, &took);
+	if (blob.isEmpty() || took)
+	{
+		return blob;
+	}
+	// replace the file with a link, without a moment where there is neither
+	auto temp = path + ".mmc-link";
+	FS::removeFile(temp);
+	if (!FS::createHardLink(blob, temp))
+	{
+		return QString();
+	}
+	bool replaced = FS::replaceFile(temp, path);
+	// still there if it failed, or if path already was a link to the same file
+	FS::removeFile(temp);
+	return replaced ? blob : QString();
+}
+
+bool ModStore::install(const QString &source, const QString &destination)
+{
+	// without links, a stored file would only be one more copy
+	if (!isStorable(source) || !canLinkInto(QFileInfo(destination).absolutePath()))
+	{
+		return QFile::copy(source, destination);
+	}
+	auto hash = hashFile(source);
+	QMutexLocker locker(&m_lock);
+	auto blob = store(source, hash, false);
+	if (blob.isEmpty())
+	{
+		return QFile::copy(source, destination);
+	}
+	if (FS::createHardLink(blob, destination))
+	{
+		return true;
+	}
+	// not from the stored file, a copy of that would be read-only
+	return QFile::copy(source, destination);
+}
+
+bool ModStore::deduplicate(const QString &path)
+{
+	return !relink(path).isEmpty();
+}
+
+bool ModStore::linkTree(const QString &source, const QString &destination)
+{
+	if (!QDir().mkpath(destination))
+	{
+		return false;
+	}
+	// the files in source get linked too, so both sides have to be able to
+	if (!canLinkInto(source) || !canLinkInto(destination))
+	{
+		return FS::copy(source, destination).followSymlinks(false)();
+	}
+	bool OK = true;
+	linkTreeInto(source, destination, OK);
+	return OK;
+}
+
+void ModStore::linkTreeInto(const QString &source, const QString &destination, bool &OK)
+{
+	QDir src(source);
+	if (!QDir().mkpath(destination))
+	{
+		OK = false;
+		return;
+	}
+	auto entries = src.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System);
+	for (auto &entry : entries)
+	{
+		auto target = FS::PathCombine(destination, entry.fileName());
+		if (entry.isSymLink())
+		{
+			OK &= QFile::link(entry.symLinkTarget(), target);
+		}
+		else if (entry.isDir())
+		{
+			linkTreeInto(entry.absoluteFilePath(), target, OK);
+		}
+		else
+		{
+			auto blob = relink(entry.absoluteFilePath());
+			if (blob.isEmpty() || !FS::createHardLink(blob, target))
+			{
+				OK &= QFile::copy(entry.absoluteFilePath(), target);
+			}
+		}
+	}
+}
+
+ModStore::Report ModStore::scan(bool removeGarbage) const
+{
+	Report report;
+	QDirIterator iter(FS::PathCombine(m_root, "objects"), QDir::Files | QDir::Hidden,
+					  QDirIterator::Subdirectories);
+	while (iter.hasNext() && !m_stopping)
+	{
+		auto path = iter.next();
+		if (path.endsWith(".part"))
+		{
+			continue;
+		}
+		// a file that is being stored or linked right now isn't garbage yet
+		QMutexLocker locker(&m_lock);
+		auto links = FS::hardLinkCount(path);
+		if (links < 1)
+		{
+			continue;
+		}
+		auto size = iter.fileInfo().size();
+		report.blobs++;
+		report.storedBytes += size;
+		report.references += links - 1;
+		report.referencedBytes += size * (links - 1);
+		if (links == 1)
+		{
+			report.garbage++;
+			report.garbageBytes += size;
+			if (removeGarbage && !FS::removeFile(path))
+			{
+				qWarning() << "Couldn't remove unused mod store file" << path;
+			}
+		}
+	}
+	return report;
+}
+
+ModStore::Report ModStore::report() const
+{
+	return scan(false);
+}
+
+ModStore::Report ModStore::collectGarbage()
+{
+	return scan(true);
+}
+
+bool ModStore::lastReport(Report *report) const
+{
+	QMutexLocker locker(&m_lock);
+	if (m_hasReport && report)
+	{
+		*report = m_lastReport;
+	}
+	return m_hasReport;
+}
+
+QStringList ModStore::instanceModFolders()
+{
+	return {"minecraft/mods", "minecraft/coremods", "minecraft/resourcepacks",
+			"minecraft/texturepacks", ".minecraft/mods", ".minecraft/coremods",
+			".minecraft/resourcepacks", ".minecraft/texturepacks", "instMods"};
+}
+
+int ModStore::deduplicateTree(const QString &folder)
+{
+	int linked = 0;
+	QDirIterator iter(folder, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+	while (iter.hasNext() && !m_stopping)
+	{
+		auto path = iter.next();
+		if (iter.fileInfo().isSymLink() || !isStorable(path) || FS::hardLinkCount(path) != 1)
+		{
+			continue;
+		}
+		if (!relink(path).isEmpty())
+		{
+			linked++;
+		}
+	}
+	return linked;
+}
+
+void ModStore::maintainInBackground(std::shared_ptr<ModStore> store, const QStringList &instanceRoots)
+{
+	QtConcurrent::run([store, instanceRoots]()
+	{
+		int linked = 0;
+		for (auto &root : instanceRoots)
+		{
+			if (!store->canLinkInto(root))
+			{
+				continue;
+			}
+			for (auto &folder : instanceModFolders())
+			{
+				linked += store->deduplicateTree(FS::PathCombine(root, folder));
+			}
+		}
+		auto report = store->collectGarbage();
+		if (store->m_stopping)
+		{
+			qDebug() << "Mod store: maintenance stopped," << linked << "files linked";
+			return;
+		}
+		{
+			QMutexLocker locker(&store->m_lock);
+			store->m_lastReport = report;
+			store->m_hasReport = true;
+		}
+		qDebug() << "Mod store:" << linked << "files linked," << report.toString();
+	});
+}
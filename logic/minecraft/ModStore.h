@@ -0,0 +1,135 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <memory>
+
+#include "multimc_logic_export.h"
+
+/**
+ * Keeps one copy of each mod file, shared by all the instances that use it.
+ *
+ * Files are stored by the SHA-256 of their contents. Instance folders hold hard links to the
+ * stored files, so a jar used by many instances takes up its space only once. A stored file
+ * nothing links to anymore is garbage and gets removed by collectGarbage().
+ *
+ * Where hard links can't be made (another volume, FAT, ...), files are copied like before and
+ * nothing is added to the store. That is found out once per folder, see canLinkInto().
+ */
+class MULTIMC_LOGIC_EXPORT ModStore
+{
+public:
+	struct Report
+	{
+		/// files in the store
+		int blobs = 0;
+		/// space the store takes up
+		qint64 storedBytes = 0;
+		/// links from instance folders into the store
+		int references = 0;
+		/// space the same files would take up if each instance had its own copy
+		qint64 referencedBytes = 0;
+		/// files nothing links to anymore
+		int garbage = 0;
+		qint64 garbageBytes = 0;
+
+		qint64 savedBytes() const
+		{
+			return referencedBytes - storedBytes + garbageBytes;
+		}
+		QString toString() const;
+	};
+
+	explicit ModStore(const QString &root);
+	virtual ~ModStore() = default;
+
+	/// Whether files in folder can be links into the store. Probed the first time, then remembered.
+	bool canLinkInto(const QString &folder);
+
+	/// Put the contents of source at destination, as a link into the store if possible
+	bool install(const QString &source, const QString &destination);
+
+	/// Make an existing file a link into the store, adding it to the store first if needed
+	bool deduplicate(const QString &path);
+
+	/**
+	 * Make destination a copy of the source folder tree, with every storable file a link into the store.
+	 * The storable files in source become links into the store too.
+	 */
+	bool linkTree(const QString &source, const QString &destination);
+
+	/**
+	 * Make the storable files in a folder tree links into the store.
+	 * Files that already have other names are skipped, so only new files get read.
+	 * Returns how many files became links.
+	 */
+	int deduplicateTree(const QString &folder);
+
+	/// What is in the store and how much it saves
+	Report report() const;
+
+	/// Remove the stored files nothing links to anymore. Returns what was there before.
+	Report collectGarbage();
+
+	/// The report of the last maintenance, from before its garbage collection. False if none finished yet.
+	bool lastReport(Report *report) const;
+
+	/**
+	 * On a worker thread: link the mod folders of the instances at instanceRoots into the store,
+	 * then collect the garbage and log the report. Roots that can't link into the store are skipped.
+	 */
+	static void maintainInBackground(std::shared_ptr<ModStore> store, const QStringList &instanceRoots);
+
+	/**
+	 * Make the folder scans and the garbage collection stop at the next file, for quitting.
+	 * What is left is picked up by the next maintenance.
+	 */
+	void stopMaintenance();
+
+	/// the folders of an instance, relative to its root, that hold files for the store
+	static QStringList instanceModFolders();
+
+	/// SHA-256 of the file's contents, hex encoded. Empty if the file can't be read.
+	static QString hashFile(const QString &path);
+
+	/// where the store keeps the file with the given hash
+	QString blobPath(const QString &hash) const;
+
+	/**
+	 * Only archives are stored: jars, zips and litemods, enabled or not.
+	 * The game never writes to those, while a config edited in place would change for every instance.
+	 */
+	static bool isStorable(const QString &path);
+
+protected:
+	/// try if a hard link from the store to folder works
+	virtual bool probeLinks(const QString &folder) const;
+
+private:
+	/**
+	 * The stored file with the given hash, added from path if it's not there yet. Empty on failure.
+	 * Needs m_lock: until it is linked from somewhere, a new stored file looks like garbage.
+	 */
+	QString store(const QString &path, const QString &hash, bool mayTakeFile, bool *took = nullptr);
+	/// make path a link to its stored file, returns the stored file. Empty on failure.
+	QString relink(const QString &path);
+	Report scan(bool removeGarbage) const;
+	void linkTreeInto(const QString &source, const QString &destination, bool &OK);
+
+private:
+	QString m_root;
+	/// held while a stored file is looked up or added and then linked, and by the garbage collection per file
+	mutable QMutex m_lock;
+	std::atomic<bool> m_stopping;
+	/// set by the maintenance, under m_lock
+	Report m_lastReport;
+	bool m_hasReport = false;
+	/// what canLinkInto() found out, by folder
+	QHash<QString, bool> m_linkable;
+	QMutex m_linkableLock;
+};
+
+typedef std::shared_ptr<ModStore> ModStorePtr;
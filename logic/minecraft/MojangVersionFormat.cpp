@@ -7,6 +7,7 @@
 #include "Json.h"
 using namespace Json;
 #include "ParseUtils.h"
+#include "StringPool.h"
 
 static const int CURRENT_MINIMUM_LAUNCHER_VERSION = 14;
 
@@ -281,6 +282,7 @@ LibraryPtr MojangVersionFormat::libraryFromJson(const QJsonObject &libObj, const
 	out->m_name = libObj.value("name").toString();
 
 	Bits::readString(libObj, "url", out->m_base_url);
+	out->m_base_url = StringPool::intern(out->m_base_url);
 	if (libObj.contains("extract"))
 	{
 		out->applyExcludes = true;
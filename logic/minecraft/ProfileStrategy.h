@@ -30,6 +30,16 @@ public:
 
 	/// revert the custom patch to 'vanilla', if possible
 	virtual bool revertPatch(ProfilePatchPtr patch) = 0;
+
+	/**
+	 * Describe everything load() reads, cheaply (file sizes, timestamps, ...).
+	 * If it is the same as for the last load, loading again would produce the same profile.
+	 * An empty string means 'unknown' and always causes a full reload.
+	 */
+	virtual QString inputsFingerprint()
+	{
+		return QString();
+	}
 protected:
 	MinecraftProfile *profile;
 };
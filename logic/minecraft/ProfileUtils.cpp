@@ -8,6 +8,10 @@
 #include <QJsonArray>
 #include <QRegularExpression>
 #include <QSaveFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QHash>
+#include <QDateTime>
 
 namespace ProfileUtils
 {
@@ -132,6 +136,45 @@ VersionFilePtr parseJsonFile(const QFileInfo &fileInfo, const bool requireOrder)
 	return OneSixVersionFormat::versionFileFromJson(doc, file.fileName(), requireOrder);
 }
 
+namespace
+{
+struct ParsedFile
+{
+	QDateTime lastModified;
+	qint64 size = 0;
+	bool requireOrder = false;
+	VersionFilePtr file;
+};
+QMutex parsedFilesLock;
+QHash<QString, ParsedFile> parsedFiles;
+}
+
+VersionFilePtr parseJsonFileCached(const QFileInfo &fileInfo, const bool requireOrder)
+{
+	const QString path = fileInfo.absoluteFilePath();
+	QFileInfo current(path);
+	{
+		QMutexLocker locker(&parsedFilesLock);
+		auto iter = parsedFiles.constFind(path);
+		if (iter != parsedFiles.constEnd() && iter->requireOrder == requireOrder &&
+			iter->size == current.size() && iter->lastModified == current.lastModified())
+		{
+			return std::make_shared<VersionFile>(*iter->file);
+		}
+	}
+	ParsedFile parsed;
+	parsed.lastModified = current.lastModified();
+	parsed.size = current.size();
+	parsed.requireOrder = requireOrder;
+	// throws on failure, failures are not remembered
+	parsed.file = parseJsonFile(current, requireOrder);
+	{
+		QMutexLocker locker(&parsedFilesLock);
+		parsedFiles.insert(path, parsed);
+	}
+	return std::make_shared<VersionFile>(*parsed.file);
+}
+
 VersionFilePtr parseBinaryJsonFile(const QFileInfo &fileInfo)
 {
 	QFile file(fileInfo.absoluteFilePath());
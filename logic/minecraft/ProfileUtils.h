@@ -16,6 +16,12 @@ bool writeOverrideOrders(QString path, const PatchOrder &order);
 /// Parse a version file in JSON format
 VersionFilePtr parseJsonFile(const QFileInfo &fileInfo, const bool requireOrder);
 
+/**
+ * Parse a version file in JSON format, reusing a previous parse of the same file if its size and
+ * modification time didn't change. Always returns a fresh copy that the caller is free to modify.
+ */
+VersionFilePtr parseJsonFileCached(const QFileInfo &fileInfo, const bool requireOrder);
+
 /// Parse a version file in binary JSON format
 VersionFilePtr parseBinaryJsonFile(const QFileInfo &fileInfo);
 
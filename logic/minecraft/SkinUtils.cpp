@@ -18,17 +18,32 @@
 #include "Env.h"
 
 #include <QFile>
+#include <QHash>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 
 namespace SkinUtils
 {
+namespace
+{
+// decoded faces, including the misses, by id and size
+QHash<QString, QPixmap> faces;
+}
+
 /*
  * Given a username, return a pixmap of the cached skin (if it exists), QPixmap() otherwise
  */
 QPixmap getFaceFromCache(QString username, int height, int width)
 {
+	const QString key = QString("%1/%2x%3").arg(username).arg(height).arg(width);
+	auto iter = faces.constFind(key);
+	if (iter != faces.constEnd())
+	{
+		return *iter;
+	}
+
+	QPixmap face;
 	QFile fskin(ENV.metacache()
 					->resolveEntry("skins", username + ".png")
 					->getFullPath());
@@ -38,10 +53,16 @@ QPixmap getFaceFromCache(QString username, int height, int width)
 		QPixmap skin(fskin.fileName());
 		if(!skin.isNull())
 		{
-			return skin.copy(8, 8, 8, 8).scaled(height, width, Qt::KeepAspectRatio);
+			face = skin.copy(8, 8, 8, 8).scaled(height, width, Qt::KeepAspectRatio);
 		}
 	}
 
-	return QPixmap();
+	faces.insert(key, face);
+	return face;
+}
+
+void invalidateFaces()
+{
+	faces.clear();
 }
 }
@@ -21,5 +21,12 @@
 
 namespace SkinUtils
 {
+/// how long a downloaded skin is trusted before asking the server whether it changed
+const qint64 revalidateInterval = 24 * 60 * 60 * 1000;
+
+/// the face of a cached skin. Decoded faces are kept in memory, see invalidateFaces()
 QPixmap MULTIMC_LOGIC_EXPORT getFaceFromCache(QString id, int height = 64, int width = 64);
+
+/// forget the decoded faces, call when the skin files change
+void MULTIMC_LOGIC_EXPORT invalidateFaces();
 }
@@ -0,0 +1,36 @@
+#include "StringPool.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+
+namespace
+{
+QMutex poolLock;
+QSet<QString> pool;
+}
+
+namespace StringPool
+{
+QString intern(const QString &value)
+{
+	if (value.isEmpty())
+	{
+		return value;
+	}
+	QMutexLocker locker(&poolLock);
+	auto iter = pool.constFind(value);
+	if (iter != pool.constEnd())
+	{
+		return *iter;
+	}
+	pool.insert(value);
+	return value;
+}
+
+int size()
+{
+	QMutexLocker locker(&poolLock);
+	return pool.size();
+}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <QString>
+
+#include "multimc_logic_export.h"
+
+/**
+ * Process-wide pool of strings that repeat a lot, like the parts of library names.
+ *
+ * Equal strings returned by intern() share their data, so keeping many of them costs one copy.
+ */
+namespace StringPool
+{
+/// the pooled string equal to value
+MULTIMC_LOGIC_EXPORT QString intern(const QString &value);
+
+/// number of distinct strings in the pool
+MULTIMC_LOGIC_EXPORT int size();
+}
@@ -1,5 +1,6 @@
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QHash>
 
 #include <QDebug>
 
@@ -12,20 +13,36 @@
 #include "VersionBuildError.h"
 #include <Version.h>
 
-int findLibraryByName(QList<LibraryPtr> haystack, const GradleSpecifier &needle)
+namespace
 {
-	int retval = -1;
-	for (int i = 0; i < haystack.size(); ++i)
+/// index of libraries by name (group:artifact), so merging doesn't have to search the whole list for every library
+class LibraryNameIndex
+{
+public:
+	explicit LibraryNameIndex(const QList<LibraryPtr> &libraries)
 	{
-		if (haystack.at(i)->rawName().matchName(needle))
+		for (int i = 0; i < libraries.size(); ++i)
 		{
-			// only one is allowed.
-			if (retval != -1)
-				return -1;
-			retval = i;
+			add(libraries.at(i), i);
 		}
 	}
-	return retval;
+	void add(const LibraryPtr &library, int index)
+	{
+		m_index[library->rawName().artifactPrefix()].append(index);
+	}
+	/// returns the index of the only library matching the name of needle, -1 if there is none or more than one
+	int find(const GradleSpecifier &needle) const
+	{
+		auto iter = m_index.constFind(needle.artifactPrefix());
+		// only one is allowed.
+		if (iter == m_index.constEnd() || iter->size() != 1)
+			return -1;
+		return iter->first();
+	}
+
+private:
+	QHash<QString, QList<int>> m_index;
+};
 }
 
 bool VersionFile::isMinecraftVersion()
@@ -115,7 +132,7 @@ void VersionFile::applyTo(MinecraftProfile *version)
 		QList<LibraryPtr> libs;
 		for (auto lib : overwriteLibs)
 		{
-			libs.append(Library::limitedCopy(lib));
+			libs.append(Library::sharedCopy(lib));
 		}
 		if (isMinecraftVersion())
 		{
@@ -123,21 +140,24 @@ void VersionFile::applyTo(MinecraftProfile *version)
 		}
 		version->libraries = libs;
 	}
+	LibraryNameIndex libraryIndex(version->libraries);
 	for (auto addedLibrary : addLibs)
 	{
 		// find the library by name.
-		const int index = findLibraryByName(version->libraries, addedLibrary->rawName());
+		const int index = libraryIndex.find(addedLibrary->rawName());
 		// library not found? just add it.
 		if (index < 0)
 		{
-			version->libraries.append(Library::limitedCopy(addedLibrary));
+			auto library = Library::sharedCopy(addedLibrary);
+			libraryIndex.add(library, version->libraries.size());
+			version->libraries.append(library);
 			continue;
 		}
 		auto existingLibrary = version->libraries.at(index);
 		// if we are higher it means we should update
 		if (Version(addedLibrary->version()) > Version(existingLibrary->version()))
 		{
-			auto library = Library::limitedCopy(addedLibrary);
+			auto library = Library::sharedCopy(addedLibrary);
 			version->libraries.replace(index, library);
 		}
 	}
@@ -27,6 +27,9 @@
 #include <QJsonDocument>
 
 #include <QDebug>
+#include <QTimer>
+
+#include <algorithm>
 
 MojangAccountPtr MojangAccount::loadFromJson(const QJsonObject &object)
 {
@@ -86,6 +89,11 @@ MojangAccountPtr MojangAccount::loadFromJson(const QJsonObject &object)
 	account->m_clientToken = clientToken;
 	account->m_accessToken = accessToken;
 	account->m_profiles = profiles;
+	if (!accessToken.isEmpty())
+	{
+		account->m_tokenChecked =
+			QDateTime::fromString(object.value("tokenChecked").toString(), Qt::ISODate);
+	}
 
 	// Get the currently selected profile.
 	QString currentProfile = object.value("activeProfile").toString("");
@@ -109,6 +117,10 @@ QJsonObject MojangAccount::saveToJson() const
 	json.insert("username", m_username);
 	json.insert("clientToken", m_clientToken);
 	json.insert("accessToken", m_accessToken);
+	if (m_tokenChecked.isValid())
+	{
+		json.insert("tokenChecked", m_tokenChecked.toUTC().toString(Qt::ISODate));
+	}
 
 	QJsonArray profileArray;
 	for (AccountProfile profile : m_profiles)
@@ -170,11 +182,39 @@ AccountStatus MojangAccount::accountStatus() const
 		return Verified;
 }
 
+bool MojangAccount::hasFreshToken() const
+{
+	if (accountStatus() != Verified || !m_tokenChecked.isValid())
+	{
+		return false;
+	}
+	auto age = m_tokenChecked.secsTo(QDateTime::currentDateTimeUtc());
+	// a clock that went backwards says nothing about the token
+	return age >= 0 && age < tokenTrustTime;
+}
+
+QDateTime MojangAccount::tokenRefreshDue() const
+{
+	if (accountStatus() != Verified)
+	{
+		return QDateTime();
+	}
+	auto now = QDateTime::currentDateTimeUtc();
+	auto due = now;
+	if (m_tokenChecked.isValid() && m_tokenChecked <= now)
+	{
+		due = m_tokenChecked.addSecs(tokenTrustTime - tokenRefreshMargin);
+	}
+	if (m_lastRefreshAttempt.isValid())
+	{
+		due = std::max(due, m_lastRefreshAttempt.addSecs(tokenRetryTime));
+	}
+	return due;
+}
+
 std::shared_ptr<YggdrasilTask> MojangAccount::login(AuthSessionPtr session,
 													QString password)
 {
-	Q_ASSERT(m_currentTask.get() == nullptr);
-
 	// take care of the true offline status
 	if (accountStatus() == NotVerified && password.isEmpty())
 	{
@@ -188,17 +228,84 @@ std::shared_ptr<YggdrasilTask> MojangAccount::login(AuthSessionPtr session,
 
 	if (password.isEmpty())
 	{
-		m_currentTask.reset(new RefreshTask(this));
+		// the token was accepted a moment ago, no need to ask again
+		if (hasFreshToken() && !m_currentTask)
+		{
+			if (session)
+			{
+				session->status = session->wants_online ? AuthSession::PlayableOnline
+														: AuthSession::PlayableOffline;
+				fillSession(session);
+				session->auth_server_online = true;
+			}
+			return nullptr;
+		}
+		// a background refresh is already asking. Wait for that instead.
+		if (m_currentTask && !m_currentTask->getAssignedSession())
+		{
+			m_currentTask->assignSession(session);
+			return m_currentTask;
+		}
+	}
+	else if (m_currentTask)
+	{
+		// the password wins over whatever the background refresh would say
+		m_currentTask->disconnect(this);
+		if (m_currentTask->isRunning())
+		{
+			m_currentTask->abort();
+		}
+		m_currentTask.reset();
+	}
+	Q_ASSERT(m_currentTask.get() == nullptr);
+
+	if (password.isEmpty())
+	{
+		setCurrentTask(new RefreshTask(this), session);
 	}
 	else
 	{
-		m_currentTask.reset(new AuthenticateTask(this, password));
+		setCurrentTask(new AuthenticateTask(this, password), session);
+	}
+	return m_currentTask;
+}
+
+std::shared_ptr<YggdrasilTask> MojangAccount::refresh()
+{
+	if (accountStatus() != Verified)
+	{
+		return nullptr;
+	}
+	// also when busy, so whoever asks does not ask again right away
+	m_lastRefreshAttempt = QDateTime::currentDateTimeUtc();
+	if (m_currentTask)
+	{
+		return nullptr;
 	}
+	setCurrentTask(new RefreshTask(this), nullptr);
+	m_currentTask->start();
+	return m_currentTask;
+}
+
+void MojangAccount::setCurrentTask(YggdrasilTask *task, AuthSessionPtr session)
+{
+	m_currentTask.reset(task);
 	m_currentTask->assignSession(session);
 
 	connect(m_currentTask.get(), SIGNAL(succeeded()), SLOT(authSucceeded()));
 	connect(m_currentTask.get(), SIGNAL(failed(QString)), SLOT(authFailed(QString)));
-	return m_currentTask;
+}
+
+void MojangAccount::releaseCurrentTask()
+{
+	// a background refresh has no other owner, and the task is still emitting and processing its reply
+	std::shared_ptr<YggdrasilTask> task;
+	task.swap(m_currentTask);
+	task->disconnect(this);
+	QTimer::singleShot(0, this, [task]()
+	{
+		// the last reference goes away with this lambda
+	});
 }
 
 void MojangAccount::authSucceeded()
@@ -211,7 +318,9 @@ void MojangAccount::authSucceeded()
 		fillSession(session);
 		session->auth_server_online = true;
 	}
-	m_currentTask.reset();
+	m_tokenChecked = QDateTime::currentDateTimeUtc();
+	m_lastRefreshAttempt = QDateTime();
+	releaseCurrentTask();
 	emit changed();
 }
 
@@ -233,6 +342,7 @@ void MojangAccount::authFailed(QString reason)
 	else
 	{
 		m_accessToken = QString();
+		m_tokenChecked = QDateTime();
 		emit changed();
 		if (session)
 		{
@@ -241,7 +351,7 @@ void MojangAccount::authFailed(QString reason)
 			fillSession(session);
 		}
 	}
-	m_currentTask.reset();
+	releaseCurrentTask();
 }
 
 void MojangAccount::fillSession(AuthSessionPtr session)
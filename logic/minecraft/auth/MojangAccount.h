@@ -21,6 +21,7 @@
 #include <QJsonObject>
 #include <QPair>
 #include <QMap>
+#include <QDateTime>
 
 #include <memory>
 #include "AuthSession.h"
@@ -94,6 +95,12 @@ public: /* manipulation */
 	std::shared_ptr<YggdrasilTask> login(AuthSessionPtr session,
 										 QString password = QString());
 
+	/**
+	 * Refresh the access token in the background, without a session to fill.
+	 * Returns the started task, or nullptr if there is no token or something else is in progress.
+	 */
+	std::shared_ptr<YggdrasilTask> refresh();
+
 public: /* queries */
 	const QString &username() const
 	{
@@ -126,6 +133,25 @@ public: /* queries */
 	//! Returns whether the account is NotVerified, Verified or Online
 	AccountStatus accountStatus() const;
 
+	//! When the auth server last accepted the access token. Invalid if that is not known.
+	const QDateTime &tokenChecked() const
+	{
+		return m_tokenChecked;
+	}
+
+	//! True if the access token was accepted recently enough to launch without asking again
+	bool hasFreshToken() const;
+
+	//! When the token should be refreshed in the background. Invalid if there is no token.
+	QDateTime tokenRefreshDue() const;
+
+	//! How long a token accepted by the auth server is used without asking it again, in seconds
+	static const int tokenTrustTime = 60 * 60;
+	//! How long before it stops being trusted a token is refreshed, in seconds
+	static const int tokenRefreshMargin = 10 * 60;
+	//! How long to wait after a refresh failed before trying again, in seconds
+	static const int tokenRetryTime = 5 * 60;
+
 signals:
 	/**
 	 * This signal is emitted when the account changes
@@ -154,6 +180,12 @@ protected: /* variables */
 	// the user structure, whatever it is.
 	User m_user;
 
+	// when the auth server last accepted the access token
+	QDateTime m_tokenChecked;
+
+	// when a background refresh was last started. Not saved.
+	QDateTime m_lastRefreshAttempt;
+
 	// current task we are executing here
 	std::shared_ptr<YggdrasilTask> m_currentTask;
 
@@ -164,6 +196,9 @@ slots:
 
 private:
 	void fillSession(AuthSessionPtr session);
+	void setCurrentTask(YggdrasilTask *task, AuthSessionPtr session);
+	/// let go of the current task from inside its own signals, once it is done with them
+	void releaseCurrentTask();
 
 public:
 	friend class YggdrasilTask;
@@ -24,15 +24,33 @@
 #include <QJsonObject>
 #include <QJsonParseError>
 #include <QDir>
+#include <QSaveFile>
+#include <QtConcurrentRun>
 
 #include <QDebug>
 
 #include <FileSystem.h>
 
+#include <algorithm>
+#include <climits>
+
 #define ACCOUNT_LIST_FORMAT_VERSION 2
 
+// how long changes are collected before the list is saved, in milliseconds
+#define ACCOUNT_LIST_SAVE_DELAY 500
+
 MojangAccountList::MojangAccountList(QObject *parent) : QAbstractListModel(parent)
 {
+	m_saveTimer.setSingleShot(true);
+	m_saveTimer.setInterval(ACCOUNT_LIST_SAVE_DELAY);
+	connect(&m_saveTimer, &QTimer::timeout, this, &MojangAccountList::saveNow);
+	m_refreshTimer.setSingleShot(true);
+	connect(&m_refreshTimer, &QTimer::timeout, this, &MojangAccountList::refreshDueTokens);
+}
+
+MojangAccountList::~MojangAccountList()
+{
+	flushSave();
 }
 
 MojangAccountPtr MojangAccountList::findAccount(const QString &username) const
@@ -58,6 +76,7 @@ void MojangAccountList::addAccount(const MojangAccountPtr account)
 	m_accounts.append(account);
 	endResetModel();
 	onListChanged();
+	scheduleRefresh();
 }
 
 void MojangAccountList::removeAccount(const QString &username)
@@ -111,13 +130,14 @@ void MojangAccountList::accountChanged()
 {
 	// the list changed. there is no doubt.
 	onListChanged();
+	// and the token may have, too
+	scheduleRefresh();
 }
 
 void MojangAccountList::onListChanged()
 {
 	if (m_autosave)
-		// TODO: Alert the user if this fails.
-		saveList();
+		scheduleSave();
 
 	emit listChanged();
 }
@@ -125,11 +145,96 @@ void MojangAccountList::onListChanged()
 void MojangAccountList::onActiveChanged()
 {
 	if (m_autosave)
-		saveList();
+		scheduleSave();
 
 	emit activeAccountChanged();
 }
 
+void MojangAccountList::scheduleSave()
+{
+	// not restarted, so a steady stream of changes still gets saved
+	if (!m_saveTimer.isActive())
+	{
+		m_saveTimer.start();
+	}
+}
+
+void MojangAccountList::saveNow()
+{
+	if (m_listFilePath.isEmpty())
+	{
+		return;
+	}
+	// one write at a time, so an older list never replaces a newer one
+	m_saveFuture.waitForFinished();
+	auto path = m_listFilePath;
+	auto data = serialize();
+	// TODO: Alert the user if this fails.
+	m_saveFuture = QtConcurrent::run([path, data]() { return writeListFile(path, data); });
+}
+
+void MojangAccountList::flushSave()
+{
+	if (m_saveTimer.isActive())
+	{
+		m_saveTimer.stop();
+		saveNow();
+	}
+	m_saveFuture.waitForFinished();
+}
+
+void MojangAccountList::setAutoRefresh(bool enabled)
+{
+	m_autoRefresh = enabled;
+	if (enabled)
+	{
+		scheduleRefresh();
+	}
+	else
+	{
+		m_refreshTimer.stop();
+	}
+}
+
+void MojangAccountList::scheduleRefresh()
+{
+	if (!m_autoRefresh)
+	{
+		return;
+	}
+	QDateTime first;
+	for (auto account : m_accounts)
+	{
+		auto due = account->tokenRefreshDue();
+		if (due.isValid() && (!first.isValid() || due < first))
+		{
+			first = due;
+		}
+	}
+	if (!first.isValid())
+	{
+		m_refreshTimer.stop();
+		return;
+	}
+	auto wait = std::max<qint64>(0, QDateTime::currentDateTimeUtc().msecsTo(first));
+	m_refreshTimer.start(int(std::min<qint64>(wait, INT_MAX)));
+}
+
+void MojangAccountList::refreshDueTokens()
+{
+	auto now = QDateTime::currentDateTimeUtc();
+	for (auto account : m_accounts)
+	{
+		auto due = account->tokenRefreshDue();
+		if (due.isValid() && due <= now)
+		{
+			qDebug() << "Refreshing the access token of" << account->username() << "in the background";
+			account->refresh();
+		}
+	}
+	scheduleRefresh();
+}
+
 int MojangAccountList::count() const
 {
 	return m_accounts.count();
@@ -333,6 +438,7 @@ bool MojangAccountList::loadList(const QString &filePath)
 	// Load the active account.
 	m_activeAccount = findAccount(root.value("activeAccount").toString(""));
 	endResetModel();
+	scheduleRefresh();
 	return true;
 }
 
@@ -347,28 +453,23 @@ bool MojangAccountList::saveList(const QString &filePath)
 		return false;
 	}
 
-	// make sure the parent folder exists
-	if(!FS::ensureFilePathExists(path))
-		return false;
-
-	// make sure the file wasn't overwritten with a folder before (fixes a bug)
-	QFileInfo finfo(path);
-	if(finfo.isDir())
+	// don't let a background save finish after this one
+	m_saveFuture.waitForFinished();
+	if (path == m_listFilePath)
 	{
-		QDir badDir(path);
-		badDir.removeRecursively();
+		m_saveTimer.stop();
 	}
+	return writeListFile(path, serialize());
+}
 
-	qDebug() << "Writing account list to" << path;
-
-	qDebug() << "Building JSON data structure.";
+QByteArray MojangAccountList::serialize() const
+{
 	// Build the JSON document to write to the list file.
 	QJsonObject root;
 
 	root.insert("formatVersion", ACCOUNT_LIST_FORMAT_VERSION);
 
 	// Build a list of accounts.
-	qDebug() << "Building account array.";
 	QJsonArray accounts;
 	for (MojangAccountPtr account : m_accounts)
 	{
@@ -385,25 +486,41 @@ bool MojangAccountList::saveList(const QString &filePath)
 		root.insert("activeAccount", m_activeAccount->username());
 	}
 
-	// Create a JSON document object to convert our JSON to bytes.
-	QJsonDocument doc(root);
+	return QJsonDocument(root).toJson();
+}
 
-	// Now that we're done building the JSON object, we can write it to the file.
-	qDebug() << "Writing account list to file.";
-	QFile file(path);
+bool MojangAccountList::writeListFile(const QString &path, const QByteArray &data)
+{
+	// make sure the parent folder exists
+	if(!FS::ensureFilePathExists(path))
+		return false;
+
+	// make sure the file wasn't overwritten with a folder before (fixes a bug)
+	QFileInfo finfo(path);
+	if(finfo.isDir())
+	{
+		QDir badDir(path);
+		badDir.removeRecursively();
+	}
+
+	QSaveFile file(path);
 
 	// Try to open the file and fail if we can't.
 	// TODO: We should probably report this error to the user.
 	if (!file.open(QIODevice::WriteOnly))
 	{
-		qCritical() << QString("Failed to read the account list file (%1).").arg(path).toUtf8();
+		qCritical() << QString("Failed to write the account list file (%1).").arg(path).toUtf8();
 		return false;
 	}
 
 	// Write the JSON to the file.
-	file.write(doc.toJson());
+	file.write(data);
 	file.setPermissions(QFile::ReadOwner|QFile::WriteOwner|QFile::ReadUser|QFile::WriteUser);
-	file.close();
+	if (!file.commit())
+	{
+		qCritical() << QString("Failed to write the account list file (%1).").arg(path).toUtf8();
+		return false;
+	}
 
 	qDebug() << "Saved account list to" << path;
 
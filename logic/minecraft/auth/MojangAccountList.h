@@ -21,6 +21,8 @@
 #include <QVariant>
 #include <QAbstractListModel>
 #include <QSharedPointer>
+#include <QFuture>
+#include <QTimer>
 
 #include "multimc_logic_export.h"
 
@@ -54,6 +56,7 @@ public:
 	};
 
 	explicit MojangAccountList(QObject *parent = 0);
+	virtual ~MojangAccountList();
 
 	//! Gets the account at the given index.
 	virtual const MojangAccountPtr at(int i) const;
@@ -95,6 +98,7 @@ public:
 	/*!
 	 * Sets the default path to save the list file to.
 	 * If autosave is true, this list will automatically save to the given path whenever it changes.
+	 * Changes made in quick succession are saved together, in the background.
 	 * THIS FUNCTION DOES NOT LOAD THE LIST. If you set autosave, be sure to call loadList() immediately
 	 * after calling this function to ensure an autosaved change doesn't overwrite the list you intended
 	 * to load.
@@ -115,6 +119,17 @@ public:
 	 */
 	virtual bool saveList(const QString &file = "");
 
+	/*!
+	 * \brief Writes out any change that is waiting to be autosaved, and waits for the write to finish.
+	 */
+	void flushSave();
+
+	/*!
+	 * \brief Keep the access tokens fresh by refreshing them in the background before they go stale.
+	 * This way, launching usually does not have to wait for the auth server.
+	 */
+	void setAutoRefresh(bool enabled);
+
 	/*!
 	 * \brief Gets a pointer to the account that the user has selected as their "active" account.
 	 * Which account is active can be overridden on a per-instance basis, but this will return the one that
@@ -167,6 +182,18 @@ protected:
 	 */
 	void onActiveChanged();
 
+	//! Saves the list soon, together with whatever else changes until then.
+	void scheduleSave();
+
+	//! The contents of the list file.
+	QByteArray serialize() const;
+
+	//! Writes the list file. Does not touch the list, so it can run on any thread.
+	static bool writeListFile(const QString &path, const QByteArray &data);
+
+	//! Arms the refresh timer for the account whose token is due first.
+	void scheduleRefresh();
+
 	QList<MojangAccountPtr> m_accounts;
 
 	/*!
@@ -183,8 +210,22 @@ protected:
 	 */
 	bool m_autosave = false;
 
+	//! Collects changes for an autosave.
+	QTimer m_saveTimer;
+
+	//! The autosave being written.
+	QFuture<bool> m_saveFuture;
+
+	//! Fires when an access token is due for a refresh.
+	QTimer m_refreshTimer;
+
+	bool m_autoRefresh = false;
+
 protected
 slots:
+	void saveNow();
+	void refreshDueTokens();
+
 	/*!
 	 * Updates this list with the given list of accounts.
 	 * This is done by copying each account in the given list and inserting it
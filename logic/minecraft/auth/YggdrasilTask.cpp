@@ -29,6 +29,16 @@
 
 #include <QDebug>
 
+namespace
+{
+QString authServerOverride;
+}
+
+void YggdrasilTask::setAuthServer(const QString &base)
+{
+	authServerOverride = base;
+}
+
 YggdrasilTask::YggdrasilTask(MojangAccount *account, QObject *parent)
 	: Task(parent), m_account(account)
 {
@@ -43,7 +53,12 @@ void YggdrasilTask::executeTask()
 	QJsonDocument doc(getRequestContent());
 
 	auto worker = ENV.qnam();
-	QUrl reqUrl("https://" + URLConstants::AUTH_BASE + getEndpoint());
+	QString base = authServerOverride;
+	if (base.isEmpty())
+	{
+		base = "https://" + URLConstants::AUTH_BASE;
+	}
+	QUrl reqUrl(base + getEndpoint());
 	QNetworkRequest netRequest(reqUrl);
 	netRequest.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
@@ -29,12 +29,18 @@ class QNetworkReply;
 /**
  * A Yggdrasil task is a task that performs an operation on a given mojang account.
  */
-class YggdrasilTask : public Task
+class MULTIMC_LOGIC_EXPORT YggdrasilTask : public Task
 {
 	Q_OBJECT
 public:
 	explicit YggdrasilTask(MojangAccount * account, QObject *parent = 0);
 
+	/**
+	 * Send the requests somewhere else than the Mojang auth server. Endpoints are appended to base.
+	 * An empty base goes back to the Mojang auth server. Meant for tests.
+	 */
+	static void setAuthServer(const QString &base);
+
 	/**
 	 * assign a session to this task. the session will be filled with required infomration
 	 * upon completion
@@ -142,8 +142,10 @@ bool ForgeInstaller::add(OneSixInstance *to)
 		//
 		QList<QString> xzlist{"org.scala-lang", "com.typesafe"};
 		// for each library in the version we are adding (except for the blacklisted)
-		for (auto lib : m_forge_json->libraries)
+		for (auto sharedLib : m_forge_json->libraries)
 		{
+			// profile libraries are shared between profiles, change a copy
+			auto lib = Library::limitedCopy(sharedLib);
 			QString libName = lib->artifactId();
 			QString rawName = lib->rawName();
 
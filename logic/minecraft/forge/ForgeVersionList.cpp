@@ -84,6 +84,10 @@ QVariant ForgeVersionList::data(const QModelIndex &index, int role) const
 	case BranchRole:
 		return version->branch;
 
+	case VersionKeyRole:
+	case ParentGameVersionKeyRole:
+		return BaseVersionList::data(index, role);
+
 	default:
 		return QVariant();
 	}
@@ -104,6 +108,7 @@ void ForgeVersionList::updateListData(QList<BaseVersionPtr> versions)
 	beginResetModel();
 	m_vlist = versions;
 	m_loaded = true;
+	rebuildIndex();
 	endResetModel();
 	// NOW SORT!!
 	// sort();
@@ -187,195 +187,137 @@ void ForgeXzDownload::downloadReadyRead()
 
 #include "xz.h"
 #include "unpack200.h"
+#include <QSaveFile>
 #include <stdexcept>
 
 const size_t buffer_size = 8196;
 
-void ForgeXzDownload::decompressAndInstall()
+namespace
 {
-	// rewind the downloaded temp file
-	m_pack200_xz_file.seek(0);
-	// de-xz'd file
-	QTemporaryFile pack200_file("./dl_temp.XXXXXX");
-	pack200_file.open();
-
-	bool xz_success = false;
-	// first, de-xz
+/**
+ * Decompresses xz data from a device on demand, so it can feed the pack200 unpacker directly
+ */
+class XzReader
+{
+public:
+	explicit XzReader(QIODevice *input) : m_input(input)
 	{
-		uint8_t in[buffer_size];
-		uint8_t out[buffer_size];
-		struct xz_buf b;
-		struct xz_dec *s;
-		enum xz_ret ret;
 		xz_crc32_init();
 		xz_crc64_init();
-		s = xz_dec_init(XZ_DYNALLOC, 1 << 26);
-		if (s == nullptr)
+		m_state = xz_dec_init(XZ_DYNALLOC, 1 << 26);
+		if (m_state == nullptr)
 		{
-			xz_dec_end(s);
-			failAndTryNextMirror();
-			return;
+			throw std::runtime_error("Memory allocation failed");
 		}
-		b.in = in;
-		b.in_pos = 0;
-		b.in_size = 0;
-		b.out = out;
-		b.out_pos = 0;
-		b.out_size = buffer_size;
-		while (!xz_success)
+		m_buf.in = m_in;
+		m_buf.in_pos = 0;
+		m_buf.in_size = 0;
+	}
+	~XzReader()
+	{
+		xz_dec_end(m_state);
+	}
+	int64_t read(void *out, int64_t maxlen)
+	{
+		if (m_finished)
+		{
+			return 0;
+		}
+		m_buf.out = (uint8_t *)out;
+		m_buf.out_pos = 0;
+		m_buf.out_size = maxlen;
+		while (m_buf.out_pos == 0)
 		{
-			if (b.in_pos == b.in_size)
+			if (m_buf.in_pos == m_buf.in_size)
 			{
-				b.in_size = m_pack200_xz_file.read((char *)in, sizeof(in));
-				b.in_pos = 0;
+				auto got = m_input->read((char *)m_in, sizeof(m_in));
+				m_buf.in_size = got > 0 ? got : 0;
+				m_buf.in_pos = 0;
 			}
-
-			ret = xz_dec_run(s, &b);
-
-			if (b.out_pos == sizeof(out))
+			switch (xz_dec_run(m_state, &m_buf))
 			{
-				if (pack200_file.write((char *)out, b.out_pos) != b.out_pos)
-				{
-					// msg = "Write error\n";
-					xz_dec_end(s);
-					failAndTryNextMirror();
-					return;
-				}
-
-				b.out_pos = 0;
-			}
-
-			if (ret == XZ_OK)
-				continue;
-
-			if (ret == XZ_UNSUPPORTED_CHECK)
-			{
-				// unsupported check. this is OK, but we should log this
+			case XZ_OK:
+			// unsupported check. this is OK, but we should log this
+			case XZ_UNSUPPORTED_CHECK:
 				continue;
-			}
-
-			if (pack200_file.write((char *)out, b.out_pos) != b.out_pos)
-			{
-				// write error
-				pack200_file.close();
-				xz_dec_end(s);
-				return;
-			}
-
-			switch (ret)
-			{
 			case XZ_STREAM_END:
-				xz_dec_end(s);
-				xz_success = true;
-				break;
-
+				m_finished = true;
+				return m_buf.out_pos;
 			case XZ_MEM_ERROR:
-				qCritical() << "Memory allocation failed\n";
-				xz_dec_end(s);
-				failAndTryNextMirror();
-				return;
-
+				throw std::runtime_error("Memory allocation failed");
 			case XZ_MEMLIMIT_ERROR:
-				qCritical() << "Memory usage limit reached\n";
-				xz_dec_end(s);
-				failAndTryNextMirror();
-				return;
-
+				throw std::runtime_error("Memory usage limit reached");
 			case XZ_FORMAT_ERROR:
-				qCritical() << "Not a .xz file\n";
-				xz_dec_end(s);
-				failAndTryNextMirror();
-				return;
-
+				throw std::runtime_error("Not a .xz file");
 			case XZ_OPTIONS_ERROR:
-				qCritical() << "Unsupported options in the .xz headers\n";
-				xz_dec_end(s);
-				failAndTryNextMirror();
-				return;
-
+				throw std::runtime_error("Unsupported options in the .xz headers");
 			case XZ_DATA_ERROR:
 			case XZ_BUF_ERROR:
-				qCritical() << "File is corrupt\n";
-				xz_dec_end(s);
-				failAndTryNextMirror();
-				return;
-
+				throw std::runtime_error("File is corrupt");
 			default:
-				qCritical() << "Bug!\n";
-				xz_dec_end(s);
-				failAndTryNextMirror();
-				return;
+				throw std::runtime_error("Bug!");
 			}
 		}
+		return m_buf.out_pos;
 	}
-	m_pack200_xz_file.remove();
 
-	// revert pack200
-	pack200_file.seek(0);
-	int handle_in = pack200_file.handle();
-	// FIXME: dispose of file handles, pointers and the like. Ideally wrap in objects.
-	if(handle_in == -1)
-	{
-		qCritical() << "Error reopening " << pack200_file.fileName();
-		failAndTryNextMirror();
-		return;
-	}
-	FILE * file_in = fdopen(handle_in,"r");
-	if(!file_in)
-	{
-		qCritical() << "Error reopening " << pack200_file.fileName();
-		failAndTryNextMirror();
-		return;
-	}
-	QFile qfile_out(m_target_path);
-	if(!qfile_out.open(QIODevice::WriteOnly))
-	{
-		qCritical() << "Error opening " << qfile_out.fileName();
-		failAndTryNextMirror();
-		return;
-	}
-	int handle_out = qfile_out.handle();
-	if(handle_out == -1)
-	{
-		qCritical() << "Error opening " << qfile_out.fileName();
-		failAndTryNextMirror();
-		return;
-	}
-	FILE * file_out = fdopen(handle_out,"w");
-	if(!file_out)
+private:
+	QIODevice *m_input;
+	struct xz_dec *m_state = nullptr;
+	struct xz_buf m_buf;
+	uint8_t m_in[buffer_size];
+	bool m_finished = false;
+};
+}
+
+void ForgeXzDownload::decompressAndInstall()
+{
+	// rewind the downloaded temp file
+	m_pack200_xz_file.seek(0);
+
+	QSaveFile jar_file(m_target_path);
+	if (!jar_file.open(QIODevice::WriteOnly))
 	{
-		qCritical() << "Error opening " << qfile_out.fileName();
+		qCritical() << "Error opening " << jar_file.fileName();
 		failAndTryNextMirror();
 		return;
 	}
+	// hash the jar while it is being written instead of reading it back
+	QCryptographicHash md5(QCryptographicHash::Md5);
+
+	// de-xz straight into the pack200 unpacker, and from there into the target file
 	try
 	{
-		unpack_200(file_in, file_out);
+		XzReader xz(&m_pack200_xz_file);
+		auto reader = [&xz](void *buf, int64_t maxlen)
+		{
+			return xz.read(buf, maxlen);
+		};
+		auto writer = [&jar_file, &md5](const void *buf, size_t len)
+		{
+			md5.addData((const char *)buf, len);
+			return jar_file.write((const char *)buf, len) == (qint64)len;
+		};
+		unpack_200(reader, writer, true);
 	}
 	catch (std::runtime_error &err)
 	{
 		m_status = Job_Failed;
-		qCritical() << "Error unpacking " << pack200_file.fileName() << " : " << err.what();
-		QFile f(m_target_path);
-		if (f.exists())
-			f.remove();
+		qCritical() << "Error unpacking " << m_pack200_xz_file.fileName() << " : " << err.what();
+		jar_file.cancelWriting();
+		m_pack200_xz_file.remove();
 		failAndTryNextMirror();
 		return;
 	}
-	pack200_file.remove();
-
-	QFile jar_file(m_target_path);
-
-	if (!jar_file.open(QIODevice::ReadOnly))
+	m_pack200_xz_file.remove();
+	if (!jar_file.commit())
 	{
-		jar_file.remove();
+		qCritical() << "Error writing " << jar_file.fileName();
 		failAndTryNextMirror();
 		return;
 	}
-	m_entry->md5sum = QCryptographicHash::hash(jar_file.readAll(), QCryptographicHash::Md5)
-						  .toHex()
-						  .constData();
-	jar_file.close();
+
+	m_entry->md5sum = md5.result().toHex().constData();
 
 	QFileInfo output_file_info(m_target_path);
 	m_entry->etag = m_reply->rawHeader("ETag").constData();
@@ -0,0 +1,317 @@
+#include "FTBDiscovery.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QSet>
+#include <QXmlStreamReader>
+#include <QtConcurrentRun>
+
+#include "Exception.h"
+#include "Json.h"
+
+namespace
+{
+const int CACHE_FORMAT_VERSION = 1;
+
+/// what was found in one XML file, last time it was read
+struct CachedFile
+{
+	qint64 modified = 0;
+	qint64 size = 0;
+	QList<FTBRecord> records;
+};
+
+QJsonObject recordToJson(const FTBRecord &record)
+{
+	QJsonObject obj;
+	obj.insert("dir", record.dirName);
+	obj.insert("name", record.name);
+	obj.insert("logo", record.logo);
+	obj.insert("iconKey", record.iconKey);
+	obj.insert("mcVersion", record.mcVersion);
+	obj.insert("description", record.description);
+	obj.insert("instanceDir", record.instanceDir);
+	obj.insert("templateDir", record.templateDir);
+	return obj;
+}
+
+FTBRecord recordFromJson(const QJsonObject &obj)
+{
+	FTBRecord record;
+	record.dirName = Json::requireString(obj, "dir");
+	record.name = Json::ensureString(obj, "name", QString());
+	record.logo = Json::ensureString(obj, "logo", QString());
+	record.iconKey = Json::ensureString(obj, "iconKey", QString());
+	record.mcVersion = Json::ensureString(obj, "mcVersion", QString());
+	record.description = Json::ensureString(obj, "description", QString());
+	record.instanceDir = Json::requireString(obj, "instanceDir");
+	record.templateDir = Json::requireString(obj, "templateDir");
+	return record;
+}
+
+qint64 modifiedTime(const QFileInfo &info)
+{
+	return info.lastModified().toMSecsSinceEpoch();
+}
+
+/// what the cache says about the XML files in modPacksDir, by file name. Empty if it doesn't fit the install.
+QMap<QString, CachedFile> readCache(const QString &cacheFile, const QDir &modPacksDir, const QFileInfo &dataDirInfo)
+{
+	// the records depend on which modpack folders exist, so adding or removing one drops the cache
+	QMap<QString, CachedFile> cache;
+	try
+	{
+		auto root = Json::requireObject(Json::requireDocument(cacheFile, "FTB cache"));
+		if (Json::requireInteger(root, "formatVersion") == CACHE_FORMAT_VERSION &&
+			Json::requireString(root, "launcherDir") == modPacksDir.absolutePath() &&
+			Json::requireString(root, "dataDir") == dataDirInfo.absoluteFilePath() &&
+			qint64(Json::requireDouble(root, "dataDirModified")) == modifiedTime(dataDirInfo))
+		{
+			for (auto fileValue : Json::requireArray(root, "files"))
+			{
+				auto fileObj = Json::requireObject(fileValue);
+				CachedFile entry;
+				entry.modified = Json::requireDouble(fileObj, "modified");
+				entry.size = Json::requireDouble(fileObj, "size");
+				for (auto recordValue : Json::requireArray(fileObj, "records"))
+				{
+					entry.records.append(recordFromJson(Json::requireObject(recordValue)));
+				}
+				cache.insert(Json::requireString(fileObj, "name"), entry);
+			}
+		}
+	}
+	catch (Exception &)
+	{
+		// missing on the first run, or broken. Either way, everything is read again.
+		cache.clear();
+	}
+	return cache;
+}
+}
+
+FTBDiscovery::FTBDiscovery(const QString &launcherDir, const QString &dataDir,
+						   const QString &cacheFile, QObject *parent)
+	: QObject(parent), m_launcherDir(launcherDir), m_dataDir(dataDir), m_cacheFile(cacheFile),
+	  m_cancel(false)
+{
+	qRegisterMetaType<FTBRecord>("FTBRecord");
+}
+
+FTBDiscovery::~FTBDiscovery()
+{
+	cancel();
+	m_future.waitForFinished();
+}
+
+void FTBDiscovery::start()
+{
+	m_future = QtConcurrent::run([this]() { run(); });
+}
+
+void FTBDiscovery::cancel()
+{
+	m_cancel = true;
+}
+
+void FTBDiscovery::waitForFinished()
+{
+	m_future.waitForFinished();
+}
+
+QList<FTBRecord> FTBDiscovery::cachedRecords() const
+{
+	QList<FTBRecord> records;
+	QDir dir(m_launcherDir);
+	QFileInfo dataDirInfo(m_dataDir);
+	if (!dataDirInfo.isDir() || !dir.exists())
+	{
+		return records;
+	}
+	dir.cd("ModPacks");
+	QSet<QString> seen;
+	for (auto &entry : readCache(m_cacheFile, dir, dataDirInfo))
+	{
+		for (auto &record : entry.records)
+		{
+			if (seen.contains(record.instanceDir))
+			{
+				continue;
+			}
+			seen.insert(record.instanceDir);
+			records.append(record);
+		}
+	}
+	return records;
+}
+
+QList<FTBRecord> FTBDiscovery::parseModPacks(const QString &xmlFile,
+											 const QString &launcherModPacksDir,
+											 const QString &dataDirPath)
+{
+	QList<FTBRecord> records;
+	QFile f(xmlFile);
+	if (!f.open(QFile::ReadOnly))
+	{
+		return records;
+	}
+	QDir dir(launcherModPacksDir);
+	QDir dataDir(dataDirPath);
+
+	// read the FTB packs XML.
+	QXmlStreamReader reader(&f);
+	while (!reader.atEnd())
+	{
+		if (reader.readNext() != QXmlStreamReader::StartElement || reader.name() != "modpack")
+		{
+			continue;
+		}
+		QXmlStreamAttributes attrs = reader.attributes();
+		FTBRecord record;
+		record.dirName = attrs.value("dir").toString();
+		record.instanceDir = dataDir.absoluteFilePath(record.dirName);
+		record.templateDir = dir.absoluteFilePath(record.dirName);
+		QDir test(record.instanceDir);
+		if (!test.exists())
+			continue;
+		record.name = attrs.value("name").toString();
+		record.logo = attrs.value("logo").toString();
+		QString logo = record.logo;
+		record.iconKey = logo.remove(QRegularExpression("\\..*"));
+		auto customVersions = attrs.value("customMCVersions");
+		if (!customVersions.isNull())
+		{
+			QMap<QString, QString> versionMatcher;
+			QString customVersionsStr = customVersions.toString();
+			QStringList list = customVersionsStr.split(';');
+			for (auto item : list)
+			{
+				auto segment = item.split('^');
+				if (segment.size() != 2)
+				{
+					qCritical() << "FTB: Segment of size < 2 in " << customVersionsStr;
+					continue;
+				}
+				versionMatcher[segment[0]] = segment[1];
+			}
+			auto actualVersion = attrs.value("version").toString();
+			if (versionMatcher.contains(actualVersion))
+			{
+				record.mcVersion = versionMatcher[actualVersion];
+			}
+			else
+			{
+				record.mcVersion = attrs.value("mcVersion").toString();
+			}
+		}
+		else
+		{
+			record.mcVersion = attrs.value("mcVersion").toString();
+		}
+		record.description = attrs.value("description").toString();
+		records.append(record);
+	}
+	return records;
+}
+
+void FTBDiscovery::run()
+{
+	QDir dir(m_launcherDir);
+	QFileInfo dataDirInfo(m_dataDir);
+	if (!dataDirInfo.isDir())
+	{
+		qDebug() << "The FTB directory specified does not exist. Please check your settings";
+		emit finished(0);
+		return;
+	}
+	else if (!dir.exists())
+	{
+		qDebug() << "The FTB launcher data directory specified does not exist. Please check "
+					"your settings";
+		emit finished(0);
+		return;
+	}
+	dir.cd("ModPacks");
+
+	const qint64 dataDirModified = modifiedTime(dataDirInfo);
+	auto cache = readCache(m_cacheFile, dir, dataDirInfo);
+
+	int parsed = 0;
+	bool changed = false;
+	QSet<QString> seen;
+	QJsonArray files;
+	auto allFiles = dir.entryInfoList(QDir::Readable | QDir::Files, QDir::Name);
+	for (auto &info : allFiles)
+	{
+		if (m_cancel)
+		{
+			// an incomplete cache would hide the rest of the files next time
+			return;
+		}
+		const auto filename = info.fileName();
+		if (!filename.endsWith(".xml"))
+			continue;
+
+		CachedFile entry;
+		auto iter = cache.find(filename);
+		if (iter != cache.end() && iter->modified == modifiedTime(info) && iter->size == info.size())
+		{
+			entry = *iter;
+			cache.erase(iter);
+		}
+		else
+		{
+			qDebug() << "Discovering FTB instances -- " << info.absoluteFilePath();
+			entry.modified = modifiedTime(info);
+			entry.size = info.size();
+			entry.records = parseModPacks(info.absoluteFilePath(), dir.absolutePath(), m_dataDir);
+			parsed++;
+			changed = true;
+		}
+
+		QJsonArray records;
+		for (auto &record : entry.records)
+		{
+			records.append(recordToJson(record));
+			if (seen.contains(record.instanceDir))
+			{
+				continue;
+			}
+			seen.insert(record.instanceDir);
+			emit found(record);
+		}
+		QJsonObject fileObj;
+		fileObj.insert("name", filename);
+		fileObj.insert("modified", double(entry.modified));
+		fileObj.insert("size", double(entry.size));
+		fileObj.insert("records", records);
+		files.append(fileObj);
+	}
+	// whatever is left in the cache belongs to files that are gone
+	if (changed || !cache.isEmpty())
+	{
+		QJsonObject root;
+		root.insert("formatVersion", CACHE_FORMAT_VERSION);
+		root.insert("launcherDir", dir.absolutePath());
+		root.insert("dataDir", dataDirInfo.absoluteFilePath());
+		root.insert("dataDirModified", double(dataDirModified));
+		root.insert("files", files);
+		try
+		{
+			Json::write(root, m_cacheFile);
+		}
+		catch (Exception &e)
+		{
+			qWarning() << "Couldn't save the FTB instance cache:" << e.cause();
+		}
+	}
+	qDebug() << "FTB discovery done," << seen.size() << "instances," << parsed << "files read";
+	emit finished(parsed);
+}
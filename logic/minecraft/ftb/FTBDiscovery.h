@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QObject>
+#include <QFuture>
+#include <QMetaType>
+#include <QString>
+#include <atomic>
+
+#include "multimc_logic_export.h"
+
+/// a modpack installed by the FTB launcher
+struct MULTIMC_LOGIC_EXPORT FTBRecord
+{
+	QString dirName;
+	QString name;
+	QString logo;
+	QString iconKey;
+	QString mcVersion;
+	QString description;
+	QString instanceDir;
+	QString templateDir;
+
+	bool operator==(const FTBRecord &other) const
+	{
+		return dirName == other.dirName && name == other.name && logo == other.logo &&
+			   iconKey == other.iconKey && mcVersion == other.mcVersion &&
+			   description == other.description && instanceDir == other.instanceDir &&
+			   templateDir == other.templateDir;
+	}
+	bool operator!=(const FTBRecord &other) const
+	{
+		return !(*this == other);
+	}
+};
+Q_DECLARE_METATYPE(FTBRecord)
+
+/**
+ * Finds the modpacks installed by the FTB launcher, in the background.
+ *
+ * The launcher describes its modpacks in XML files. Records are reported as each file is read.
+ * What was found is cached along with the modification times of the files and of the FTB data
+ * folder, so an unchanged FTB install is not parsed again.
+ */
+class MULTIMC_LOGIC_EXPORT FTBDiscovery : public QObject
+{
+	Q_OBJECT
+public:
+	/**
+	 * launcherDir is where the FTB launcher keeps its files (with the XML files in 'ModPacks'),
+	 * dataDir is where it installs the modpacks. The cache is kept in cacheFile.
+	 */
+	FTBDiscovery(const QString &launcherDir, const QString &dataDir, const QString &cacheFile,
+				 QObject *parent = 0);
+	virtual ~FTBDiscovery();
+
+	void start();
+	void cancel();
+
+	/// wait until the discovery is done. Queued signals are delivered later, by the event loop
+	void waitForFinished();
+
+	/**
+	 * The records found by the last discovery, straight from the cache, without looking at the XML files.
+	 * Empty if there is no cache or it doesn't fit the install anymore. A discovery reports them all again.
+	 */
+	QList<FTBRecord> cachedRecords() const;
+
+	/// read the modpack records from one FTB launcher XML file
+	static QList<FTBRecord> parseModPacks(const QString &xmlFile, const QString &launcherModPacksDir,
+										  const QString &dataDir);
+
+signals:
+	/// a modpack was found. Each install folder is reported once.
+	void found(const FTBRecord &record);
+	/// all the files were looked at. parsed is the number of files that were not in the cache.
+	void finished(int parsed);
+
+private:
+	void run();
+
+private:
+	QString m_launcherDir;
+	QString m_dataDir;
+	QString m_cacheFile;
+	QFuture<void> m_future;
+	std::atomic<bool> m_cancel;
+};
@@ -1,4 +1,5 @@
 #include "FTBPlugin.h"
+#include "FTBDiscovery.h"
 #include "FTBVersion.h"
 #include "LegacyFTBInstance.h"
 #include "OneSixFTBInstance.h"
@@ -9,130 +10,8 @@
 #include <settings/INISettingsObject.h>
 #include <FileSystem.h>
 #include "QDebug"
-#include <QXmlStreamReader>
 #include <QRegularExpression>
 
-struct FTBRecord
-{
-	QString dirName;
-	QString name;
-	QString logo;
-	QString iconKey;
-	QString mcVersion;
-	QString description;
-	QString instanceDir;
-	QString templateDir;
-	bool operator==(const FTBRecord other) const
-	{
-		return instanceDir == other.instanceDir;
-	}
-};
-
-inline uint qHash(FTBRecord record)
-{
-	return qHash(record.instanceDir);
-}
-
-QSet<FTBRecord> discoverFTBInstances(SettingsObjectPtr globalSettings)
-{
-	QSet<FTBRecord> records;
-	QDir dir = QDir(globalSettings->get("FTBLauncherLocal").toString());
-	QDir dataDir = QDir(globalSettings->get("FTBRoot").toString());
-	if (!dataDir.exists())
-	{
-		qDebug() << "The FTB directory specified does not exist. Please check your settings";
-		return records;
-	}
-	else if (!dir.exists())
-	{
-		qDebug() << "The FTB launcher data directory specified does not exist. Please check "
-					"your settings";
-		return records;
-	}
-	dir.cd("ModPacks");
-	auto allFiles = dir.entryList(QDir::Readable | QDir::Files, QDir::Name);
-	for (auto filename : allFiles)
-	{
-		if (!filename.endsWith(".xml"))
-			continue;
-		auto fpath = dir.absoluteFilePath(filename);
-		QFile f(fpath);
-		qDebug() << "Discovering FTB instances -- " << fpath;
-		if (!f.open(QFile::ReadOnly))
-			continue;
-
-		// read the FTB packs XML.
-		QXmlStreamReader reader(&f);
-		while (!reader.atEnd())
-		{
-			switch (reader.readNext())
-			{
-			case QXmlStreamReader::StartElement:
-			{
-				if (reader.name() == "modpack")
-				{
-					QXmlStreamAttributes attrs = reader.attributes();
-					FTBRecord record;
-					record.dirName = attrs.value("dir").toString();
-					record.instanceDir = dataDir.absoluteFilePath(record.dirName);
-					record.templateDir = dir.absoluteFilePath(record.dirName);
-					QDir test(record.instanceDir);
-					qDebug() << dataDir.absolutePath() << record.instanceDir << record.dirName;
-					if (!test.exists())
-						continue;
-					record.name = attrs.value("name").toString();
-					record.logo = attrs.value("logo").toString();
-					QString logo = record.logo;
-					record.iconKey = logo.remove(QRegularExpression("\\..*"));
-					auto customVersions = attrs.value("customMCVersions");
-					if (!customVersions.isNull())
-					{
-						QMap<QString, QString> versionMatcher;
-						QString customVersionsStr = customVersions.toString();
-						QStringList list = customVersionsStr.split(';');
-						for (auto item : list)
-						{
-							auto segment = item.split('^');
-							if (segment.size() != 2)
-							{
-								qCritical() << "FTB: Segment of size < 2 in "
-											<< customVersionsStr;
-								continue;
-							}
-							versionMatcher[segment[0]] = segment[1];
-						}
-						auto actualVersion = attrs.value("version").toString();
-						if (versionMatcher.contains(actualVersion))
-						{
-							record.mcVersion = versionMatcher[actualVersion];
-						}
-						else
-						{
-							record.mcVersion = attrs.value("mcVersion").toString();
-						}
-					}
-					else
-					{
-						record.mcVersion = attrs.value("mcVersion").toString();
-					}
-					record.description = attrs.value("description").toString();
-					records.insert(record);
-				}
-				break;
-			}
-			case QXmlStreamReader::EndElement:
-				break;
-			case QXmlStreamReader::Characters:
-				break;
-			default:
-				break;
-			}
-		}
-		f.close();
-	}
-	return records;
-}
-
 InstancePtr loadInstance(SettingsObjectPtr globalSettings, QMap<QString, QString> &groupMap, const FTBRecord & record)
 {
 	InstancePtr inst;
@@ -237,57 +116,46 @@ InstancePtr createInstance(SettingsObjectPtr globalSettings, QMap<QString, QStri
 	return inst;
 }
 
-void FTBPlugin::loadInstances(SettingsObjectPtr globalSettings, QMap<QString, QString> &groupMap, QList<InstancePtr> &tempList)
+FTBDiscovery *FTBPlugin::createDiscovery(SettingsObjectPtr globalSettings, QObject *parent)
 {
 	// nothing to load when we don't have
 	if (globalSettings->get("TrackFTBInstances").toBool() != true)
 	{
-		return;
+		return nullptr;
 	}
+	return new FTBDiscovery(globalSettings->get("FTBLauncherLocal").toString(),
+							globalSettings->get("FTBRoot").toString(),
+							FS::PathCombine("cache", "ftbinstances.json"), parent);
+}
 
-	auto records = discoverFTBInstances(globalSettings);
-	if (!records.size())
-	{
-		qDebug() << "No FTB instances to load.";
-		return;
-	}
-	qDebug() << "Loading FTB instances! -- got " << records.size();
-	// process the records we acquired.
-	for (auto record : records)
-	{
-		qDebug() << "Loading FTB instance from " << record.instanceDir;
-		QString iconKey = record.iconKey;
-		ENV.icons()->addIcon(iconKey, iconKey, FS::PathCombine(record.templateDir, record.logo), MMCIcon::Transient);
-		auto settingsFilePath = FS::PathCombine(record.instanceDir, "instance.cfg");
-		qDebug() << "ICON get!";
+InstancePtr FTBPlugin::instanceFromRecord(SettingsObjectPtr globalSettings, QMap<QString, QString> &groupMap, const FTBRecord &record)
+{
+	qDebug() << "Loading FTB instance from " << record.instanceDir;
+	QString iconKey = record.iconKey;
+	ENV.icons()->addIcon(iconKey, iconKey, FS::PathCombine(record.templateDir, record.logo), MMCIcon::Transient);
+	auto settingsFilePath = FS::PathCombine(record.instanceDir, "instance.cfg");
 
-		if (QFileInfo(settingsFilePath).exists())
+	if (QFileInfo(settingsFilePath).exists())
+	{
+		auto instPtr = loadInstance(globalSettings, groupMap, record);
+		if (instPtr)
 		{
-			auto instPtr = loadInstance(globalSettings, groupMap, record);
-			if (!instPtr)
-			{
-				qWarning() << "Couldn't load instance config:" << settingsFilePath;
-				if(!QFile::remove(settingsFilePath))
-				{
-					qWarning() << "Couldn't remove broken instance config!";
-					continue;
-				}
-				// failed to load, but removed the poisonous file
-			}
-			else
-			{
-				tempList.append(InstancePtr(instPtr));
-				continue;
-			}
+			return instPtr;
 		}
-		auto instPtr = createInstance(globalSettings, groupMap, record);
-		if (!instPtr)
+		qWarning() << "Couldn't load instance config:" << settingsFilePath;
+		if(!QFile::remove(settingsFilePath))
 		{
-			qWarning() << "Couldn't create FTB instance!";
-			continue;
+			qWarning() << "Couldn't remove broken instance config!";
+			return nullptr;
 		}
-		tempList.append(InstancePtr(instPtr));
+		// failed to load, but removed the poisonous file
+	}
+	auto instPtr = createInstance(globalSettings, groupMap, record);
+	if (!instPtr)
+	{
+		qWarning() << "Couldn't create FTB instance!";
 	}
+	return instPtr;
 }
 
 #ifdef Q_OS_WIN32
@@ -4,10 +4,16 @@
 
 #include "multimc_logic_export.h"
 
+class FTBDiscovery;
+struct FTBRecord;
+
 // Pseudo-plugin for FTB related things. Super derpy!
 class MULTIMC_LOGIC_EXPORT FTBPlugin
 {
 public:
 	static void initialize(SettingsObjectPtr globalSettings);
-	static void loadInstances(SettingsObjectPtr globalSettings, QMap<QString, QString> &groupMap, QList<InstancePtr> &tempList);
+	/// the search for FTB instances, not started yet. nullptr if they are not tracked at all
+	static FTBDiscovery *createDiscovery(SettingsObjectPtr globalSettings, QObject *parent = 0);
+	/// load the instance of a discovered FTB modpack, converting it if it is new
+	static InstancePtr instanceFromRecord(SettingsObjectPtr globalSettings, QMap<QString, QString> &groupMap, const FTBRecord &record);
 };
@@ -6,6 +6,7 @@
 #include <FileSystem.h>
 
 #include <QDir>
+#include <QFileInfo>
 #include <QUuid>
 #include <QJsonDocument>
 #include <QJsonArray>
@@ -92,6 +93,19 @@ void FTBProfileStrategy::loadDefaultBuiltinPatches()
 
 }
 
+QString FTBProfileStrategy::inputsFingerprint()
+{
+	QStringList parts;
+	auto mcVersion = m_instance->intendedVersionId();
+	parts.append(mcVersion);
+	// the files loadDefaultBuiltinPatches() reads
+	addFileFingerprint(parts, QFileInfo(m_instance->versionsPath().absoluteFilePath(mcVersion + "/" + mcVersion + ".json")));
+	addFileFingerprint(parts, QFileInfo(m_instance->minecraftRoot() + "/pack.json"));
+	addFileFingerprint(parts, QFileInfo(FS::PathCombine(m_instance->instanceRoot(), "version")));
+	addUserPatchesFingerprint(parts);
+	return parts.join('|');
+}
+
 void FTBProfileStrategy::load()
 {
 	profile->clearPatches();
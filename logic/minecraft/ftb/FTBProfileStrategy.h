@@ -2,9 +2,11 @@
 #include "minecraft/ProfileStrategy.h"
 #include "minecraft/onesix/OneSixProfileStrategy.h"
 
+#include "multimc_logic_export.h"
+
 class OneSixFTBInstance;
 
-class FTBProfileStrategy : public OneSixProfileStrategy
+class MULTIMC_LOGIC_EXPORT FTBProfileStrategy : public OneSixProfileStrategy
 {
 public:
 	FTBProfileStrategy(OneSixFTBInstance * instance);
@@ -15,6 +17,8 @@ public:
 	virtual bool installJarMods(QStringList filepaths) override;
 	virtual bool customizePatch (ProfilePatchPtr patch) override;
 	virtual bool revertPatch (ProfilePatchPtr patch) override;
+	/// the files of the FTB launcher the profile is made from, and the instance's own patches
+	virtual QString inputsFingerprint() override;
 
 protected:
 	virtual void loadDefaultBuiltinPatches() override;
@@ -2,7 +2,9 @@
 
 #include "minecraft/onesix/OneSixInstance.h"
 
-class OneSixFTBInstance : public OneSixInstance
+#include "multimc_logic_export.h"
+
+class MULTIMC_LOGIC_EXPORT OneSixFTBInstance : public OneSixInstance
 {
 	Q_OBJECT
 public:
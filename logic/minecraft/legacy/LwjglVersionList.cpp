@@ -157,6 +157,7 @@ void LWJGLVersionList::netRequestComplete()
 
 		beginResetModel();
 		m_vlist.swap(tempList);
+		rebuildIndex();
 		endResetModel();
 
 		qDebug() << "Loaded LWJGL list.";
@@ -66,6 +66,7 @@ void LiteLoaderVersionList::sortVersions()
 {
 	beginResetModel();
 	std::sort(m_vlist.begin(), m_vlist.end(), cmpVersions);
+	rebuildIndex();
 	endResetModel();
 }
 
@@ -95,6 +96,10 @@ QVariant LiteLoaderVersionList::data(const QModelIndex &index, int role) const
 	case RecommendedRole:
 		return version->isLatest;
 
+	case VersionKeyRole:
+	case ParentGameVersionKeyRole:
+		return BaseVersionList::data(index, role);
+
 	default:
 		return QVariant();
 	}
@@ -124,6 +129,7 @@ void LiteLoaderVersionList::updateListData(QList<BaseVersionPtr> versions)
 	m_vlist = versions;
 	m_loaded = true;
 	std::sort(m_vlist.begin(), m_vlist.end(), cmpVersions);
+	rebuildIndex();
 	endResetModel();
 }
 
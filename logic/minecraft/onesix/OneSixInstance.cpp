@@ -15,6 +15,7 @@
 
 #include <QIcon>
 #include <QDebug>
+#include <QCryptographicHash>
 
 #include "OneSixInstance.h"
 #include "OneSixUpdate.h"
@@ -30,6 +31,9 @@
 #include "launch/steps/TextPrint.h"
 #include "launch/steps/ModMinecraftJar.h"
 #include "launch/steps/CheckJava.h"
+#include "launch/steps/PrewarmFiles.h"
+#include "launch/steps/ReconstructAssets.h"
+#include "launch/steps/PrepareClassDataSharing.h"
 #include "MMCZip.h"
 
 #include "minecraft/AssetsUtils.h"
@@ -123,7 +127,8 @@ QStringList OneSixInstance::processMinecraftArgs(AuthSessionPtr session)
 	QString absRootDir = QDir(minecraftRoot()).absolutePath();
 	token_mapping["game_directory"] = absRootDir;
 	QString absAssetsDir = QDir("assets/").absolutePath();
-	token_mapping["game_assets"] = AssetsUtils::reconstructAssets(m_version->assets).absolutePath();
+	// put together by the ReconstructAssets launch step
+	token_mapping["game_assets"] = AssetsUtils::virtualAssetsDir(m_version->assets).absolutePath();
 
 	token_mapping["user_properties"] = session->serializeUserProperties();
 	token_mapping["user_type"] = session->user_type;
@@ -150,16 +155,143 @@ QStringList OneSixInstance::processMinecraftArgs(AuthSessionPtr session)
 	return parts;
 }
 
-QString OneSixInstance::createLaunchScript(AuthSessionPtr session)
+QStringList OneSixInstance::classPath() const
+{
+	QStringList out;
+	if (!m_version)
+		return out;
+
+	auto libs = m_version->getActiveNormalLibs();
+	for (auto lib : libs)
+	{
+		out.append(QFileInfo(lib->storagePath()).absoluteFilePath());
+	}
+	auto jarMods = getJarMods();
+	if (!jarMods.isEmpty())
+	{
+		out.append(QDir(instanceRoot()).absoluteFilePath("minecraft.jar"));
+	}
+	else
+	{
+		QString relpath = m_version->id + "/" + m_version->id + ".jar";
+		out.append(versionsPath().absoluteFilePath(relpath));
+	}
+	return out;
+}
+
+QStringList OneSixInstance::classPathInputs() const
+{
+	QStringList out = classPath();
+	// minecraft.jar is built again on every launch, what it's built from is what counts
+	auto jarMods = getJarMods();
+	if (m_version && !jarMods.isEmpty())
+	{
+		out.removeLast();
+		QString relpath = m_version->id + "/" + m_version->id + ".jar";
+		out.append(versionsPath().absoluteFilePath(relpath));
+		for(auto & jarmod: jarMods)
+		{
+			out.append(jarmod.filename().absoluteFilePath());
+		}
+	}
+	return out;
+}
+
+QStringList OneSixInstance::launchFiles() const
+{
+	QStringList out = classPath();
+	for(auto & mod: loaderModList()->allMods())
+	{
+		if(mod.enabled() && mod.type() != Mod::MOD_FOLDER)
+			out.append(mod.filename().absoluteFilePath());
+	}
+	for(auto & coremod: coreModList()->allMods())
+	{
+		if(coremod.enabled() && coremod.type() != Mod::MOD_FOLDER)
+			out.append(coremod.filename().absoluteFilePath());
+	}
+	// minecraft.jar is built from the version jar and the jar mods
+	auto jarMods = getJarMods();
+	if (m_version && !jarMods.isEmpty())
+	{
+		QString relpath = m_version->id + "/" + m_version->id + ".jar";
+		out.append(versionsPath().absoluteFilePath(relpath));
+		for(auto & jarmod: jarMods)
+		{
+			out.append(jarmod.filename().absoluteFilePath());
+		}
+	}
+	return out;
+}
+
+QString OneSixInstance::launchScriptFingerprint() const
+{
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	auto add = [&hash](const QString &part)
+	{
+		hash.addData(part.toUtf8());
+		hash.addData("\n", 1);
+	};
+	// bump when the layout of the static part changes
+	add("1");
+	// relative library paths resolve against the working directory
+	add(QDir::currentPath());
+	add(instanceRoot());
+
+	// the profile, as far as the script is concerned
+	add(m_version->id);
+	add(m_version->mainClass);
+	add(m_version->appletClass);
+	for (auto lib : m_version->getActiveNormalLibs())
+	{
+		add("lib " + lib->storagePath());
+	}
+	for (auto native : m_version->getActiveNativeLibs())
+	{
+		add("native " + native->storagePath());
+	}
+	for (auto &jarmod : m_version->jarMods)
+	{
+		add("jarmod " + jarmod->originalName + " " + jarmod->name);
+	}
+	for (auto &trait : m_version->traits)
+	{
+		add("trait " + trait);
+	}
+
+	// the mod folders, without looking into the mods
+	for (auto dirPath : {loaderModsDir(), coreModsDir()})
+	{
+		add("dir " + dirPath);
+		QDir dir(dirPath);
+		for (auto &info : dir.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden, QDir::Name))
+		{
+			add(QString("%1:%2:%3:%4").arg(info.fileName()).arg(info.isDir()).arg(info.size())
+				.arg(info.lastModified().toMSecsSinceEpoch()));
+		}
+	}
+
+	// the icon written next to the game
+	add("icon " + iconKey());
+	if (auto mmcIcon = ENV.icons()->icon(iconKey()))
+	{
+		auto type = mmcIcon->type();
+		if (type < MMCIcon::ICONS_TOTAL)
+		{
+			add(mmcIcon->m_images[type].filename);
+			add(QString::number(mmcIcon->m_images[type].changed.toMSecsSinceEpoch()));
+		}
+	}
+	return hash.result().toHex();
+}
+
+QString OneSixInstance::buildStaticLaunchScript()
 {
 	QString launchScript;
 	QIcon icon = ENV.icons()->getIcon(iconKey());
 	auto pixmap = icon.pixmap(128, 128);
 	pixmap.save(FS::PathCombine(minecraftRoot(), "icon.png"), "PNG");
 
-	if (!m_version)
-		return nullptr;
-
 	for(auto & mod: loaderModList()->allMods())
 	{
 		if(!mod.enabled())
@@ -188,22 +320,9 @@ QString OneSixInstance::createLaunchScript(AuthSessionPtr session)
 	}
 
 	// libraries and class path.
+	for (auto & entry : classPath())
 	{
-		auto libs = m_version->getActiveNormalLibs();
-		for (auto lib : libs)
-		{
-			launchScript += "cp " + QFileInfo(lib->storagePath()).absoluteFilePath() + "\n";
-		}
-		auto jarMods = getJarMods();
-		if (!jarMods.isEmpty())
-		{
-			launchScript += "cp " + QDir(instanceRoot()).absoluteFilePath("minecraft.jar") + "\n";
-		}
-		else
-		{
-			QString relpath = m_version->id + "/" + m_version->id + ".jar";
-			launchScript += "cp " + versionsPath().absoluteFilePath(relpath) + "\n";
-		}
+		launchScript += "cp " + entry + "\n";
 	}
 	if (!m_version->mainClass.isEmpty())
 	{
@@ -214,6 +333,60 @@ QString OneSixInstance::createLaunchScript(AuthSessionPtr session)
 		launchScript += "appletClass " + m_version->appletClass + "\n";
 	}
 
+	// native libraries (mostly LWJGL)
+	{
+		QDir natives_dir(FS::PathCombine(instanceRoot(), "natives/"));
+		for (auto native : m_version->getActiveNativeLibs())
+		{
+			QFileInfo finfo(native->storagePath());
+			launchScript += "ext " + finfo.absoluteFilePath() + "\n";
+		}
+		launchScript += "natives " + natives_dir.absolutePath() + "\n";
+	}
+
+	// traits. including legacyLaunch and others ;)
+	for (auto trait : m_version->traits)
+	{
+		launchScript += "traits " + trait + "\n";
+	}
+	return launchScript;
+}
+
+QString OneSixInstance::staticLaunchScript()
+{
+	auto cachePath = FS::PathCombine(instanceRoot(), "launch-script.cache");
+	auto fingerprint = launchScriptFingerprint();
+	QFile cacheFile(cachePath);
+	if (cacheFile.open(QIODevice::ReadOnly))
+	{
+		auto firstLine = cacheFile.readLine().trimmed();
+		if (firstLine == fingerprint.toLatin1() && QFileInfo(FS::PathCombine(minecraftRoot(), "icon.png")).exists())
+		{
+			qDebug() << name() << ": launch script is up to date, not rebuilding it";
+			return QString::fromUtf8(cacheFile.readAll());
+		}
+		cacheFile.close();
+	}
+
+	auto launchScript = buildStaticLaunchScript();
+	try
+	{
+		FS::write(cachePath, fingerprint.toLatin1() + "\n" + launchScript.toUtf8());
+	}
+	catch (FS::FileSystemException &e)
+	{
+		qWarning() << "Couldn't save the launch script cache:" << e.cause();
+	}
+	return launchScript;
+}
+
+QString OneSixInstance::createLaunchScript(AuthSessionPtr session)
+{
+	if (!m_version)
+		return nullptr;
+
+	QString launchScript = staticLaunchScript();
+
 	// generic minecraft params
 	for (auto param : processMinecraftArgs(session))
 	{
@@ -239,22 +412,6 @@ QString OneSixInstance::createLaunchScript(AuthSessionPtr session)
 		launchScript += "sessionId " + session->session + "\n";
 	}
 
-	// native libraries (mostly LWJGL)
-	{
-		QDir natives_dir(FS::PathCombine(instanceRoot(), "natives/"));
-		for (auto native : m_version->getActiveNativeLibs())
-		{
-			QFileInfo finfo(native->storagePath());
-			launchScript += "ext " + finfo.absoluteFilePath() + "\n";
-		}
-		launchScript += "natives " + natives_dir.absolutePath() + "\n";
-	}
-
-	// traits. including legacyLaunch and others ;)
-	for (auto trait : m_version->traits)
-	{
-		launchScript += "traits " + trait + "\n";
-	}
 	launchScript += "launcher onesix\n";
 	return launchScript;
 }
@@ -272,6 +429,12 @@ std::shared_ptr<LaunchTask> OneSixInstance::createLaunchTask(AuthSessionPtr sess
 		auto step = std::make_shared<CheckJava>(pptr);
 		process->appendStep(step);
 	}
+	// read the game files into the page cache while the other steps run
+	{
+		auto step = std::make_shared<PrewarmFiles>(pptr);
+		step->setFiles(launchFiles());
+		process->appendStep(step);
+	}
 	// run pre-launch command if that's needed
 	if(getPreLaunchCommand().size())
 	{
@@ -290,11 +453,24 @@ std::shared_ptr<LaunchTask> OneSixInstance::createLaunchTask(AuthSessionPtr sess
 		auto step = std::make_shared<ModMinecraftJar>(pptr);
 		process->appendStep(step);
 	}
+	// old versions need the assets laid out by name
+	{
+		auto step = std::make_shared<ReconstructAssets>(pptr);
+		step->setAssetsId(m_version ? m_version->assets : QString());
+		process->appendStep(step);
+	}
 	// actually launch the game
 	{
 		auto step = std::make_shared<LaunchMinecraft>(pptr);
 		step->setWorkingDirectory(minecraftRoot());
 		step->setAuthSession(session);
+		// only now minecraft.jar is there to go into the archive
+		if(settings()->get("JavaClassDataSharing").toBool())
+		{
+			auto cds = std::make_shared<PrepareClassDataSharing>(pptr);
+			cds->setLaunchStep(step);
+			process->appendStep(cds);
+		}
 		process->appendStep(step);
 	}
 	// run post-exit command if that's needed
@@ -488,6 +664,16 @@ void OneSixInstance::reloadProfile()
 	}
 }
 
+void OneSixInstance::reloadProfileIfChanged()
+{
+	if(m_version->isUpToDate())
+	{
+		qDebug() << name() << ": profile is up to date, not reloading";
+		return;
+	}
+	reloadProfile();
+}
+
 void OneSixInstance::clearProfile()
 {
 	m_version->clear();
@@ -58,6 +58,12 @@ public:
 
 	virtual QString createLaunchScript(AuthSessionPtr session) override;
 
+	virtual QStringList classPath() const override;
+	virtual QStringList classPathInputs() const override;
+
+	/// all the files the game reads on start: the class path and the enabled mods
+	QStringList launchFiles() const;
+
 	virtual void cleanupAfterRun() override;
 
 	virtual QString intendedVersionId() const override;
@@ -75,6 +81,9 @@ public:
 	 */
 	void reloadProfile();
 
+	/// reload the profile only if any of the files it is built from changed since the last reload
+	void reloadProfileIfChanged();
+
 	/// clears all version information in preparation for an update
 	void clearProfile();
 
@@ -100,6 +109,16 @@ signals:
 private:
 	QStringList processMinecraftArgs(AuthSessionPtr account);
 
+	/**
+	 * The part of the launch script that doesn't depend on the session: mods, class path, natives and traits.
+	 * Kept in the instance folder and only built again when the profile, mods or icon change.
+	 */
+	QString staticLaunchScript();
+	QString buildStaticLaunchScript();
+
+	/// identifies everything the static part of the launch script is built from, without reading the mods
+	QString launchScriptFingerprint() const;
+
 protected:
 	std::shared_ptr<MinecraftProfile> m_version;
 	mutable std::shared_ptr<ModList> m_loader_mod_list;
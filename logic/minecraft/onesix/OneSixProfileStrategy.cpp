@@ -11,6 +11,7 @@
 #include <QUuid>
 #include <QJsonDocument>
 #include <QJsonArray>
+#include <QDateTime>
 
 OneSixProfileStrategy::OneSixProfileStrategy(OneSixInstance* instance)
 {
@@ -78,6 +79,44 @@ void OneSixProfileStrategy::upgradeDeprecatedFiles()
 	}
 }
 
+void OneSixProfileStrategy::addFileFingerprint(QStringList &parts, const QFileInfo &info)
+{
+	if(!info.exists())
+	{
+		return;
+	}
+	parts.append(QString("%1:%2:%3").arg(info.fileName()).arg(info.size()).arg(info.lastModified().toMSecsSinceEpoch()));
+}
+
+void OneSixProfileStrategy::addUserPatchesFingerprint(QStringList &parts)
+{
+	auto root = m_instance->instanceRoot();
+	addFileFingerprint(parts, QFileInfo(FS::PathCombine(root, "order.json")));
+	QDir patches(FS::PathCombine(root, "patches"));
+	for (auto info : patches.entryInfoList(QStringList() << "*.json", QDir::Files, QDir::Name))
+	{
+		addFileFingerprint(parts, info);
+	}
+}
+
+QString OneSixProfileStrategy::inputsFingerprint()
+{
+	QStringList parts;
+	auto root = m_instance->instanceRoot();
+	parts.append(m_instance->intendedVersionId());
+	addFileFingerprint(parts, QFileInfo(FS::PathCombine(root, "version.json")));
+	addFileFingerprint(parts, QFileInfo(FS::PathCombine(root, "custom.json")));
+	addUserPatchesFingerprint(parts);
+	// the vanilla patch may come from the version list and its cached version file
+	auto mcversion = std::dynamic_pointer_cast<MinecraftVersion>(ENV.getVersion("net.minecraft", m_instance->intendedVersionId()));
+	if(mcversion)
+	{
+		parts.append(QString("mc:%1:%2").arg(quintptr(mcversion.get())).arg(int(mcversion->m_versionSource)));
+		addFileFingerprint(parts, QFileInfo(QString("versions/%1/%1.dat").arg(mcversion->descriptor())));
+	}
+	return parts.join('|');
+}
+
 void OneSixProfileStrategy::loadDefaultBuiltinPatches()
 {
 	{
@@ -86,7 +125,7 @@ void OneSixProfileStrategy::loadDefaultBuiltinPatches()
 		ProfilePatchPtr minecraftPatch;
 		if(QFile::exists(mcJson))
 		{
-			auto file = ProfileUtils::parseJsonFile(QFileInfo(mcJson), false);
+			auto file = ProfileUtils::parseJsonFileCached(QFileInfo(mcJson), false);
 			if(file->version.isEmpty())
 			{
 				file->version = m_instance->intendedVersionId();
@@ -113,7 +152,7 @@ void OneSixProfileStrategy::loadDefaultBuiltinPatches()
 		ProfilePatchPtr lwjglPatch;
 		if(QFile::exists(lwjglJson))
 		{
-			auto file = ProfileUtils::parseJsonFile(QFileInfo(lwjglJson), false);
+			auto file = ProfileUtils::parseJsonFileCached(QFileInfo(lwjglJson), false);
 			file->setVanilla(false);
 			file->setRevertible(true);
 			lwjglPatch = std::dynamic_pointer_cast<ProfilePatch>(file);
@@ -122,7 +161,7 @@ void OneSixProfileStrategy::loadDefaultBuiltinPatches()
 		{
 			// NOTE: this is obviously fake, is fixed in unstable.
 			QResource LWJGL(":/versions/LWJGL/2.9.1.json");
-			auto lwjgl = ProfileUtils::parseJsonFile(LWJGL.absoluteFilePath(), false);
+			auto lwjgl = ProfileUtils::parseJsonFileCached(LWJGL.absoluteFilePath(), false);
 			lwjgl->setVanilla(true);
 			lwjgl->setCustomizable(true);
 			lwjglPatch = std::dynamic_pointer_cast<ProfilePatch>(lwjgl);
@@ -161,7 +200,7 @@ void OneSixProfileStrategy::loadUserPatches()
 			continue;
 		}
 		qDebug() << "Reading" << filename << "by user order";
-		VersionFilePtr file = ProfileUtils::parseJsonFile(finfo, false);
+		VersionFilePtr file = ProfileUtils::parseJsonFileCached(finfo, false);
 		// sanity check. prevent tampering with files.
 		if (file->fileId != id)
 		{
@@ -178,7 +217,7 @@ void OneSixProfileStrategy::loadUserPatches()
 	{
 		// parse the file
 		qDebug() << "Reading" << info.fileName();
-		auto file = ProfileUtils::parseJsonFile(info, true);
+		auto file = ProfileUtils::parseJsonFileCached(info, true);
 		// ignore builtins
 		if (file->fileId == "net.minecraft")
 			continue;
@@ -1,9 +1,12 @@
 #pragma once
 #include "minecraft/ProfileStrategy.h"
 
+#include "multimc_logic_export.h"
+
 class OneSixInstance;
+class QFileInfo;
 
-class OneSixProfileStrategy : public ProfileStrategy
+class MULTIMC_LOGIC_EXPORT OneSixProfileStrategy : public ProfileStrategy
 {
 public:
 	OneSixProfileStrategy(OneSixInstance * instance);
@@ -15,12 +18,18 @@ public:
 	virtual bool removePatch(ProfilePatchPtr patch) override;
 	virtual bool customizePatch(ProfilePatchPtr patch) override;
 	virtual bool revertPatch(ProfilePatchPtr patch) override;
+	virtual QString inputsFingerprint() override;
 
 protected:
 	virtual void loadDefaultBuiltinPatches();
 	virtual void loadUserPatches();
 	void upgradeDeprecatedFiles();
 
+	/// add the name, size and time of a file to a fingerprint, if it exists
+	static void addFileFingerprint(QStringList &parts, const QFileInfo &info);
+	/// add the files loadUserPatches() reads to a fingerprint
+	void addUserPatchesFingerprint(QStringList &parts);
+
 protected:
 	OneSixInstance *m_instance;
 };
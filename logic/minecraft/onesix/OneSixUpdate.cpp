@@ -76,6 +76,7 @@ void OneSixUpdate::executeTask()
 	connect(versionUpdateTask.get(), &NetJob::failed, this, &OneSixUpdate::versionUpdateFailed);
 	connect(versionUpdateTask.get(), SIGNAL(progress(qint64, qint64)), SIGNAL(progress(qint64, qint64)));
 	setStatus(tr("Getting the version files from Mojang..."));
+	emit subTaskStarted(versionUpdateTask.get(), tr("Version file for %1").arg(m_inst->intendedVersionId()));
 	versionUpdateTask->start();
 }
 
@@ -105,6 +106,7 @@ void OneSixUpdate::assetIndexStart()
 	connect(jarlibDownloadJob.get(), SIGNAL(progress(qint64, qint64)), SIGNAL(progress(qint64, qint64)));
 
 	qDebug() << m_inst->name() << ": Starting asset index download";
+	emit subTaskStarted(jarlibDownloadJob.get(), jarlibDownloadJob->name());
 	jarlibDownloadJob->start();
 }
 
@@ -148,6 +150,7 @@ void OneSixUpdate::assetIndexFinished()
 		connect(jarlibDownloadJob.get(), SIGNAL(succeeded()), SLOT(assetsFinished()));
 		connect(jarlibDownloadJob.get(), &NetJob::failed, this, &OneSixUpdate::assetsFailed);
 		connect(jarlibDownloadJob.get(), SIGNAL(progress(qint64, qint64)), SIGNAL(progress(qint64, qint64)));
+		emit subTaskStarted(jarlibDownloadJob.get(), jarlibDownloadJob->name());
 		jarlibDownloadJob->start();
 		return;
 	}
@@ -177,7 +180,7 @@ void OneSixUpdate::jarlibStart()
 	OneSixInstance *inst = (OneSixInstance *)m_inst;
 	try
 	{
-		inst->reloadProfile();
+		inst->reloadProfileIfChanged();
 	}
 	catch (Exception &e)
 	{
@@ -284,6 +287,7 @@ void OneSixUpdate::jarlibStart()
 	connect(jarlibDownloadJob.get(), SIGNAL(progress(qint64, qint64)),
 			SIGNAL(progress(qint64, qint64)));
 
+	emit subTaskStarted(jarlibDownloadJob.get(), jarlibDownloadJob->name());
 	jarlibDownloadJob->start();
 }
 
@@ -369,6 +373,7 @@ void OneSixUpdate::fmllibsStart()
 	connect(dljob, &NetJob::failed, this, &OneSixUpdate::fmllibsFailed);
 	connect(dljob, SIGNAL(progress(qint64, qint64)), SIGNAL(progress(qint64, qint64)));
 	legacyDownloadJob.reset(dljob);
+	emit subTaskStarted(legacyDownloadJob.get(), legacyDownloadJob->name());
 	legacyDownloadJob->start();
 }
 
@@ -131,8 +131,15 @@ void CacheDownload::downloadFinished()
 		return;
 	}
 
+	// not modified: keep the file we have
+	const bool notModified = m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304;
+	if (notModified)
+	{
+		m_output_file->cancelWriting();
+		m_status = Job_Finished;
+	}
 	// if we wrote any data to the save file, we try to commit the data to the real file.
-	if (wroteAnyData)
+	else if (wroteAnyData)
 	{
 		// nothing went wrong...
 		if (m_output_file->commit())
@@ -160,13 +167,18 @@ void CacheDownload::downloadFinished()
 
 	QFileInfo output_file_info(m_target_path);
 
-	m_entry->etag = m_reply->rawHeader("ETag").constData();
+	// a 304 response does not have to repeat the ETag
+	if (!notModified || m_reply->hasRawHeader("ETag"))
+	{
+		m_entry->etag = m_reply->rawHeader("ETag").constData();
+	}
 	if (m_reply->hasRawHeader("Last-Modified"))
 	{
 		m_entry->remote_changed_timestamp = m_reply->rawHeader("Last-Modified").constData();
 	}
 	m_entry->local_changed_timestamp =
 		output_file_info.lastModified().toUTC().toMSecsSinceEpoch();
+	m_entry->remote_checked_timestamp = QDateTime::currentMSecsSinceEpoch();
 	m_entry->stale = false;
 	ENV.metacache()->updateEntry(m_entry);
 
@@ -178,6 +190,10 @@ void CacheDownload::downloadFinished()
 void CacheDownload::downloadReadyRead()
 {
 	QByteArray ba = m_reply->readAll();
+	if (ba.isEmpty())
+	{
+		return;
+	}
 	md5sum.addData(ba);
 	if (m_output_file->write(ba) != ba.size())
 	{
@@ -35,6 +35,11 @@ QString MetaEntry::getFullPath()
 	return FS::PathCombine(ENV.metacache()->getBasePath(base), path);
 }
 
+bool MetaEntry::isOlderThan(qint64 maxAge) const
+{
+	return QDateTime::currentMSecsSinceEpoch() - remote_checked_timestamp > maxAge;
+}
+
 HttpMetaCache::HttpMetaCache(QString path) : QObject()
 {
 	m_index_file = path;
@@ -214,6 +219,7 @@ void HttpMetaCache::Load()
 		foo->local_changed_timestamp = element_obj.value("last_changed_timestamp").toDouble();
 		foo->remote_changed_timestamp =
 			element_obj.value("remote_changed_timestamp").toString();
+		foo->remote_checked_timestamp = element_obj.value("remote_checked_timestamp").toDouble();
 		// presumed innocent until closer examination
 		foo->stale = false;
 		entrymap.entry_list[path] = MetaEntryPtr(foo);
@@ -251,6 +257,9 @@ void HttpMetaCache::SaveNow()
 			if (!entry->remote_changed_timestamp.isEmpty())
 				entryObj.insert("remote_changed_timestamp",
 								QJsonValue(entry->remote_changed_timestamp));
+			if (entry->remote_checked_timestamp)
+				entryObj.insert("remote_checked_timestamp",
+								QJsonValue(double(entry->remote_checked_timestamp)));
 			entriesArr.append(entryObj);
 		}
 	}
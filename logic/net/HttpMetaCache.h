@@ -31,8 +31,11 @@ struct MULTIMC_LOGIC_EXPORT MetaEntry
 	QString etag;
 	qint64 local_changed_timestamp = 0;
 	QString remote_changed_timestamp; // QString for now, RFC 2822 encoded time
+	qint64 remote_checked_timestamp = 0; // when the server last confirmed the content, msecs since epoch
 	bool stale = true;
 	QString getFullPath();
+	// true if the server did not confirm the content within the last maxAge milliseconds
+	bool isOlderThan(qint64 maxAge) const;
 };
 
 typedef std::shared_ptr<MetaEntry> MetaEntryPtr;
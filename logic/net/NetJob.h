@@ -79,6 +79,10 @@ public:
 	{
 		return downloads.size();
 	}
+	QString name() const
+	{
+		return m_job_name;
+	}
 	virtual bool isRunning() const
 	{
 		return m_running;
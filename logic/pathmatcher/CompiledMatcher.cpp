@@ -0,0 +1,132 @@
+#include "CompiledMatcher.h"
+#include "FSTreeMatcher.h"
+#include "MultiMatcher.h"
+#include "RegexpMatcher.h"
+
+namespace
+{
+// back references count groups, which merging patterns would shift
+const QRegularExpression backReference("\\\\(?:[1-9]|g)");
+}
+
+std::shared_ptr<CompiledMatcher> CompiledMatcher::compile(Ptr matcher)
+{
+	std::shared_ptr<CompiledMatcher> compiled(new CompiledMatcher());
+	compiled->add(matcher);
+	compiled->finish();
+	return compiled;
+}
+
+void CompiledMatcher::add(Ptr matcher)
+{
+	if (!matcher)
+	{
+		return;
+	}
+	if (auto multi = std::dynamic_pointer_cast<MultiMatcher>(matcher))
+	{
+		for (auto &inner : multi->m_matchers)
+		{
+			add(inner);
+		}
+	}
+	else if (auto regexp = std::dynamic_pointer_cast<RegexpMatcher>(matcher))
+	{
+		addRegexp(regexp->m_regexp, regexp->m_onlyFilenamePart);
+	}
+	else if (auto tree = std::dynamic_pointer_cast<FSTreeMatcher>(matcher))
+	{
+		if (tree->m_fsTree.contained())
+		{
+			m_matchesAll = true;
+			return;
+		}
+		m_tree.insert(tree->m_fsTree.toStringList());
+		m_hasTree = true;
+	}
+	else
+	{
+		m_others.append(matcher);
+	}
+}
+
+void CompiledMatcher::addRegexp(const QRegularExpression &regexp, bool onlyFilenamePart)
+{
+	// the uncompiled matcher never matches with a broken pattern either
+	if (!regexp.isValid())
+	{
+		return;
+	}
+	auto &target = onlyFilenamePart ? m_nameRegexps : m_pathRegexps;
+	if (regexp.pattern().contains(backReference))
+	{
+		target.append(regexp);
+		return;
+	}
+	m_pending[qMakePair(onlyFilenamePart, int(regexp.patternOptions()))].append(regexp.pattern());
+}
+
+void CompiledMatcher::finish()
+{
+	for (auto iter = m_pending.begin(); iter != m_pending.end(); iter++)
+	{
+		auto &target = iter.key().first ? m_nameRegexps : m_pathRegexps;
+		const auto options = QRegularExpression::PatternOptions(iter.key().second);
+		const auto &patterns = iter.value();
+		QRegularExpression merged("(?:" + patterns.join(")|(?:") + ")", options);
+		if (merged.isValid())
+		{
+			target.append(merged);
+			continue;
+		}
+		// valid on their own, but not together (duplicate group names and the like)
+		for (auto &pattern : patterns)
+		{
+			target.append(QRegularExpression(pattern, options));
+		}
+	}
+	m_pending.clear();
+}
+
+bool CompiledMatcher::matches(const QString &string) const
+{
+	if (m_matchesAll)
+	{
+		return true;
+	}
+	if (m_hasTree && m_tree.covers(QStringRef(&string)))
+	{
+		return true;
+	}
+	for (auto &regexp : m_pathRegexps)
+	{
+		if (regexp.match(string).hasMatch())
+		{
+			return true;
+		}
+	}
+	if (!m_nameRegexps.isEmpty())
+	{
+		QStringRef fileName(&string);
+		auto slash = string.lastIndexOf('/');
+		if (slash != -1)
+		{
+			fileName = string.midRef(slash + 1);
+		}
+		for (auto &regexp : m_nameRegexps)
+		{
+			if (regexp.match(fileName).hasMatch())
+			{
+				return true;
+			}
+		}
+	}
+	for (auto &other : m_others)
+	{
+		if (other->matches(string))
+		{
+			return true;
+		}
+	}
+	return false;
+}
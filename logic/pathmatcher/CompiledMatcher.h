@@ -0,0 +1,53 @@
+#pragma once
+
+#include "IPathMatcher.h"
+#include <SeparatorPrefixTree.h>
+#include <QList>
+#include <QMap>
+#include <QPair>
+#include <QRegularExpression>
+
+#include "multimc_logic_export.h"
+
+/**
+ * A matcher tree flattened into a single matcher.
+ *
+ * Prefix trees are merged into one tree, and all the regular expressions that share pattern
+ * options are merged into one alternation. Paths are never copied while matching.
+ * Matchers of unknown kinds are kept and asked as they are.
+ */
+class MULTIMC_LOGIC_EXPORT CompiledMatcher : public IPathMatcher
+{
+public:
+	virtual ~CompiledMatcher() {};
+
+	/// compile a matcher and all the matchers it contains
+	static std::shared_ptr<CompiledMatcher> compile(Ptr matcher);
+
+	virtual bool matches(const QString &string) const override;
+
+	/// number of regular expressions evaluated for each path
+	int regexpCount() const
+	{
+		return m_pathRegexps.size() + m_nameRegexps.size();
+	}
+
+private:
+	CompiledMatcher() {};
+	void add(Ptr matcher);
+	void addRegexp(const QRegularExpression &regexp, bool onlyFilenamePart);
+	void finish();
+
+private:
+	/// patterns waiting to be merged, by file name only and pattern options
+	QMap<QPair<bool, int>, QStringList> m_pending;
+
+	bool m_matchesAll = false;
+	bool m_hasTree = false;
+	SeparatorPrefixTree<'/'> m_tree;
+	/// applied to the whole path
+	QList<QRegularExpression> m_pathRegexps;
+	/// applied to the part after the last slash
+	QList<QRegularExpression> m_nameRegexps;
+	QList<Ptr> m_others;
+};
@@ -102,10 +102,15 @@ QVariant Resource::getResourceInternal(const int typeId) const
 	const QVariant variant = m_handler->result();
 	const auto typePair = qMakePair(int(variant.type()), typeId);
 
-	// do we have an explicit transformer? use it.
+	// do we have an explicit transformer? use it, but only once for every result.
 	if (m_transfomers.contains(typePair))
 	{
-		return m_transfomers.value(typePair)(variant);
+		auto it = m_transformCache.constFind(typeId);
+		if (it == m_transformCache.constEnd())
+		{
+			it = m_transformCache.insert(typeId, m_transfomers.value(typePair)(variant));
+		}
+		return it.value();
 	}
 	else
 	{
@@ -117,6 +122,8 @@ QVariant Resource::getResourceInternal(const int typeId) const
 
 void Resource::reportResult()
 {
+	// the result changed, so everything we transformed previously is outdated
+	m_transformCache.clear();
 	for (ResourceObserver *observer : m_observers)
 	{
 		observer->resourceUpdated();
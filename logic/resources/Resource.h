@@ -116,6 +116,11 @@ private: // half private, implementation details
 
 private: // truly private
 	QList<ResourceObserver *> m_observers;
+	/** Transformed results of the current handler result, keyed by the target type id.
+	 * Transformers can be expensive (decoding images etc.), so they are only run once per result.
+	 * Cleared in reportResult, whenever the handler changes its result.
+	 */
+	mutable QMap<int, QVariant> m_transformCache;
 	std::shared_ptr<ResourceHandler> m_handler = nullptr;
 	Ptr m_placeholder = nullptr;
 	const QString m_resource;
@@ -67,6 +67,8 @@ signals:
 	void succeeded();
 	void failed(QString reason);
 	void status(QString status);
+	/// a task this task depends on was started, for launch timing and similar instrumentation
+	void subTaskStarted(Task *task, QString name);
 
 public
 slots:
@@ -86,8 +86,8 @@ void DownloadTask::vinfoDownloadFailed()
 
 void DownloadTask::processDownloadedVersionInfo()
 {
-	VersionFileList m_currentVersionFileList;
-	VersionFileList m_newVersionFileList;
+	m_currentVersionFileList.clear();
+	m_newVersionFileList.clear();
 
 	setStatus(tr("Reading file list for new version..."));
 	qDebug() << "Reading file list for new version...";
@@ -117,13 +117,32 @@ void DownloadTask::processDownloadedVersionInfo()
 	m_newVersionFileListDownload.reset();
 	m_vinfoNetJob.reset();
 
+	// hash the installed files in the background
+	m_fileCheckTask = std::make_shared<FileCheckTask>(m_currentVersionFileList, m_newVersionFileList, m_status.rootPath, "updatecache");
+	connect(m_fileCheckTask.get(), &Task::succeeded, this, &DownloadTask::processFileChecks);
+	connect(m_fileCheckTask.get(), &Task::failed, this, &DownloadTask::fileCheckFailed);
+	connect(m_fileCheckTask.get(), &Task::status, this, &DownloadTask::setStatus);
+	connect(m_fileCheckTask.get(), &Task::progress, this, &DownloadTask::setProgress);
+	m_fileCheckTask->start();
+}
+
+void DownloadTask::fileCheckFailed(QString reason)
+{
+	qCritical() << "Failed to check installed files:" << reason;
+	emitFailed(tr("Failed to check installed files: %1").arg(reason));
+}
+
+void DownloadTask::processFileChecks()
+{
+	auto localFiles = m_fileCheckTask->states();
+
 	setStatus(tr("Processing file lists - figuring out how to install the update..."));
 
 	// make a new netjob for the actual update files
 	NetJobPtr netJob (new NetJob("Update Files"));
 
 	// fill netJob and operationList
-	if (!processFileLists(m_currentVersionFileList, m_newVersionFileList, m_status.rootPath, m_updateFilesDir.path(), netJob, m_operations))
+	if (!processFileLists(m_currentVersionFileList, m_newVersionFileList, m_status.rootPath, m_updateFilesDir.path(), netJob, m_operations, localFiles))
 	{
 		emitFailed(tr("Failed to process update lists..."));
 		return;
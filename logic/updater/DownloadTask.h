@@ -18,6 +18,7 @@
 #include "tasks/Task.h"
 #include "net/NetJob.h"
 #include "GoUpdate.h"
+#include "FileCheckTask.h"
 
 #include "multimc_logic_export.h"
 
@@ -69,6 +70,10 @@ protected:
 
 	NetJobPtr m_filesNetJob;
 
+	VersionFileList m_currentVersionFileList;
+	VersionFileList m_newVersionFileList;
+	std::shared_ptr<FileCheckTask> m_fileCheckTask;
+
 	Status m_status;
 
 	OperationList m_operations;
@@ -87,6 +92,10 @@ protected slots:
 	void processDownloadedVersionInfo();
 	void vinfoDownloadFailed();
 
+	/// called when the installed files are checked, figures out what to download
+	void processFileChecks();
+	void fileCheckFailed(QString reason);
+
 	void fileDownloadFinished();
 	void fileDownloadFailed(QString reason);
 	void fileDownloadProgressChanged(qint64 current, qint64 total);
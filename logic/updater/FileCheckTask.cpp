@@ -0,0 +1,205 @@
+#include "FileCheckTask.h"
+
+#include <QtConcurrentMap>
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QFile>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDebug>
+#include <QSet>
+
+#include <FileSystem.h>
+#include "Json.h"
+
+namespace GoUpdate
+{
+
+FileCheckTask::FileCheckTask(const VersionFileList &currentVersion, const VersionFileList &newVersion,
+							 const QString &rootPath, const QString &manifestPath, QObject *parent)
+	: Task(parent), m_rootPath(rootPath), m_manifestPath(manifestPath)
+{
+	QSet<QString> seen;
+	for (auto &entry : newVersion)
+	{
+		if (!seen.contains(entry.path))
+		{
+			seen.insert(entry.path);
+			m_items.append({entry.path, true});
+		}
+	}
+	// files of the current version only need to be looked at, they are either kept or deleted
+	for (auto &entry : currentVersion)
+	{
+		if (!seen.contains(entry.path))
+		{
+			seen.insert(entry.path);
+			m_items.append({entry.path, false});
+		}
+	}
+	connect(&m_watcher, &QFutureWatcher<LocalFileState>::finished, this, &FileCheckTask::checkingFinished);
+	connect(&m_watcher, &QFutureWatcher<LocalFileState>::progressValueChanged, this, [this](int value)
+	{
+		setProgress(value, m_items.size());
+	});
+}
+
+LocalFileStates FileCheckTask::states() const
+{
+	return m_states;
+}
+
+LocalFileState FileCheckTask::checkFile(const QString &path, bool hash, const LocalFileState &known)
+{
+	LocalFileState state;
+	QFileInfo info(path);
+	if (!info.exists())
+	{
+		return state;
+	}
+	state.exists = true;
+	state.size = info.size();
+	state.lastModified = info.lastModified().toMSecsSinceEpoch();
+	if (!hash)
+	{
+		return state;
+	}
+	if (!info.isReadable())
+	{
+		qCritical() << "File " << path << " is not readable.";
+		state.inaccessible = true;
+	}
+	if (!info.isWritable())
+	{
+		qCritical() << "File " << path << " is not writable.";
+		state.inaccessible = true;
+	}
+	if (state.inaccessible)
+	{
+		return state;
+	}
+	if (!known.md5.isEmpty() && known.size == state.size && known.lastModified == state.lastModified)
+	{
+		state.md5 = known.md5;
+		return state;
+	}
+	QFile file(path);
+	if (!file.open(QFile::ReadOnly))
+	{
+		qCritical() << "File " << path << " cannot be opened for reading.";
+		state.inaccessible = true;
+		return state;
+	}
+	QCryptographicHash md5(QCryptographicHash::Md5);
+	// reads the file in chunks
+	if (!md5.addData(&file))
+	{
+		qCritical() << "File " << path << " cannot be read.";
+		state.inaccessible = true;
+		return state;
+	}
+	state.md5 = md5.result().toHex();
+	return state;
+}
+
+void FileCheckTask::executeTask()
+{
+	setStatus(tr("Checking installed files..."));
+	loadManifest();
+	const QString root = m_rootPath;
+	const LocalFileStates known = m_known;
+	std::function<LocalFileState(const Item &)> check = [root, known](const Item &item)
+	{
+		return checkFile(FS::PathCombine(root, item.relativePath), item.hash, known.value(item.relativePath));
+	};
+	m_watcher.setFuture(QtConcurrent::mapped(m_items, check));
+}
+
+void FileCheckTask::checkingFinished()
+{
+	auto future = m_watcher.future();
+	int reused = 0;
+	for (int i = 0; i < m_items.size(); i++)
+	{
+		auto &item = m_items[i];
+		auto state = future.resultAt(i);
+		auto known = m_known.value(item.relativePath);
+		if (!known.md5.isEmpty() && known.md5 == state.md5 && known.lastModified == state.lastModified)
+		{
+			reused++;
+		}
+		m_states.insert(item.relativePath, state);
+	}
+	qDebug() << "Checked" << m_items.size() << "files," << reused << "hashes reused from the manifest.";
+	saveManifest();
+	emitSucceeded();
+}
+
+void FileCheckTask::loadManifest()
+{
+	m_known.clear();
+	if (m_manifestPath.isEmpty() || !QFile::exists(m_manifestPath))
+	{
+		return;
+	}
+	try
+	{
+		auto root = Json::requireObject(Json::requireDocument(m_manifestPath));
+		if (Json::ensureString(root, "root", QString()) != m_rootPath)
+		{
+			return;
+		}
+		auto files = Json::requireObject(root, "files");
+		for (auto iter = files.begin(); iter != files.end(); iter++)
+		{
+			auto obj = Json::requireObject(iter.value());
+			LocalFileState state;
+			state.exists = true;
+			state.md5 = Json::requireString(obj, "md5");
+			state.size = Json::requireDouble(obj, "size");
+			state.lastModified = Json::requireDouble(obj, "lastModified");
+			m_known.insert(iter.key(), state);
+		}
+	}
+	catch (Exception &e)
+	{
+		qWarning() << "Couldn't read the update file manifest:" << e.cause();
+		m_known.clear();
+	}
+}
+
+void FileCheckTask::saveManifest()
+{
+	if (m_manifestPath.isEmpty())
+	{
+		return;
+	}
+	QJsonObject files;
+	for (auto iter = m_states.begin(); iter != m_states.end(); iter++)
+	{
+		auto &state = iter.value();
+		if (state.md5.isEmpty())
+		{
+			continue;
+		}
+		QJsonObject obj;
+		obj.insert("md5", state.md5);
+		obj.insert("size", double(state.size));
+		obj.insert("lastModified", double(state.lastModified));
+		files.insert(iter.key(), obj);
+	}
+	QJsonObject root;
+	root.insert("root", m_rootPath);
+	root.insert("files", files);
+	try
+	{
+		FS::write(m_manifestPath, QJsonDocument(root).toJson(QJsonDocument::Compact));
+	}
+	catch (Exception &e)
+	{
+		qWarning() << "Couldn't save the update file manifest:" << e.cause();
+	}
+}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "tasks/Task.h"
+#include "GoUpdate.h"
+
+#include <QFutureWatcher>
+
+#include "multimc_logic_export.h"
+
+namespace GoUpdate
+{
+
+/*!
+ * Checks the files of the installation on a thread pool.
+ *
+ * Files that are part of the new version are hashed. Hashes are remembered in a manifest
+ * together with the file size and modification time, files that didn't change since the
+ * last check are not read again.
+ */
+class MULTIMC_LOGIC_EXPORT FileCheckTask : public Task
+{
+	Q_OBJECT
+public:
+	FileCheckTask(const VersionFileList &currentVersion, const VersionFileList &newVersion,
+				  const QString &rootPath, const QString &manifestPath, QObject *parent = 0);
+
+	/// results, valid after the task succeeded
+	LocalFileStates states() const;
+
+	/*!
+	 * Check a single file, reading it in chunks if it has to be hashed.
+	 * If known has the same size and modification time, its hash is reused.
+	 */
+	static LocalFileState checkFile(const QString &path, bool hash, const LocalFileState &known = LocalFileState());
+
+protected:
+	virtual void executeTask() override;
+
+private slots:
+	void checkingFinished();
+
+private:
+	struct Item
+	{
+		QString relativePath;
+		bool hash;
+	};
+	void loadManifest();
+	void saveManifest();
+
+private:
+	QList<Item> m_items;
+	QString m_rootPath;
+	QString m_manifestPath;
+	LocalFileStates m_known;
+	LocalFileStates m_states;
+	QFutureWatcher<LocalFileState> m_watcher;
+};
+
+}
@@ -4,6 +4,7 @@
 #include <QFile>
 #include <Env.h>
 #include <FileSystem.h>
+#include "FileCheckTask.h"
 
 namespace GoUpdate
 {
@@ -75,15 +76,38 @@ bool processFileLists
 	NetJobPtr job,
 	OperationList &ops
 )
+{
+	LocalFileStates localFiles;
+	for (VersionFileEntry entry : currentVersion)
+	{
+		localFiles.insert(entry.path, FileCheckTask::checkFile(FS::PathCombine(rootPath, entry.path), false));
+	}
+	for (VersionFileEntry entry : newVersion)
+	{
+		localFiles.insert(entry.path, FileCheckTask::checkFile(FS::PathCombine(rootPath, entry.path), true));
+	}
+	return processFileLists(currentVersion, newVersion, rootPath, tempPath, job, ops, localFiles);
+}
+
+bool processFileLists
+(
+	const VersionFileList &currentVersion,
+	const VersionFileList &newVersion,
+	const QString &rootPath,
+	const QString &tempPath,
+	NetJobPtr job,
+	OperationList &ops,
+	const LocalFileStates &localFiles
+)
 {
 	// First, if we've loaded the current version's file list, we need to iterate through it and
 	// delete anything in the current one version's list that isn't in the new version's list.
 	for (VersionFileEntry entry : currentVersion)
 	{
-		QFileInfo toDelete(FS::PathCombine(rootPath, entry.path));
-		if (!toDelete.exists())
+		const bool exists = localFiles.value(entry.path).exists;
+		if (!exists)
 		{
-			qCritical() << "Expected file " << toDelete.absoluteFilePath()
+			qCritical() << "Expected file " << FS::PathCombine(rootPath, entry.path)
 						 << " doesn't exist!";
 		}
 		bool keep = false;
@@ -103,7 +127,7 @@ bool processFileLists
 		// If the loop reaches the end and we didn't find a match, delete the file.
 		if (!keep)
 		{
-			if (toDelete.exists())
+			if (exists)
 				ops.append(Operation::DeleteOp(entry.path));
 		}
 	}
@@ -111,50 +135,24 @@ bool processFileLists
 	// Next, check each file in MultiMC's folder and see if we need to update them.
 	for (VersionFileEntry entry : newVersion)
 	{
-		// TODO: Let's not MD5sum a ton of files on the GUI thread. We should probably find a
-		// way to do this in the background.
-		QString fileMD5;
 		QString realEntryPath = FS::PathCombine(rootPath, entry.path);
-		QFile entryFile(realEntryPath);
-		QFileInfo entryInfo(realEntryPath);
+		auto state = localFiles.value(entry.path);
 
 		bool needs_upgrade = false;
-		if (!entryFile.exists())
+		if (!state.exists)
 		{
 			needs_upgrade = true;
 		}
-		else
+		else if (state.inaccessible)
 		{
-			bool pass = true;
-			if (!entryInfo.isReadable())
-			{
-				qCritical() << "File " << realEntryPath << " is not readable.";
-				pass = false;
-			}
-			if (!entryInfo.isWritable())
-			{
-				qCritical() << "File " << realEntryPath << " is not writable.";
-				pass = false;
-			}
-			if (!entryFile.open(QFile::ReadOnly))
-			{
-				qCritical() << "File " << realEntryPath << " cannot be opened for reading.";
-				pass = false;
-			}
-			if (!pass)
-			{
-				ops.clear();
-				return false;
-			}
+			// the reason was logged when the file was checked
+			ops.clear();
+			return false;
 		}
 
 		if(!needs_upgrade)
 		{
-			QCryptographicHash hash(QCryptographicHash::Md5);
-			auto foo = entryFile.readAll();
-
-			hash.addData(foo);
-			fileMD5 = hash.result().toHex();
+			const QString &fileMD5 = state.md5;
 			if ((fileMD5 != entry.md5))
 			{
 				qDebug() << "MD5Sum does not match!";
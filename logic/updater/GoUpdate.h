@@ -1,5 +1,6 @@
 #pragma once
 #include <QByteArray>
+#include <QHash>
 #include <net/NetJob.h>
 
 #include "multimc_logic_export.h"
@@ -101,6 +102,22 @@ struct MULTIMC_LOGIC_EXPORT Operation
 };
 typedef QList<Operation> OperationList;
 
+/**
+ * What the updater knows about a file of the current installation.
+ */
+struct MULTIMC_LOGIC_EXPORT LocalFileState
+{
+	bool exists = false;
+	//! The file exists, but can't be read or written.
+	bool inaccessible = false;
+	//! Empty if the file wasn't hashed.
+	QString md5;
+	qint64 size = 0;
+	qint64 lastModified = 0;
+};
+//! Keyed by the path relative to the installation root.
+typedef QHash<QString, LocalFileState> LocalFileStates;
+
 /**
  * Loads the file list from the given version info JSON object into the given list.
  */
@@ -109,6 +126,22 @@ bool MULTIMC_LOGIC_EXPORT parseVersionInfo(const QByteArray &data, VersionFileLi
 /*!
  * Takes a list of file entries for the current version's files and the new version's files
  * and populates the downloadList and operationList with information about how to download and install the update.
+ *
+ * localFiles describes the installed files, as checked by FileCheckTask.
+ */
+bool MULTIMC_LOGIC_EXPORT processFileLists
+(
+	const VersionFileList &currentVersion,
+	const VersionFileList &newVersion,
+	const QString &rootPath,
+	const QString &tempPath,
+	NetJobPtr job,
+	OperationList &ops,
+	const LocalFileStates &localFiles
+);
+
+/*!
+ * Same as above, but checks the installed files synchronously, on the calling thread.
  */
 bool MULTIMC_LOGIC_EXPORT processFileLists
 (
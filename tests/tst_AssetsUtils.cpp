@@ -0,0 +1,85 @@
+#include <QTest>
+#include <QTemporaryDir>
+#include <QDateTime>
+#include "TestUtil.h"
+
+#include "minecraft/AssetsUtils.h"
+#include <FileSystem.h>
+
+namespace
+{
+void writeFile(const QString &path, const QByteArray &content)
+{
+	FS::ensureFilePathExists(path);
+	QFile file(path);
+	file.open(QFile::WriteOnly);
+	file.write(content);
+}
+}
+
+class AssetsUtilsTest : public QObject
+{
+	Q_OBJECT
+
+private:
+	QTemporaryDir m_root;
+	QString m_oldCurrent;
+
+private
+slots:
+	void init()
+	{
+		// the assets folder is relative to the working directory
+		m_oldCurrent = QDir::currentPath();
+		QDir::setCurrent(m_root.path());
+	}
+	void cleanup()
+	{
+		QDir::setCurrent(m_oldCurrent);
+	}
+
+	void test_Reconstruct()
+	{
+		writeFile("assets/indexes/legacy.json", R"({
+			"virtual": true,
+			"objects": {
+				"sounds/a.ogg": { "hash": "aa00000000000000000000000000000000000001", "size": 5 },
+				"sounds/deep/b.ogg": { "hash": "bb00000000000000000000000000000000000002", "size": 5 },
+				"missing.ogg": { "hash": "cc00000000000000000000000000000000000003", "size": 5 }
+			}
+		})");
+		writeFile("assets/objects/aa/aa00000000000000000000000000000000000001", "aaaaa");
+		writeFile("assets/objects/bb/bb00000000000000000000000000000000000002", "bbbbb");
+
+		AssetsUtils::ReconstructStats stats;
+		auto dir = AssetsUtils::reconstructAssets("legacy", &stats);
+		QCOMPARE(dir.absolutePath(), AssetsUtils::virtualAssetsDir("legacy").absolutePath());
+		QCOMPARE(stats.linked + stats.copied, 2);
+		QCOMPARE(stats.failed, 1);
+		QCOMPARE(TestsInternal::readFile(dir.absoluteFilePath("sounds/a.ogg")), QByteArray("aaaaa"));
+		QCOMPARE(TestsInternal::readFile(dir.absoluteFilePath("sounds/deep/b.ogg")), QByteArray("bbbbb"));
+		QVERIFY(QFile::exists(dir.absoluteFilePath(".lastused")));
+
+		// the second time around, everything is there already
+		AssetsUtils::reconstructAssets("legacy", &stats);
+		QCOMPARE(stats.present, 2);
+		QCOMPARE(stats.linked + stats.copied, 0);
+	}
+
+	void test_RemoveStale()
+	{
+		writeFile("assets/virtual/old/.lastused", "2000-01-01T00:00:00Z");
+		writeFile("assets/virtual/kept/.lastused", "2000-01-01T00:00:00Z");
+		writeFile("assets/virtual/recent/.lastused",
+				  QDateTime::currentDateTimeUtc().toString(Qt::ISODate).toUtf8());
+
+		QCOMPARE(AssetsUtils::removeStaleVirtualAssets(30, "kept"), 1);
+		QVERIFY(!QDir("assets/virtual/old").exists());
+		QVERIFY(QDir("assets/virtual/kept").exists());
+		QVERIFY(QDir("assets/virtual/recent").exists());
+	}
+};
+
+QTEST_GUILESS_MAIN(AssetsUtilsTest)
+
+#include "tst_AssetsUtils.moc"
@@ -0,0 +1,75 @@
+#include <QTest>
+#include <QBuffer>
+#include <thread>
+#include "TestUtil.h"
+
+#include "AsyncLogWriter.h"
+
+class AsyncLogWriterTest : public QObject
+{
+	Q_OBJECT
+
+private
+slots:
+	void test_Format()
+	{
+		QCOMPARE(AsyncLogWriter::formatLine(QtWarningMsg, 12345, "hello"), QByteArray("   12.345 W hello\n"));
+	}
+
+	void test_MinimumLevel()
+	{
+		auto buffer = std::make_shared<QBuffer>();
+		buffer->open(QIODevice::WriteOnly);
+		AsyncLogWriter writer(buffer, false);
+		writer.setMinimumLevel(AsyncLogWriter::levelFromString("warning", QtDebugMsg));
+		QVERIFY(!writer.accepts(QtDebugMsg));
+		QVERIFY(writer.accepts(QtWarningMsg));
+		QVERIFY(writer.accepts(QtFatalMsg));
+		writer.post(QtDebugMsg, 0, "dropped");
+		writer.post(QtCriticalMsg, 0, "kept");
+		writer.flush();
+		QCOMPARE(buffer->data(), QByteArray("    0.000 C kept\n"));
+	}
+
+	void test_OrderAcrossThreads()
+	{
+		auto buffer = std::make_shared<QBuffer>();
+		buffer->open(QIODevice::WriteOnly);
+		AsyncLogWriter writer(buffer, false);
+		writer.start();
+		const int threads = 4;
+		const int messages = 2000;
+		std::vector<std::thread> producers;
+		for (int t = 0; t < threads; t++)
+		{
+			producers.emplace_back([&writer, t, messages]()
+			{
+				for (int i = 0; i < messages; i++)
+				{
+					writer.post(QtDebugMsg, 0, QString("%1 %2").arg(t).arg(i));
+				}
+			});
+		}
+		for (auto &producer : producers)
+		{
+			producer.join();
+		}
+		writer.stop();
+
+		auto lines = buffer->data().split('\n');
+		// trailing newline
+		QCOMPARE(lines.size(), threads * messages + 1);
+		QVector<int> next(threads, 0);
+		for (int i = 0; i < threads * messages; i++)
+		{
+			auto parts = lines[i].mid(QByteArray("    0.000 D ").size()).split(' ');
+			int t = parts[0].toInt();
+			QCOMPARE(parts[1].toInt(), next[t]);
+			next[t]++;
+		}
+	}
+};
+
+QTEST_GUILESS_MAIN(AsyncLogWriterTest)
+
+#include "tst_AsyncLogWriter.moc"
@@ -5,6 +5,7 @@
 
 #include "updater/GoUpdate.h"
 #include "updater/DownloadTask.h"
+#include "updater/FileCheckTask.h"
 #include "updater/UpdateChecker.h"
 #include <FileSystem.h>
 
@@ -186,6 +187,31 @@ slots:
 		QCOMPARE(operations, expectedOperations);
 	}
 
+	void test_checkFileReusesKnownHash()
+	{
+		QTemporaryDir tempDir;
+		QString path = FS::PathCombine(tempDir.path(), "file");
+		FS::write(path, "some content");
+
+		auto hashed = FileCheckTask::checkFile(path, true);
+		QVERIFY(hashed.exists);
+		QVERIFY(!hashed.inaccessible);
+		QCOMPARE(hashed.md5, QString("9893532233caff98cd083a116b013c0b"));
+
+		// same size and modification time - the file is not read again
+		LocalFileState known = hashed;
+		known.md5 = "not really a hash";
+		QCOMPARE(FileCheckTask::checkFile(path, true, known).md5, known.md5);
+
+		// different size - hashed again
+		known.size++;
+		QCOMPARE(FileCheckTask::checkFile(path, true, known).md5, hashed.md5);
+
+		// not asked to hash
+		QVERIFY(FileCheckTask::checkFile(path, false).md5.isEmpty());
+		QVERIFY(!FileCheckTask::checkFile(FS::PathCombine(tempDir.path(), "missing"), true).exists);
+	}
+
 	void test_OSXPathFixup()
 	{
 		QString path, pathOrig;
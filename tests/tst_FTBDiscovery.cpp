@@ -0,0 +1,157 @@
+#include <QTest>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include "TestUtil.h"
+
+#include "minecraft/ftb/FTBDiscovery.h"
+#include "FileSystem.h"
+
+class FTBDiscoveryTest : public QObject
+{
+	Q_OBJECT
+
+	QString modpack(const QString &dir, const QString &name, const QString &extra = QString())
+	{
+		return QString("<modpack dir=\"%1\" name=\"%2\" logo=\"%1.png\" mcVersion=\"1.7.10\" %3/>\n")
+			.arg(dir, name, extra);
+	}
+
+	void writePacks(const QString &launcherDir, const QString &file, const QStringList &packs)
+	{
+		FS::write(FS::PathCombine(launcherDir, "ModPacks", file),
+				  ("<modpacks>\n" + packs.join("") + "</modpacks>\n").toUtf8());
+	}
+
+	/// run a discovery to the end, returning the records found
+	QList<FTBRecord> discover(const QTemporaryDir &root, int *parsed = nullptr)
+	{
+		FTBDiscovery discovery(FS::PathCombine(root.path(), "launcher"),
+							   FS::PathCombine(root.path(), "data"),
+							   FS::PathCombine(root.path(), "cache.json"));
+		QSignalSpy found(&discovery, SIGNAL(found(FTBRecord)));
+		QSignalSpy finished(&discovery, SIGNAL(finished(int)));
+		discovery.start();
+		discovery.waitForFinished();
+		QList<FTBRecord> records;
+		for (auto &args : found)
+		{
+			records.append(args.at(0).value<FTBRecord>());
+		}
+		if (parsed)
+		{
+			*parsed = finished.isEmpty() ? -1 : finished.first().at(0).toInt();
+		}
+		return records;
+	}
+
+	void makeInstall(const QTemporaryDir &root)
+	{
+		const QString launcher = FS::PathCombine(root.path(), "launcher");
+		QVERIFY(FS::ensureFolderPathExists(FS::PathCombine(root.path(), "data", "PackA")));
+		QVERIFY(FS::ensureFolderPathExists(FS::PathCombine(root.path(), "data", "PackB")));
+		writePacks(launcher, "modpacks.xml",
+				   {modpack("PackA", "Pack A"), modpack("Missing", "Not installed"),
+					modpack("PackB", "Pack B",
+							"version=\"1.1\" customMCVersions=\"1.0^1.6.4;1.1^1.7.2\"")});
+		writePacks(launcher, "thirdparty.xml", {modpack("PackA", "Pack A again")});
+	}
+
+private
+slots:
+	void test_Streams()
+	{
+		QTemporaryDir root;
+		makeInstall(root);
+		int parsed = 0;
+		auto records = discover(root, &parsed);
+		QCOMPARE(parsed, 2);
+		QCOMPARE(records.size(), 2);
+		QCOMPARE(records[0].name, QString("Pack A"));
+		QCOMPARE(records[0].iconKey, QString("PackA"));
+		QCOMPARE(records[0].mcVersion, QString("1.7.10"));
+		QCOMPARE(records[0].instanceDir, FS::PathCombine(root.path(), "data", "PackA"));
+		QCOMPARE(records[0].templateDir,
+				 FS::PathCombine(root.path(), "launcher", "ModPacks", "PackA"));
+		QCOMPARE(records[1].name, QString("Pack B"));
+		QCOMPARE(records[1].mcVersion, QString("1.7.2"));
+	}
+
+	void test_CacheReused()
+	{
+		QTemporaryDir root;
+		makeInstall(root);
+		auto first = discover(root);
+		int parsed = -1;
+		auto second = discover(root, &parsed);
+		QCOMPARE(parsed, 0);
+		QCOMPARE(second.size(), first.size());
+		for (int i = 0; i < first.size(); i++)
+		{
+			QCOMPARE(second[i].name, first[i].name);
+			QCOMPARE(second[i].mcVersion, first[i].mcVersion);
+			QCOMPARE(second[i].instanceDir, first[i].instanceDir);
+		}
+	}
+
+	void test_CacheInvalidation()
+	{
+		QTemporaryDir root;
+		makeInstall(root);
+		discover(root);
+
+		// one file changes, the other one is still known
+		writePacks(FS::PathCombine(root.path(), "launcher"), "thirdparty.xml",
+				   {modpack("PackA", "Pack A again"), modpack("PackB", "Pack B again"),
+					modpack("PackC", "Pack C")});
+		int parsed = -1;
+		auto records = discover(root, &parsed);
+		QCOMPARE(parsed, 1);
+		QCOMPARE(records.size(), 2);
+
+		// a broken cache is read again from scratch
+		FS::write(FS::PathCombine(root.path(), "cache.json"), "{ nope");
+		records = discover(root, &parsed);
+		QCOMPARE(parsed, 2);
+		QCOMPARE(records.size(), 2);
+	}
+
+	void test_CachedRecords()
+	{
+		QTemporaryDir root;
+		makeInstall(root);
+		FTBDiscovery discovery(FS::PathCombine(root.path(), "launcher"),
+							   FS::PathCombine(root.path(), "data"),
+							   FS::PathCombine(root.path(), "cache.json"));
+		// nothing before the first discovery
+		QVERIFY(discovery.cachedRecords().isEmpty());
+
+		auto found = discover(root);
+		auto cached = discovery.cachedRecords();
+		QCOMPARE(cached.size(), found.size());
+		for (int i = 0; i < found.size(); i++)
+		{
+			QCOMPARE(cached[i].name, found[i].name);
+			QCOMPARE(cached[i].instanceDir, found[i].instanceDir);
+			// every field survives the cache, or the instance list would reload them all
+			QVERIFY(cached[i] == found[i]);
+		}
+
+		// it belongs to that install only
+		FTBDiscovery other(FS::PathCombine(root.path(), "launcher"), root.path(),
+						   FS::PathCombine(root.path(), "cache.json"));
+		QVERIFY(other.cachedRecords().isEmpty());
+	}
+
+	void test_NoInstall()
+	{
+		QTemporaryDir root;
+		int parsed = -1;
+		auto records = discover(root, &parsed);
+		QCOMPARE(parsed, 0);
+		QVERIFY(records.isEmpty());
+	}
+};
+
+QTEST_GUILESS_MAIN(FTBDiscoveryTest)
+
+#include "tst_FTBDiscovery.moc"
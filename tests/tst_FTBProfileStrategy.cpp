@@ -0,0 +1,62 @@
+#include <QTest>
+#include <QTemporaryDir>
+#include "TestUtil.h"
+
+#include "minecraft/ftb/OneSixFTBInstance.h"
+#include "minecraft/ftb/FTBProfileStrategy.h"
+#include "settings/INISettingsObject.h"
+#include "FileSystem.h"
+
+class FTBProfileStrategyTest : public QObject
+{
+	Q_OBJECT
+
+	SettingsObjectPtr globalSettings(const QTemporaryDir &root)
+	{
+		auto settings = std::make_shared<INISettingsObject>(FS::PathCombine(root.path(), "multimc.cfg"));
+		for (auto id : {"PreLaunchCommand", "WrapperCommand", "PostExitCommand", "ShowConsole", "AutoCloseConsole",
+						"LogPrePostOutput", "SaveLaunchTrace", "JavaPath", "JavaTimestamp", "JavaVersion", "JvmArgs",
+						"JavaClassDataSharing", "LaunchMaximized", "MinecraftWinWidth", "MinecraftWinHeight",
+						"MinMemAlloc", "MaxMemAlloc", "PermGen"})
+		{
+			settings->registerSetting(id, QVariant());
+		}
+		settings->registerSetting("FTBRoot", FS::PathCombine(root.path(), "ftb"));
+		return settings;
+	}
+
+private
+slots:
+	void test_FingerprintFollowsPackFiles()
+	{
+		QTemporaryDir root;
+		const QString instDir = FS::PathCombine(root.path(), "ftb", "SomePack");
+		FS::write(FS::PathCombine(root.path(), "ftb", "versions", "1.7.10", "1.7.10.json"), "{}");
+		FS::write(FS::PathCombine(instDir, "minecraft", "pack.json"), "{}");
+		FS::write(FS::PathCombine(instDir, "version"), "1.0");
+		auto settings = std::make_shared<INISettingsObject>(FS::PathCombine(instDir, "instance.cfg"));
+		OneSixFTBInstance instance(globalSettings(root), settings, instDir);
+		settings->set("IntendedVersion", "1.7.10");
+		FTBProfileStrategy strategy(&instance);
+
+		auto before = strategy.inputsFingerprint();
+		QVERIFY(!before.isEmpty());
+		QCOMPARE(strategy.inputsFingerprint(), before);
+
+		// the FTB launcher updated the pack
+		FS::write(FS::PathCombine(instDir, "minecraft", "pack.json"), "{ \"libraries\": [] }");
+		auto afterPack = strategy.inputsFingerprint();
+		QVERIFY(afterPack != before);
+
+		FS::write(FS::PathCombine(instDir, "version"), "1.0.1");
+		auto afterVersion = strategy.inputsFingerprint();
+		QVERIFY(afterVersion != afterPack);
+
+		FS::write(FS::PathCombine(root.path(), "ftb", "versions", "1.7.10", "1.7.10.json"), "{ }");
+		QVERIFY(strategy.inputsFingerprint() != afterVersion);
+	}
+};
+
+QTEST_GUILESS_MAIN(FTBProfileStrategyTest)
+
+#include "tst_FTBProfileStrategy.moc"
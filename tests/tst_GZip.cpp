@@ -2,6 +2,7 @@
 #include "TestUtil.h"
 
 #include "GZip.h"
+#include <QBuffer>
 #include <random>
 
 void fib(int &prev, int &cur)
@@ -50,6 +51,23 @@ slots:
 			fib(prev, cur);
 		} while (cur < size);
 	}
+
+	void test_StreamOutputBoundary()
+	{
+		// compresses into a single input chunk that inflates to exactly four full output chunks
+		QByteArray original(4 * 64 * 1024, 'x');
+		QByteArray compressed;
+		QVERIFY(GZip::zip(original, compressed));
+		QBuffer input(&compressed);
+		QVERIFY(input.open(QIODevice::ReadOnly));
+		QByteArray decompressed;
+		QVERIFY(GZip::unzip(input, [&decompressed](const char *data, qint64 size)
+		{
+			decompressed.append(data, size);
+			return true;
+		}));
+		QCOMPARE(decompressed, original);
+	}
 };
 
 QTEST_GUILESS_MAIN(GZipTest)
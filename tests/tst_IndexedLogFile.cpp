@@ -0,0 +1,143 @@
+#include <QTest>
+#include <QTemporaryDir>
+#include <QBuffer>
+#include "TestUtil.h"
+
+#include "IndexedLogFile.h"
+#include "LogSearch.h"
+#include "GZip.h"
+
+namespace
+{
+QString writeFile(const QTemporaryDir &dir, const QString &name, const QByteArray &content)
+{
+	auto path = dir.path() + "/" + name;
+	QFile file(path);
+	file.open(QFile::WriteOnly);
+	file.write(content);
+	return path;
+}
+}
+
+class IndexedLogFileTest : public QObject
+{
+	Q_OBJECT
+
+private
+slots:
+	void test_IndexLines()
+	{
+		QCOMPARE(IndexedLogFile::indexLines("", 0), QVector<qint64>());
+		QCOMPARE(IndexedLogFile::indexLines("a\nbc\n", 5), QVector<qint64>({1, 4}));
+		// no terminator on the last line
+		QCOMPARE(IndexedLogFile::indexLines("a\n\nbc", 5), QVector<qint64>({1, 2, 5}));
+	}
+
+	void test_Lines()
+	{
+		QTemporaryDir dir;
+		auto path = writeFile(dir, "latest.log", "[INFO] first\r\n\n[WARN] Something Odd\n[INFO] last");
+		IndexedLogFile file(path);
+		file.start();
+		QTRY_VERIFY(file.isFinished());
+		QVERIFY(file.errorString().isEmpty());
+		QCOMPARE(file.lineCount(), 4);
+		QCOMPARE(file.line(0), QString("[INFO] first"));
+		QCOMPARE(file.line(1), QString());
+		QCOMPARE(file.line(3), QString("[INFO] last"));
+		QCOMPARE(file.line(4), QString());
+
+		QCOMPARE(file.find("INFO", 0, Qt::CaseSensitive), 0);
+		QCOMPARE(file.find("INFO", 1, Qt::CaseSensitive), 3);
+		QCOMPARE(file.find("something odd", 0, Qt::CaseInsensitive), 2);
+		QCOMPARE(file.find("something odd", 0, Qt::CaseSensitive), -1);
+		// wraps around
+		QCOMPARE(file.find("first", 3, Qt::CaseSensitive), 0);
+	}
+
+	void test_Gzipped()
+	{
+		QByteArray content;
+		for (int i = 0; i < 100000; i++)
+		{
+			content.append(QString("line %1\n").arg(i).toUtf8());
+		}
+		QByteArray compressed;
+		QVERIFY(GZip::zip(content, compressed));
+		QTemporaryDir dir;
+		auto path = writeFile(dir, "2016-01-01-1.log.gz", compressed);
+
+		IndexedLogFile file(path);
+		file.start();
+		QTRY_VERIFY(file.isFinished());
+		QCOMPARE(file.lineCount(), 100000);
+		QCOMPARE(file.line(54321), QString("line 54321"));
+		QCOMPARE(file.find("line 99999", 0, Qt::CaseSensitive), 99999);
+		QCOMPARE(file.content(), content);
+	}
+
+	void test_Unreadable()
+	{
+		QTemporaryDir dir;
+		auto path = writeFile(dir, "broken.log.gz", "this is not gzip");
+		IndexedLogFile file(path);
+		file.start();
+		QTRY_VERIFY(file.isFinished());
+		QVERIFY(!file.errorString().isEmpty());
+		QCOMPARE(file.lineCount(), 0);
+	}
+
+	void test_SearchDevice()
+	{
+		QByteArray content = "alpha\nBeta\ngamma beta\r\ndelta";
+		QBuffer buffer(&content);
+		buffer.open(QIODevice::ReadOnly);
+		QList<int> lines;
+		QStringList texts;
+		auto handler = [&](int line, const QString &text)
+		{
+			lines.append(line);
+			texts.append(text);
+			return true;
+		};
+		QVERIFY(LogSearch::searchDevice(buffer, false, "beta", Qt::CaseInsensitive, handler));
+		QCOMPARE(lines, QList<int>({1, 2}));
+		QCOMPARE(texts, QStringList({"Beta", "gamma beta"}));
+
+		QByteArray compressed;
+		QVERIFY(GZip::zip(content, compressed));
+		QBuffer gzipped(&compressed);
+		gzipped.open(QIODevice::ReadOnly);
+		lines.clear();
+		texts.clear();
+		QVERIFY(LogSearch::searchDevice(gzipped, true, "delta", Qt::CaseSensitive, handler));
+		QCOMPARE(lines, QList<int>({3}));
+	}
+
+	void test_SearchDeviceCancelled()
+	{
+		// a match only at the very end, so nothing but the flag can stop the read early
+		QByteArray content = QByteArray("nothing here\n").repeated(100000) + "needle\n";
+		QBuffer buffer(&content);
+		buffer.open(QIODevice::ReadOnly);
+		std::atomic<bool> cancelled(true);
+		int matches = 0;
+		auto handler = [&](int, const QString &)
+		{
+			matches++;
+			return true;
+		};
+		QVERIFY(LogSearch::searchDevice(buffer, false, "needle", Qt::CaseSensitive, handler, &cancelled));
+		QCOMPARE(matches, 0);
+		QVERIFY(buffer.pos() < content.size());
+
+		cancelled = false;
+		buffer.seek(0);
+		QVERIFY(LogSearch::searchDevice(buffer, false, "needle", Qt::CaseSensitive, handler, &cancelled));
+		QCOMPARE(matches, 1);
+	}
+};
+
+QTEST_GUILESS_MAIN(IndexedLogFileTest)
+
+#include "tst_IndexedLogFile.moc"
@@ -0,0 +1,101 @@
+#include <QTest>
+#include <QTemporaryDir>
+#include "TestUtil.h"
+
+#include "FileSystem.h"
+#include "java/JavaChecker.h"
+#include "java/JavaProbeCache.h"
+
+class JavaProbeTest : public QObject
+{
+	Q_OBJECT
+
+	// creates a fake java installation in dir, returns the path to the 'binary'
+	QString makeJava(const QString &dir, const QByteArray &release, const QByteArray &binary)
+	{
+		const QString javaPath = FS::PathCombine(dir, "bin", "java");
+		FS::write(javaPath, binary);
+		if (!release.isNull())
+		{
+			FS::write(FS::PathCombine(dir, "release"), release);
+		}
+		return javaPath;
+	}
+
+	QByteArray elfHeader(quint16 machine)
+	{
+		QByteArray header("\x7f" "ELF", 4);
+		header.append(char(2)); // 64 bit
+		header.append(char(1)); // little endian
+		header.append(QByteArray(12, 0));
+		header.append(char(machine & 0xFF));
+		header.append(char(machine >> 8));
+		return header;
+	}
+
+private
+slots:
+	void test_StaticProbeRelease()
+	{
+		QTemporaryDir dir;
+		auto path = makeJava(dir.path(), "JAVA_VERSION=\"1.8.0_102\"\nOS_NAME=\"Linux\"\nOS_ARCH=\"amd64\"\n", QByteArray("dummy"));
+		JavaCheckResult result;
+		QVERIFY(JavaChecker::staticProbe(path, result));
+		QVERIFY(result.valid);
+		QVERIFY(result.is_64bit);
+		QCOMPARE(result.mojangPlatform, QString("64"));
+		QCOMPARE(result.javaVersion.toString(), QString("1.8.0_102"));
+	}
+
+	void test_StaticProbeElf()
+	{
+		QTemporaryDir dir;
+		auto path = makeJava(dir.path(), "JAVA_VERSION=\"1.7.0_80\"\n", elfHeader(0x03));
+		JavaCheckResult result;
+		QVERIFY(JavaChecker::staticProbe(path, result));
+		QVERIFY(!result.is_64bit);
+		QCOMPARE(result.realPlatform, QString("i386"));
+		QCOMPARE(result.javaVersion.toString(), QString("1.7.0_80"));
+	}
+
+	void test_StaticProbeNoRelease()
+	{
+		QTemporaryDir dir;
+		auto path = makeJava(dir.path(), QByteArray(), elfHeader(0x3E));
+		JavaCheckResult result;
+		QVERIFY(!JavaChecker::staticProbe(path, result));
+	}
+
+	void test_CacheInvalidation()
+	{
+		QTemporaryDir dir;
+		auto path = makeJava(dir.path(), QByteArray(), QByteArray("dummy"));
+		const QString indexPath = FS::PathCombine(dir.path(), "javacache");
+
+		JavaCheckResult probed;
+		probed.path = path;
+		probed.valid = true;
+		probed.is_64bit = true;
+		probed.realPlatform = "amd64";
+		probed.javaVersion = QString("1.8.0_102");
+		{
+			JavaProbeCache cache(indexPath);
+			cache.store(probed);
+			cache.SaveNow();
+		}
+
+		JavaProbeCache cache(indexPath);
+		JavaCheckResult cached;
+		QVERIFY(cache.lookup(path, cached));
+		QCOMPARE(cached.javaVersion.toString(), QString("1.8.0_102"));
+		QCOMPARE(cached.mojangPlatform, QString("64"));
+
+		// a changed binary must not be answered from the cache
+		FS::write(path, QByteArray("a different java"));
+		QVERIFY(!cache.lookup(path, cached));
+	}
+};
+
+QTEST_GUILESS_MAIN(JavaProbeTest)
+
+#include "tst_JavaProbe.moc"
@@ -0,0 +1,57 @@
+#include <QTest>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include "TestUtil.h"
+
+#include "launch/LaunchTimeline.h"
+
+class LaunchTimelineTest : public QObject
+{
+	Q_OBJECT
+
+private
+slots:
+	void test_Summary()
+	{
+		LaunchTimeline timeline;
+		int step = timeline.begin("CheckJava", "step");
+		int task = timeline.begin("Libraries", "task");
+		timeline.end(task);
+		timeline.end(step);
+		// ending twice keeps the first end
+		timeline.end(step);
+		timeline.begin("LaunchMinecraft", "step");
+		timeline.mark("First output", "process");
+
+		auto summary = timeline.summary();
+		QCOMPARE(summary.size(), 4);
+		QVERIFY(summary[0].contains("ms CheckJava took"));
+		QVERIFY(summary[1].contains("ms   Libraries took"));
+		QVERIFY(summary[2].endsWith("LaunchMinecraft (unfinished)"));
+		QVERIFY(summary[3].endsWith("* First output"));
+	}
+
+	void test_ChromeTrace()
+	{
+		LaunchTimeline timeline;
+		timeline.end(timeline.begin("CheckJava", "step"));
+		timeline.end(timeline.begin("Prewarming", "background"));
+		timeline.mark("First output", "process");
+
+		auto doc = QJsonDocument::fromJson(timeline.toChromeTrace());
+		auto events = doc.object().value("traceEvents").toArray();
+		QCOMPARE(events.size(), 3);
+		auto first = events[0].toObject();
+		QCOMPARE(first.value("name").toString(), QString("CheckJava"));
+		QCOMPARE(first.value("ph").toString(), QString("X"));
+		QVERIFY(first.value("dur").toDouble() >= 0);
+		// different categories end up on different rows
+		QVERIFY(first.value("tid").toInt() != events[1].toObject().value("tid").toInt());
+		QCOMPARE(events[2].toObject().value("ph").toString(), QString("i"));
+	}
+};
+
+QTEST_GUILESS_MAIN(LaunchTimelineTest)
+
+#include "tst_LaunchTimeline.moc"
@@ -0,0 +1,154 @@
+#include <QTest>
+#include <QDebug>
+#include <QFile>
+#include <QJsonObject>
+#include <QSet>
+#include "TestUtil.h"
+
+#include "minecraft/MojangVersionFormat.h"
+#include "minecraft/MinecraftProfile.h"
+#include "minecraft/NullProfileStrategy.h"
+#include "minecraft/StringPool.h"
+
+namespace
+{
+/// resident memory of this process in KiB, or -1 where that is not known
+qint64 residentKiB()
+{
+	QFile statm("/proc/self/statm");
+	if (!statm.open(QIODevice::ReadOnly))
+	{
+		return -1;
+	}
+	auto fields = statm.readAll().split(' ');
+	if (fields.size() < 2)
+	{
+		return -1;
+	}
+	return fields[1].toLongLong() * 4;
+}
+}
+
+class LibraryTest : public QObject
+{
+	Q_OBJECT
+
+	QJsonDocument m_doc;
+
+	/// what loading an instance does: parse its own copy of the version file and apply it
+	std::shared_ptr<MinecraftProfile> loadProfile()
+	{
+		auto vfile = MojangVersionFormat::versionFileFromJson(m_doc, "1.9.json");
+		std::shared_ptr<MinecraftProfile> profile(new MinecraftProfile(new NullProfileStrategy()));
+		vfile->applyTo(profile.get());
+		return profile;
+	}
+
+	LibraryPtr library(const QString &name, const QString &url)
+	{
+		QJsonObject obj;
+		obj.insert("name", name);
+		obj.insert("url", url);
+		return MojangVersionFormat::libraryFromJson(obj, "test");
+	}
+
+private
+slots:
+	void initTestCase()
+	{
+		QFile jsonFile(QFINDTESTDATA("tests/data/1.9.json"));
+		QVERIFY(jsonFile.open(QIODevice::ReadOnly));
+		m_doc = QJsonDocument::fromJson(jsonFile.readAll());
+	}
+
+	void test_SharedBetweenProfiles()
+	{
+		auto first = loadProfile();
+		auto second = loadProfile();
+		QVERIFY(!first->libraries.isEmpty());
+		QCOMPARE(first->libraries.size(), second->libraries.size());
+		for (int i = 0; i < first->libraries.size(); i++)
+		{
+			QCOMPARE(first->libraries[i].get(), second->libraries[i].get());
+		}
+	}
+
+	void test_DifferentStayApart()
+	{
+		auto a = Library::sharedCopy(library("org.lwjgl.lwjgl:lwjgl:2.9.4", "http://a/"));
+		auto b = Library::sharedCopy(library("org.lwjgl.lwjgl:lwjgl:2.9.4", "http://b/"));
+		auto c = Library::sharedCopy(library("org.lwjgl.lwjgl:lwjgl:2.9.4", "http://a/"));
+		QVERIFY(a != b);
+		QCOMPARE(a.get(), c.get());
+		QCOMPARE(a->url(), QString("http://a/org/lwjgl/lwjgl/lwjgl/2.9.4/lwjgl-2.9.4.jar"));
+
+		// changing a private copy leaves the shared one alone
+		auto changed = Library::limitedCopy(a);
+		changed->setHint("local");
+		QCOMPARE(a->hint(), QString());
+	}
+
+	void test_Unused()
+	{
+		const int before = Library::sharedCount();
+		{
+			auto lib = Library::sharedCopy(library("com.example:unused:1.0", QString()));
+			QCOMPARE(Library::sharedCount(), before + 1);
+		}
+		QCOMPARE(Library::sharedCount(), before);
+	}
+
+	void test_StringsShared()
+	{
+		GradleSpecifier first("com.google.guava:guava:17.0");
+		GradleSpecifier second(QString("com.google.guava:") + "guava:17.0");
+		QCOMPARE(first.groupId().constData(), second.groupId().constData());
+		QCOMPARE(first.artifactId().constData(), second.artifactId().constData());
+		QCOMPARE(first.version().constData(), second.version().constData());
+	}
+
+	void test_ManyInstances()
+	{
+		const int instances = 400;
+		QList<std::shared_ptr<MinecraftProfile>> profiles;
+		QSet<Library *> distinct;
+		const qint64 before = residentKiB();
+		for (int i = 0; i < instances; i++)
+		{
+			auto profile = loadProfile();
+			for (auto &lib : profile->libraries)
+			{
+				distinct.insert(lib.get());
+			}
+			profiles.append(profile);
+		}
+		const qint64 shared = residentKiB() - before;
+		const int perProfile = profiles.first()->libraries.size();
+		QCOMPARE(distinct.size(), perProfile);
+
+		// the same, with every profile owning its libraries like before
+		QList<QList<LibraryPtr>> copies;
+		for (int i = 0; i < instances; i++)
+		{
+			QList<LibraryPtr> libs;
+			for (auto &lib : profiles[i]->libraries)
+			{
+				libs.append(Library::limitedCopy(lib));
+			}
+			copies.append(libs);
+		}
+		const qint64 owned = residentKiB() - before - shared;
+		qDebug() << instances << "profiles," << perProfile << "libraries each:" << distinct.size()
+				 << "library objects instead of" << instances * perProfile;
+		if (before != -1)
+		{
+			qDebug() << "resident memory:" << shared << "KiB for the profiles, another" << owned
+					 << "KiB for private library copies";
+		}
+		qDebug() << "pooled strings:" << StringPool::size();
+	}
+};
+
+QTEST_GUILESS_MAIN(LibraryTest)
+
+#include "tst_Library.moc"
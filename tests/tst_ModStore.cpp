@@ -0,0 +1,206 @@
+#include <QTest>
+#include <QTemporaryDir>
+#include "TestUtil.h"
+
+#include "minecraft/ModStore.h"
+#include "FileSystem.h"
+
+/// as if the store was on another volume than the instances
+class UnlinkableModStore : public ModStore
+{
+public:
+	using ModStore::ModStore;
+
+protected:
+	bool probeLinks(const QString &) const override
+	{
+		return false;
+	}
+};
+
+class ModStoreTest : public QObject
+{
+	Q_OBJECT
+
+	QString path(const QTemporaryDir &root, const QString &relative)
+	{
+		return FS::PathCombine(root.path(), relative);
+	}
+
+	QByteArray read(const QString &file)
+	{
+		QFile f(file);
+		f.open(QIODevice::ReadOnly);
+		return f.readAll();
+	}
+
+private
+slots:
+	void test_Install()
+	{
+		QTemporaryDir root;
+		ModStore store(path(root, "store"));
+		const QByteArray jar("not really a jar, but the store doesn't care");
+		FS::write(path(root, "download/mod.jar"), jar);
+		FS::ensureFolderPathExists(path(root, "a/mods"));
+		FS::ensureFolderPathExists(path(root, "b/mods"));
+
+		QVERIFY(store.install(path(root, "download/mod.jar"), path(root, "a/mods/mod.jar")));
+		QVERIFY(store.install(path(root, "download/mod.jar"), path(root, "b/mods/mod.jar")));
+		QCOMPARE(read(path(root, "a/mods/mod.jar")), jar);
+		QCOMPARE(read(path(root, "b/mods/mod.jar")), jar);
+
+		auto blob = store.blobPath(ModStore::hashFile(path(root, "download/mod.jar")));
+		if (FS::hardLinkCount(blob) == 1)
+		{
+			QSKIP("The temporary folder can't do hard links");
+		}
+		// the download stays a copy of its own
+		QCOMPARE(FS::hardLinkCount(path(root, "download/mod.jar")), 1);
+		QCOMPARE(FS::hardLinkCount(blob), 3);
+
+		auto report = store.report();
+		QCOMPARE(report.blobs, 1);
+		QCOMPARE(report.references, 2);
+		QCOMPARE(report.storedBytes, qint64(jar.size()));
+		QCOMPARE(report.savedBytes(), qint64(jar.size()));
+	}
+
+	void test_DeduplicateAndCollect()
+	{
+		QTemporaryDir root;
+		ModStore store(path(root, "store"));
+		const QByteArray jar("the same mod in two instances");
+		FS::write(path(root, "a/mods/mod.jar"), jar);
+		FS::write(path(root, "b/mods/renamed.jar.disabled"), jar);
+		FS::write(path(root, "b/mods/other.zip"), "another mod");
+		FS::write(path(root, "b/mods/settings.cfg"), "changed in place by the game");
+
+		QCOMPARE(store.deduplicateTree(path(root, "a/mods")), 1);
+		QCOMPARE(store.deduplicateTree(path(root, "b/mods")), 2);
+		// already links, nothing to do
+		QCOMPARE(store.deduplicateTree(path(root, "b/mods")), 0);
+		if (FS::hardLinkCount(path(root, "a/mods/mod.jar")) == 1)
+		{
+			QSKIP("The temporary folder can't do hard links");
+		}
+		QCOMPARE(FS::hardLinkCount(path(root, "b/mods/settings.cfg")), 1);
+		QCOMPARE(read(path(root, "b/mods/renamed.jar.disabled")), jar);
+
+		auto report = store.report();
+		QCOMPARE(report.blobs, 2);
+		QCOMPARE(report.references, 3);
+		QCOMPARE(report.garbage, 0);
+
+		// an instance goes away, its files stay as long as someone else uses them
+		QVERIFY(FS::deletePath(path(root, "b")));
+		report = store.collectGarbage();
+		QCOMPARE(report.garbage, 1);
+		report = store.report();
+		QCOMPARE(report.blobs, 1);
+		QCOMPARE(report.references, 1);
+		QCOMPARE(report.garbage, 0);
+	}
+
+	void test_LinkTree()
+	{
+		QTemporaryDir root;
+		ModStore store(path(root, "store"));
+		FS::write(path(root, "a/mods/mod.jar"), "a mod");
+		FS::write(path(root, "a/mods/1.7.10/library.jar"), "a library");
+		FS::write(path(root, "a/mods/notes.txt"), "some notes");
+
+		QVERIFY(store.linkTree(path(root, "a/mods"), path(root, "b/mods")));
+		QCOMPARE(read(path(root, "b/mods/mod.jar")), QByteArray("a mod"));
+		QCOMPARE(read(path(root, "b/mods/1.7.10/library.jar")), QByteArray("a library"));
+		QCOMPARE(read(path(root, "b/mods/notes.txt")), QByteArray("some notes"));
+		if (FS::hardLinkCount(path(root, "b/mods/mod.jar")) == 1)
+		{
+			QSKIP("The temporary folder can't do hard links");
+		}
+		QCOMPARE(FS::hardLinkCount(path(root, "b/mods/mod.jar")), 3);
+		QCOMPARE(FS::hardLinkCount(path(root, "b/mods/notes.txt")), 1);
+		QCOMPARE(store.report().savedBytes(), qint64(QByteArray("a mod").size() + QByteArray("a library").size()));
+	}
+
+	void test_DeduplicateLinked()
+	{
+		QTemporaryDir root;
+		ModStore store(path(root, "store"));
+		FS::write(path(root, "a/mods/mod.jar"), "a mod");
+		QVERIFY(store.deduplicate(path(root, "a/mods/mod.jar")));
+		// already a link to the stored file, it stays one
+		QVERIFY(store.deduplicate(path(root, "a/mods/mod.jar")));
+		QCOMPARE(read(path(root, "a/mods/mod.jar")), QByteArray("a mod"));
+		QCOMPARE(QDir(path(root, "a/mods")).entryList(QDir::Files | QDir::Hidden), QStringList({"mod.jar"}));
+		QCOMPARE(store.collectGarbage().garbage, 0);
+		QCOMPARE(store.report().blobs, 1);
+	}
+
+	void test_ChangedInPlace()
+	{
+		QTemporaryDir root;
+		ModStore store(path(root, "store"));
+		FS::write(path(root, "a/mods/mod.jar"), "a mod");
+		QVERIFY(store.deduplicate(path(root, "a/mods/mod.jar")));
+		auto blob = store.blobPath(ModStore::hashFile(path(root, "a/mods/mod.jar")));
+		if (FS::hardLinkCount(blob) == 1)
+		{
+			QSKIP("The temporary folder can't do hard links");
+		}
+		QVERIFY(!(QFile::permissions(blob) & QFile::WriteOwner));
+
+		// someone makes it writable anyway and changes it
+		QVERIFY(QFile::setPermissions(path(root, "a/mods/mod.jar"), QFile::ReadOwner | QFile::WriteOwner));
+		QFile file(path(root, "a/mods/mod.jar"));
+		QVERIFY(file.open(QIODevice::Append));
+		file.write(" with changes");
+		file.close();
+
+		// the next instance with the original gets the original
+		FS::write(path(root, "b/mods/mod.jar"), "a mod");
+		QVERIFY(store.deduplicate(path(root, "b/mods/mod.jar")));
+		QCOMPARE(read(blob), QByteArray("a mod"));
+		QCOMPARE(read(path(root, "b/mods/mod.jar")), QByteArray("a mod"));
+		QCOMPARE(read(path(root, "a/mods/mod.jar")), QByteArray("a mod with changes"));
+	}
+
+	void test_CanLinkInto()
+	{
+		QTemporaryDir root;
+		ModStore store(path(root, "store"));
+		FS::ensureFolderPathExists(path(root, "a/mods"));
+		if (!store.canLinkInto(path(root, "a/mods")))
+		{
+			QSKIP("The temporary folder can't do hard links");
+		}
+		// the probe leaves nothing behind
+		QVERIFY(QDir(path(root, "a/mods")).entryList(QDir::Files | QDir::Hidden).isEmpty());
+		QCOMPARE(store.report().blobs, 0);
+	}
+
+	void test_NoLinks()
+	{
+		QTemporaryDir root;
+		UnlinkableModStore store(path(root, "store"));
+		FS::write(path(root, "download/mod.jar"), "a mod");
+		FS::write(path(root, "a/mods/other.jar"), "another mod");
+		FS::ensureFolderPathExists(path(root, "b/mods"));
+
+		// plain copies, and nothing in the store that only costs space
+		QVERIFY(store.install(path(root, "download/mod.jar"), path(root, "b/mods/mod.jar")));
+		QCOMPARE(read(path(root, "b/mods/mod.jar")), QByteArray("a mod"));
+		QCOMPARE(FS::hardLinkCount(path(root, "b/mods/mod.jar")), 1);
+
+		QVERIFY(store.linkTree(path(root, "a/mods"), path(root, "c/mods")));
+		QCOMPARE(read(path(root, "c/mods/other.jar")), QByteArray("another mod"));
+		QCOMPARE(FS::hardLinkCount(path(root, "a/mods/other.jar")), 1);
+		QCOMPARE(FS::hardLinkCount(path(root, "c/mods/other.jar")), 1);
+
+		QCOMPARE(store.report().blobs, 0);
+	}
+};
+
+QTEST_GUILESS_MAIN(ModStoreTest)
+
+#include "tst_ModStore.moc"
@@ -0,0 +1,197 @@
+#include <QTest>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include "TestUtil.h"
+
+#include "minecraft/auth/MojangAccountList.h"
+#include "minecraft/auth/YggdrasilTask.h"
+#include "FileSystem.h"
+
+namespace
+{
+/// answers refresh requests like the Mojang auth server does, handing out numbered tokens
+class AuthStandIn
+{
+public:
+	AuthStandIn()
+	{
+		m_server.listen(QHostAddress::LocalHost);
+		QObject::connect(&m_server, &QTcpServer::newConnection, [this]()
+		{
+			while (auto socket = m_server.nextPendingConnection())
+			{
+				QObject::connect(socket, &QTcpSocket::readyRead, [this, socket]() { read(socket); });
+			}
+		});
+	}
+
+	QString base() const
+	{
+		return QString("http://127.0.0.1:%1/").arg(m_server.serverPort());
+	}
+
+	QStringList requests;
+
+private:
+	void read(QTcpSocket *socket)
+	{
+		auto &buffer = m_buffers[socket];
+		buffer.append(socket->readAll());
+		auto headerEnd = buffer.indexOf("\r\n\r\n");
+		if (headerEnd == -1)
+		{
+			return;
+		}
+		const auto header = QString::fromLatin1(buffer.left(headerEnd));
+		int length = 0;
+		for (auto &line : header.split("\r\n"))
+		{
+			if (line.startsWith("content-length:", Qt::CaseInsensitive))
+			{
+				length = line.mid(15).trimmed().toInt();
+			}
+		}
+		if (buffer.size() < headerEnd + 4 + length)
+		{
+			return;
+		}
+		auto request = QJsonDocument::fromJson(buffer.mid(headerEnd + 4, length)).object();
+		buffer.clear();
+
+		const auto endpoint = header.section(' ', 1, 1);
+		requests.append(endpoint);
+		QJsonObject profile;
+		profile.insert("id", "0123456789abcdef");
+		profile.insert("name", "Tester");
+		QJsonObject response;
+		response.insert("clientToken", request.value("clientToken"));
+		response.insert("accessToken", QString("token-%1").arg(requests.size()));
+		response.insert("selectedProfile", profile);
+		auto body = QJsonDocument(response).toJson();
+		socket->write("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " +
+					  QByteArray::number(body.size()) + "\r\n\r\n" + body);
+	}
+
+private:
+	QTcpServer m_server;
+	QMap<QTcpSocket *, QByteArray> m_buffers;
+};
+}
+
+class MojangAccountListTest : public QObject
+{
+	Q_OBJECT
+
+	MojangAccountPtr account(const QString &username, int tokenAgeSecs)
+	{
+		QJsonObject profile;
+		profile.insert("id", "0123456789abcdef");
+		profile.insert("name", "Tester");
+		QJsonObject obj;
+		obj.insert("username", username);
+		obj.insert("clientToken", "client");
+		obj.insert("accessToken", "token-0");
+		obj.insert("profiles", QJsonArray({profile}));
+		obj.insert("activeProfile", "0123456789abcdef");
+		obj.insert("tokenChecked",
+				   QDateTime::currentDateTimeUtc().addSecs(-tokenAgeSecs).toString(Qt::ISODate));
+		return MojangAccount::loadFromJson(obj);
+	}
+
+private
+slots:
+	void test_FreshTokenSkipsNetwork()
+	{
+		AuthStandIn server;
+		YggdrasilTask::setAuthServer(server.base());
+		auto acc = account("fresh", 60);
+		QVERIFY(acc->hasFreshToken());
+		auto session = std::make_shared<AuthSession>();
+		session->wants_online = true;
+		QVERIFY(!acc->login(session));
+		QCOMPARE(session->status, AuthSession::PlayableOnline);
+		QCOMPARE(session->access_token, QString("token-0"));
+		QTest::qWait(50);
+		QVERIFY(server.requests.isEmpty());
+	}
+
+	void test_StaleTokenRefreshes()
+	{
+		AuthStandIn server;
+		YggdrasilTask::setAuthServer(server.base());
+		auto acc = account("stale", 2 * MojangAccount::tokenTrustTime);
+		QVERIFY(!acc->hasFreshToken());
+		auto session = std::make_shared<AuthSession>();
+		session->wants_online = true;
+		auto task = acc->login(session);
+		QVERIFY(task);
+		task->start();
+		QTRY_COMPARE(session->status, AuthSession::PlayableOnline);
+		QCOMPARE(server.requests, QStringList({"/refresh"}));
+		QCOMPARE(acc->accessToken(), QString("token-1"));
+		QVERIFY(acc->hasFreshToken());
+	}
+
+	void test_BackgroundRefresh()
+	{
+		AuthStandIn server;
+		YggdrasilTask::setAuthServer(server.base());
+		MojangAccountList list;
+		// due for a refresh, but still good for a launch
+		auto due = account("due", MojangAccount::tokenTrustTime - MojangAccount::tokenRefreshMargin + 60);
+		auto later = account("later", 60);
+		list.addAccount(due);
+		list.addAccount(later);
+		QVERIFY(due->hasFreshToken());
+
+		list.setAutoRefresh(true);
+		QTRY_COMPARE(due->accessToken(), QString("token-1"));
+		QCOMPARE(server.requests, QStringList({"/refresh"}));
+		QCOMPARE(later->accessToken(), QString("token-0"));
+		QVERIFY(due->tokenRefreshDue() > QDateTime::currentDateTimeUtc());
+
+		// launching now needs no auth round-trip
+		auto session = std::make_shared<AuthSession>();
+		QVERIFY(!due->login(session));
+		QCOMPARE(server.requests.size(), 1);
+	}
+
+	void test_SavesCoalesced()
+	{
+		QTemporaryDir dir;
+		auto path = FS::PathCombine(dir.path(), "accounts.json");
+		{
+			MojangAccountList list;
+			list.setListFilePath(path, true);
+			for (int i = 0; i < 20; i++)
+			{
+				list.addAccount(account(QString("user%1").arg(i), 60));
+			}
+			list.setActiveAccount("user7");
+			// nothing written while the changes keep coming
+			QVERIFY(!QFile::exists(path));
+			QTRY_VERIFY(QFile::exists(path));
+
+			list.setActiveAccount("user3");
+			list.flushSave();
+		}
+		MojangAccountList loaded;
+		QVERIFY(loaded.loadList(path));
+		QCOMPARE(loaded.count(), 20);
+		QCOMPARE(loaded.activeAccount()->username(), QString("user3"));
+		QVERIFY(loaded.at(0)->hasFreshToken());
+	}
+
+	void cleanupTestCase()
+	{
+		YggdrasilTask::setAuthServer(QString());
+	}
+};
+
+QTEST_GUILESS_MAIN(MojangAccountListTest)
+
+#include "tst_MojangAccountList.moc"
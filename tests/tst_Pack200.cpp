@@ -0,0 +1,117 @@
+#include <QTest>
+#include "TestUtil.h"
+
+#include <stdexcept>
+#include "unpack200.h"
+
+namespace
+{
+/// unpack a buffer, handing it to the unpacker in chunks of at most chunkSize bytes
+QByteArray unpack(const QByteArray &input, int chunkSize, bool parallel)
+{
+	int offset = 0;
+	auto reader = [&](void *buf, int64_t maxlen) -> int64_t
+	{
+		int64_t len = qMin<int64_t>(qMin(chunkSize, input.size() - offset), maxlen);
+		memcpy(buf, input.constData() + offset, len);
+		offset += len;
+		return len;
+	};
+	QByteArray output;
+	auto writer = [&](const void *buf, size_t len)
+	{
+		output.append((const char *)buf, len);
+		return true;
+	};
+	unpack_200(reader, writer, parallel);
+	return output;
+}
+
+/// a real pack to benchmark with, for example a de-xz'd Forge universal pack
+QByteArray samplePack()
+{
+	auto path = qgetenv("MULTIMC_PACK200_SAMPLE");
+	if (path.isEmpty())
+	{
+		return QByteArray();
+	}
+	return TestsInternal::readFile(QString::fromLocal8Bit(path));
+}
+}
+
+class Pack200Test : public QObject
+{
+	Q_OBJECT
+
+private
+slots:
+	void test_CopyMode()
+	{
+		// input that is already a jar goes through unchanged, however it is read
+		QByteArray zip("PK\x03\x04", 4);
+		for (int i = 0; i < 5000; i++)
+		{
+			zip.append(char(i * 7));
+		}
+		QCOMPARE(unpack(zip, 1, false), zip);
+		QCOMPARE(unpack(zip, 1000, true), zip);
+	}
+
+	void test_Garbage()
+	{
+		QByteArray garbage(300, '\x42');
+		QVERIFY_EXCEPTION_THROWN(unpack(garbage, 100, false), std::runtime_error);
+	}
+
+	void test_FailingWriter()
+	{
+		QByteArray zip("PK\x03\x04 and then some", 20);
+		int offset = 0;
+		auto reader = [&](void *buf, int64_t maxlen) -> int64_t
+		{
+			int64_t len = qMin<int64_t>(zip.size() - offset, maxlen);
+			memcpy(buf, zip.constData() + offset, len);
+			offset += len;
+			return len;
+		};
+		auto writer = [](const void *, size_t)
+		{
+			return false;
+		};
+		QVERIFY_EXCEPTION_THROWN(unpack_200(reader, writer, false), std::runtime_error);
+	}
+
+	void test_ParallelMatchesSerial()
+	{
+		auto pack = samplePack();
+		if (pack.isEmpty())
+		{
+			QSKIP("Set MULTIMC_PACK200_SAMPLE to a pack200 file to run this");
+		}
+		QCOMPARE(unpack(pack, 1 << 16, true), unpack(pack, 1 << 16, false));
+	}
+
+	void benchmark_Unpack_data()
+	{
+		QTest::addColumn<bool>("parallel");
+		QTest::newRow("serial") << false;
+		QTest::newRow("parallel") << true;
+	}
+	void benchmark_Unpack()
+	{
+		QFETCH(bool, parallel);
+		auto pack = samplePack();
+		if (pack.isEmpty())
+		{
+			QSKIP("Set MULTIMC_PACK200_SAMPLE to a pack200 file to run this");
+		}
+		QBENCHMARK
+		{
+			unpack(pack, 1 << 16, parallel);
+		}
+	}
+};
+
+QTEST_GUILESS_MAIN(Pack200Test)
+
+#include "tst_Pack200.moc"
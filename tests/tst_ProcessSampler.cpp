@@ -0,0 +1,41 @@
+#include <QTest>
+#include "TestUtil.h"
+
+#include "launch/ProcessSampler.h"
+
+class ProcessSamplerTest : public QObject
+{
+	Q_OBJECT
+
+private
+slots:
+	void test_ParseStat()
+	{
+		// process names can contain spaces and parentheses
+		QByteArray data = "1234 (java (main) x) S 1200 1234 1200 0 -1 4194560 1000 0 0 0 250 50 0 0 20 0 42 0 "
+						  "12345 6000000000 65536 18446744073709551615 1 1 0 0 0 0 0 4096 0 0 0 0 17 3 0 0 0 0 0";
+		ProcessSampler::ProcStat stat;
+		QVERIFY(ProcessSampler::parseStat(data, stat));
+		QCOMPARE(stat.ppid, qint64(1200));
+		QCOMPARE(stat.cpuTicks, qint64(300));
+		QCOMPARE(stat.threads, 42);
+		QCOMPARE(stat.rssPages, qint64(65536));
+
+		QVERIFY(!ProcessSampler::parseStat("garbage", stat));
+		QVERIFY(!ProcessSampler::parseStat("1 (short) S 0 1", stat));
+	}
+
+	void test_ParseIo()
+	{
+		QByteArray data = "rchar: 100\nwchar: 200\nsyscr: 3\nsyscw: 4\nread_bytes: 4096\nwrite_bytes: 8192\ncancelled_write_bytes: 0\n";
+		qint64 readBytes = 0, writeBytes = 0;
+		QVERIFY(ProcessSampler::parseIo(data, readBytes, writeBytes));
+		QCOMPARE(readBytes, qint64(4096));
+		QCOMPARE(writeBytes, qint64(8192));
+		QVERIFY(!ProcessSampler::parseIo("rchar: 100\n", readBytes, writeBytes));
+	}
+};
+
+QTEST_GUILESS_MAIN(ProcessSamplerTest)
+
+#include "tst_ProcessSampler.moc"
@@ -0,0 +1,98 @@
+#include <QTest>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <algorithm>
+#include "TestUtil.h"
+
+#include "RecursiveFileSystemWatcher.h"
+#include "pathmatcher/RegexpMatcher.h"
+
+namespace
+{
+void touch(const QString &path)
+{
+	QFile file(path);
+	file.open(QFile::WriteOnly | QFile::Append);
+	file.write("x");
+}
+}
+
+class RecursiveFileSystemWatcherTest : public QObject
+{
+	Q_OBJECT
+
+private
+slots:
+	void test_ScanOrder()
+	{
+		QStringList files = {"latest.log", "b/z.log", "a/b/c.log", "B.log", "a/x.log"};
+		std::sort(files.begin(), files.end(), RecursiveFileSystemWatcher::scanOrderLessThan);
+		QCOMPARE(files, QStringList({"a/b/c.log", "a/x.log", "b/z.log", "B.log", "latest.log"}));
+	}
+
+	void test_TracksChanges()
+	{
+		QTemporaryDir root;
+		QDir dir(root.path());
+		dir.mkpath("logs/old");
+		touch(dir.absoluteFilePath("logs/latest.log"));
+		touch(dir.absoluteFilePath("logs/ignored.txt"));
+
+		RecursiveFileSystemWatcher watcher(nullptr);
+		watcher.setMatcher(std::make_shared<RegexpMatcher>("\\.log$"));
+		watcher.setBatchInterval(500);
+		watcher.setRootDir(dir);
+		QCOMPARE(watcher.files(), QStringList({"logs/latest.log"}));
+		watcher.enable();
+
+		// new files, also in directories that did not exist before
+		touch(dir.absoluteFilePath("logs/old/1.log"));
+		dir.mkpath("crash-reports/deep");
+		touch(dir.absoluteFilePath("crash-reports/deep/crash.log"));
+		QTRY_COMPARE(watcher.files(), QStringList({"crash-reports/deep/crash.log", "logs/old/1.log",
+												   "logs/latest.log"}));
+
+		// removing a whole tree
+		QDir(dir.absoluteFilePath("crash-reports")).removeRecursively();
+		QTRY_COMPARE(watcher.files(), QStringList({"logs/old/1.log", "logs/latest.log"}));
+
+		// moving things around
+		QVERIFY(dir.rename("logs/old", "logs/older"));
+		QTRY_COMPARE(watcher.files(), QStringList({"logs/older/1.log", "logs/latest.log"}));
+
+		// a burst of writes is reported as a single change
+		QSignalSpy spy(&watcher, SIGNAL(filesChanged()));
+		for (int i = 0; i < 20; i++)
+		{
+			touch(dir.absoluteFilePath(QString("logs/%1.log").arg(i)));
+		}
+		QTRY_COMPARE(watcher.files().size(), 22);
+		QTRY_COMPARE(spy.count(), 1);
+	}
+
+	void test_MaxBatchDelay()
+	{
+		QTemporaryDir temp;
+		QDir dir(temp.path());
+		RecursiveFileSystemWatcher watcher(nullptr);
+		watcher.setMatcher(std::make_shared<RegexpMatcher>("\\.log$"));
+		watcher.setBatchInterval(300);
+		watcher.setMaxBatchDelay(600);
+		watcher.setRootDir(dir);
+		watcher.enable();
+
+		// changes keep coming faster than the batch interval, for much longer than the maximum delay
+		QSignalSpy spy(&watcher, SIGNAL(filesChanged()));
+		for (int i = 0; i < 20; i++)
+		{
+			touch(dir.absoluteFilePath(QString("%1.log").arg(i)));
+			QTest::qWait(100);
+		}
+		QVERIFY(spy.count() >= 1);
+		QTRY_COMPARE(watcher.files().size(), 20);
+	}
+};
+
+QTEST_GUILESS_MAIN(RecursiveFileSystemWatcherTest)
+
+#include "tst_RecursiveFileSystemWatcher.moc"
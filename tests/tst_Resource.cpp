@@ -19,6 +19,14 @@ public:
 
 	QString m_key;
 };
+class DummyTransformed
+{
+public:
+	QString value;
+};
+Q_DECLARE_METATYPE(DummyTransformed)
+static int transformCount = 0;
+
 class DummyObserver : public ResourceObserver
 {
 public:
@@ -48,6 +56,11 @@ class ResourceTest : public QObject
 	void initTestCase()
 	{
 		Resource::registerHandler<DummyStringResourceHandler>("dummy");
+		Resource::registerTransformer([](const QString &in)
+		{
+			transformCount++;
+			return DummyTransformed{in};
+		});
 	}
 	void cleanupTestCase()
 	{
@@ -110,6 +123,17 @@ class ResourceTest : public QObject
 		QVERIFY(r1 != r4);
 		QVERIFY(r2 != r3);
 	}
+
+	void test_TransformMemoized()
+	{
+		transformCount = 0;
+		auto r1 = Resource::create("dummy:test_TransformMemoized");
+		QCOMPARE(r1->getResource<DummyTransformed>().value, QStringLiteral("test_TransformMemoized"));
+		QCOMPARE(r1->getResource<DummyTransformed>().value, QStringLiteral("test_TransformMemoized"));
+		QCOMPARE(transformCount, 1);
+		QCOMPARE(r1->getResource<QString>(), QStringLiteral("test_TransformMemoized"));
+		QCOMPARE(transformCount, 1);
+	}
 };
 
 QTEST_GUILESS_MAIN(ResourceTest)
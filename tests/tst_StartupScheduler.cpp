@@ -0,0 +1,109 @@
+#include <QTest>
+#include <QSignalSpy>
+#include "TestUtil.h"
+
+#include "StartupScheduler.h"
+
+class StartupSchedulerTest : public QObject
+{
+	Q_OBJECT
+
+private
+slots:
+	void test_WaitsForCriticalPath()
+	{
+		StartupScheduler scheduler;
+		bool ran = false;
+		scheduler.defer("job", StartupScheduler::Normal, nullptr, [&]() { ran = true; });
+		QTest::qWait(20);
+		QVERIFY(!ran);
+
+		QSignalSpy spy(&scheduler, SIGNAL(idle()));
+		scheduler.phaseDone("settings");
+		scheduler.criticalPathDone();
+		QVERIFY(!ran);
+		QTRY_VERIFY(ran);
+		QCOMPARE(spy.count(), 1);
+		QCOMPARE(scheduler.pendingJobs(), 0);
+	}
+
+	void test_PriorityOrder()
+	{
+		StartupScheduler scheduler;
+		QStringList order;
+		auto job = [&](const QString &name, int priority)
+		{
+			scheduler.defer(name, priority, nullptr, [&order, name]() { order.append(name); });
+		};
+		job("low", StartupScheduler::Low);
+		job("normal 1", StartupScheduler::Normal);
+		job("high", StartupScheduler::High);
+		job("normal 2", StartupScheduler::Normal);
+		scheduler.criticalPathDone();
+		QTRY_COMPARE(order.size(), 4);
+		QCOMPARE(order, QStringList({"high", "normal 1", "normal 2", "low"}));
+	}
+
+	void test_OneJobPerPass()
+	{
+		StartupScheduler scheduler;
+		int ran = 0;
+		for (int i = 0; i < 3; i++)
+		{
+			scheduler.defer("job", StartupScheduler::Normal, nullptr, [&]() { ran++; });
+		}
+		scheduler.criticalPathDone();
+		QCoreApplication::processEvents();
+		QCOMPARE(ran, 1);
+		QTRY_COMPARE(ran, 3);
+	}
+
+	void test_DeferAfterCriticalPath()
+	{
+		StartupScheduler scheduler;
+		scheduler.criticalPathDone();
+		bool ran = false;
+		scheduler.defer("late", StartupScheduler::Low, nullptr, [&]() { ran = true; });
+		QTRY_VERIFY(ran);
+	}
+
+	void test_DroppedWithContext()
+	{
+		StartupScheduler scheduler;
+		auto context = new QObject();
+		bool ran = false;
+		scheduler.defer("job", StartupScheduler::Normal, context, [&]() { ran = true; });
+		delete context;
+		QSignalSpy spy(&scheduler, SIGNAL(idle()));
+		scheduler.criticalPathDone();
+		QTRY_COMPARE(spy.count(), 1);
+		QVERIFY(!ran);
+	}
+
+	void test_MaxHoldBack()
+	{
+		StartupScheduler scheduler;
+		bool ran = false;
+		scheduler.defer("job", StartupScheduler::Normal, nullptr, [&]() { ran = true; });
+		scheduler.setMaxHoldBack(10);
+		QTRY_VERIFY(ran);
+		QVERIFY(!scheduler.isCriticalPathDone());
+	}
+
+	void test_Summary()
+	{
+		StartupScheduler scheduler;
+		scheduler.phaseDone("settings");
+		scheduler.phaseDone("instances");
+		scheduler.criticalPathDone();
+		auto summary = scheduler.summary();
+		QCOMPARE(summary.size(), 3);
+		QVERIFY(summary[0].startsWith("settings took "));
+		QVERIFY(summary[1].startsWith("instances took "));
+		QVERIFY(summary[2].startsWith("critical path done after "));
+	}
+};
+
+QTEST_GUILESS_MAIN(StartupSchedulerTest)
+
+#include "tst_StartupScheduler.moc"
@@ -0,0 +1,78 @@
+#include <QTest>
+#include <QTemporaryDir>
+#include "TestUtil.h"
+
+#include "Trash.h"
+#include "FileSystem.h"
+
+class TrashTest : public QObject
+{
+	Q_OBJECT
+
+	QString path(const QTemporaryDir &root, const QString &relative)
+	{
+		return FS::PathCombine(root.path(), relative);
+	}
+
+	void makeTree(const QString &folder)
+	{
+		FS::write(FS::PathCombine(folder, "instance.cfg"), "name=Doomed");
+		FS::write(FS::PathCombine(folder, "minecraft/saves/world/level.dat"), "a world");
+		FS::write(FS::PathCombine(folder, "minecraft/mods/mod.jar"), "a mod");
+		FS::ensureFolderPathExists(FS::PathCombine(folder, "minecraft/empty"));
+	}
+
+	int trashEntries(const QTemporaryDir &root)
+	{
+		return QDir(path(root, ".trash")).entryList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden).size();
+	}
+
+private
+slots:
+	void test_DeleteTree()
+	{
+		QTemporaryDir root;
+		makeTree(path(root, "doomed"));
+		FS::write(path(root, "kept/precious.txt"), "don't touch");
+		QFile::link(path(root, "kept"), path(root, "doomed/minecraft/link"));
+
+		QVERIFY(Trash::deleteTree(path(root, "doomed")));
+		QVERIFY(!QFileInfo::exists(path(root, "doomed")));
+		// links are removed, not followed
+		QVERIFY(QFileInfo::exists(path(root, "kept/precious.txt")));
+		// nothing there is nothing to do
+		QVERIFY(Trash::deleteTree(path(root, "doomed")));
+	}
+
+	void test_Move()
+	{
+		QTemporaryDir root;
+		makeTree(path(root, "instance"));
+		FS::write(path(root, "neighbour/instance.cfg"), "name=Stays");
+
+		QVERIFY(Trash::move(path(root, "instance")));
+		QVERIFY(!QFileInfo::exists(path(root, "instance")));
+		Trash::waitForFinished();
+		QCOMPARE(trashEntries(root), 0);
+		QVERIFY(QFileInfo::exists(path(root, "neighbour/instance.cfg")));
+
+		QVERIFY(!Trash::move(path(root, "instance")));
+	}
+
+	void test_Resume()
+	{
+		QTemporaryDir root;
+		// left behind by a run that ended before it was done
+		makeTree(path(root, ".trash/instance-1234"));
+		makeTree(path(root, ".trash/other-5678"));
+		QCOMPARE(trashEntries(root), 2);
+
+		Trash::resume(root.path());
+		Trash::waitForFinished();
+		QCOMPARE(trashEntries(root), 0);
+	}
+};
+
+QTEST_GUILESS_MAIN(TrashTest)
+
+#include "tst_Trash.moc"
@@ -1,37 +1,163 @@
 #include <QTest>
 #include "TestUtil.h"
 
-class IniFileTest : public QObject
+#include "pathmatcher/CompiledMatcher.h"
+#include "pathmatcher/FSTreeMatcher.h"
+#include "pathmatcher/MultiMatcher.h"
+#include "pathmatcher/RegexpMatcher.h"
+
+namespace
+{
+/// something shaped like an instance folder with a lot of mods, saves and logs
+QStringList syntheticTree(int count)
+{
+	const QStringList dirs = {"minecraft/mods", "minecraft/config", "minecraft/saves/World/region",
+							  "minecraft/logs", "minecraft/crash-reports", "minecraft/resourcepacks",
+							  "minecraft/screenshots", ".minecraft/saves/Other", "patches"};
+	const QStringList names = {"%1.jar", "%1.cfg", "r.%1.0.mca", "%1.log.gz", "crash-%1-client.txt",
+							   "%1.zip", "%1.png", "level%1.dat", "%1.json"};
+	QStringList paths;
+	paths.reserve(count);
+	for (int i = 0; i < count; i++)
+	{
+		const int kind = i % dirs.size();
+		paths.append(dirs[kind] + "/" + names[kind].arg(i));
+	}
+	paths.append({"latest.log", "IDMap dump 1.txt", "ModLoader.txt.1", "minecraft/saves", "minecraft"});
+	return paths;
+}
+
+IPathMatcher::Ptr logMatcher()
+{
+	auto combined = std::make_shared<MultiMatcher>();
+	combined->add(std::make_shared<RegexpMatcher>(".*\\.log(\\.[0-9]*)?(\\.gz)?$"));
+	combined->add(std::make_shared<RegexpMatcher>("crash-.*\\.txt"));
+	combined->add(std::make_shared<RegexpMatcher>("IDMap dump.*\\.txt$"));
+	combined->add(std::make_shared<RegexpMatcher>("ModLoader\\.txt(\\..*)?$"));
+	return combined;
+}
+}
+
+class FileMatchersTest : public QObject
 {
 	Q_OBJECT
+
+	SeparatorPrefixTree<'/'> m_blocked;
+	QStringList m_paths;
+
+	IPathMatcher::Ptr blacklist()
+	{
+		auto combined = std::make_shared<MultiMatcher>();
+		combined->add(std::make_shared<FSTreeMatcher>(m_blocked));
+		combined->add(std::make_shared<RegexpMatcher>("[.]?minecraft/saves"));
+		auto images = std::make_shared<RegexpMatcher>("\\.PNG$");
+		images->caseSensitive(true);
+		combined->add(images);
+		combined->add(std::make_shared<RegexpMatcher>("\\.zip$"));
+		combined->add(logMatcher());
+		return combined;
+	}
+
+	void compareAll(IPathMatcher::Ptr reference, IPathMatcher::Ptr compiled)
+	{
+		for (auto &path : m_paths)
+		{
+			if (reference->matches(path) != compiled->matches(path))
+			{
+				QFAIL(qPrintable("Matchers disagree on " + path));
+			}
+		}
+	}
+
 private
 slots:
+	void initTestCase()
+	{
+		m_blocked.insert("minecraft/config");
+		m_blocked.insert("patches/net.minecraft.json");
+		m_paths = syntheticTree(100000);
+	}
 
 	void test_FSTree()
 	{
-		/*
-		QTest::addColumn<QString>("through");
-
-		QTest::newRow("unix path") << "/abc/def/ghi/jkl";
-		QTest::newRow("windows path") << "C:\\Program files\\terrible\\name\\of something\\";
-		QTest::newRow("Plain text") << "Lorem ipsum dolor sit amet.";
-		QTest::newRow("Escape sequences") << "Lorem\n\t\n\\n\\tAAZ\nipsum dolor\n\nsit amet.";
-		QTest::newRow("Escape sequences 2") << "\"\n\n\"";
-		*/
+		QCOMPARE(m_blocked.covers(QStringRef()), false);
+		QString path("minecraft/config/forge.cfg");
+		QCOMPARE(m_blocked.covers(QStringRef(&path)), true);
+		path = "minecraft/configs";
+		QCOMPARE(m_blocked.covers(QStringRef(&path)), false);
+		path = "patches/net.minecraft.json";
+		QCOMPARE(m_blocked.covers(QStringRef(&path)), true);
+		path = "patches";
+		QCOMPARE(m_blocked.covers(QStringRef(&path)), false);
+		path = "xpatches/net.minecraft.json";
+		QCOMPARE(m_blocked.covers(path.midRef(1)), true);
 	}
+
 	void test_Regexp()
 	{
-		/*
-		QFETCH(QString, through);
+		auto compiled = CompiledMatcher::compile(logMatcher());
+		// all four are file name patterns without options
+		QCOMPARE(compiled->regexpCount(), 1);
+		QVERIFY(compiled->matches("logs/latest.log"));
+		QVERIFY(compiled->matches("logs/2015-10-01-1.log.gz"));
+		QVERIFY(compiled->matches("crash-reports/crash-2015-10-01-client.txt"));
+		QVERIFY(compiled->matches("ModLoader.txt"));
+		QVERIFY(!compiled->matches("logs/latest.log.txt"));
+		QVERIFY(!compiled->matches("crash-reports/notes.txt"));
+	}
 
-		QString there = INIFile::escape(through);
-		QString back = INIFile::unescape(there);
+	void test_SameAsUncompiled()
+	{
+		auto reference = blacklist();
+		auto compiled = CompiledMatcher::compile(reference);
+		// path patterns, case insensitive file name patterns and the rest
+		QCOMPARE(compiled->regexpCount(), 3);
+		compareAll(reference, compiled);
+	}
 
-		QCOMPARE(back, through);
-		*/
+	void test_BackReferences()
+	{
+		auto combined = std::make_shared<MultiMatcher>();
+		combined->add(std::make_shared<RegexpMatcher>("(a)x"));
+		combined->add(std::make_shared<RegexpMatcher>("(b)\\1"));
+		auto compiled = CompiledMatcher::compile(combined);
+		QCOMPARE(compiled->regexpCount(), 2);
+		QVERIFY(compiled->matches("dir/bb"));
+		QVERIFY(!compiled->matches("dir/ba"));
+		QVERIFY(compiled->matches("dir/ax"));
+	}
+
+	void test_Uncompiled_benchmark()
+	{
+		auto matcher = blacklist();
+		int matched = 0;
+		QBENCHMARK
+		{
+			matched = 0;
+			for (auto &path : m_paths)
+			{
+				matched += matcher->matches(path);
+			}
+		}
+		QVERIFY(matched > 0);
+	}
+
+	void test_Compiled_benchmark()
+	{
+		auto matcher = CompiledMatcher::compile(blacklist());
+		int matched = 0;
+		QBENCHMARK
+		{
+			matched = 0;
+			for (auto &path : m_paths)
+			{
+				matched += matcher->matches(path);
+			}
+		}
+		QVERIFY(matched > 0);
 	}
 };
 
-QTEST_GUILESS_MAIN(IniFileTest)
+QTEST_GUILESS_MAIN(FileMatchersTest)
 
 #include "tst_filematchers.moc"
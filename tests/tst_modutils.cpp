@@ -98,6 +98,20 @@ private slots:
 		QCOMPARE(versionIsInInterval(version, interval), result);
 	}
 
+	void test_versionInterval_data()
+	{
+		test_versionIsInInterval_data();
+	}
+	void test_versionInterval()
+	{
+		QFETCH(QString, version);
+		QFETCH(QString, interval);
+		QFETCH(bool, result);
+
+		const VersionInterval compiled(interval);
+		QCOMPARE(compiled.contains(Version(version)), result);
+	}
+
 	void test_versionCompare_data()
 	{
 		setupVersions();